@@ -6,6 +6,13 @@ bool bimodal::predict_branch(champsim::address ip)
   return value.value() > (value.maximum / 2);
 }
 
+champsim::branch_confidence bimodal::prediction_confidence(champsim::address ip) const
+{
+  // Only a saturated counter is confident
+  auto value = bimodal_table[hash(ip)];
+  return (value.is_max() || value.value() == 0) ? champsim::branch_confidence::high : champsim::branch_confidence::low;
+}
+
 void bimodal::last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type)
 {
   bimodal_table[hash(ip)] += taken ? 1 : -1;
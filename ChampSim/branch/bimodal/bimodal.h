@@ -1,11 +1,10 @@
 #ifndef BRANCH_BIMODAL_H
 #define BRANCH_BIMODAL_H
 
-#include <array>
-
 #include "address.h"
 #include "modules.h"
 #include "msl/fwcounter.h"
+#include "msl/packed_fwcounter.h"
 
 class bimodal : champsim::modules::branch_predictor
 {
@@ -15,13 +14,14 @@ class bimodal : champsim::modules::branch_predictor
   static constexpr std::size_t PRIME = 16381;
   static constexpr std::size_t BITS = 2;
 
-  std::array<champsim::msl::fwcounter<BITS>, TABLE_SIZE> bimodal_table;
+  champsim::msl::packed_fwcounter_array<champsim::msl::fwcounter<BITS>, TABLE_SIZE> bimodal_table;
 
 public:
   using branch_predictor::branch_predictor;
 
   // void initialize_branch_predictor();
   bool predict_branch(champsim::address ip);
+  champsim::branch_confidence prediction_confidence(champsim::address ip) const;
   void last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
 };
 
@@ -1,11 +1,11 @@
 #ifndef BRANCH_GSHARE_H
 #define BRANCH_GSHARE_H
 
-#include <array>
 #include <bitset>
 
 #include "modules.h"
 #include "msl/fwcounter.h"
+#include "msl/packed_fwcounter.h"
 
 struct gshare : champsim::modules::branch_predictor {
   static constexpr std::size_t GLOBAL_HISTORY_LENGTH = 14;
@@ -13,7 +13,7 @@ struct gshare : champsim::modules::branch_predictor {
   static constexpr std::size_t GS_HISTORY_TABLE_SIZE = 16384;
 
   std::bitset<GLOBAL_HISTORY_LENGTH> branch_history_vector;
-  std::array<champsim::msl::fwcounter<COUNTER_BITS>, GS_HISTORY_TABLE_SIZE> gs_history_table;
+  champsim::msl::packed_fwcounter_array<champsim::msl::fwcounter<COUNTER_BITS>, GS_HISTORY_TABLE_SIZE> gs_history_table;
 
   using branch_predictor::branch_predictor;
 
@@ -47,23 +47,32 @@ sources for you to plagiarize.
 
 #include "hashed_perceptron.h"
 
-#include <numeric>
+#include <algorithm>
+#include <cstdlib>
 
 bool hashed_perceptron::predict_branch(champsim::address pc)
 {
-  auto get_index = [pc_slice = pc.slice_lower<TABLE_INDEX_BITS>().to<uint64_t>()](const auto& hist) {
-    return hist.value() ^ pc_slice; // seed in the PC to spread accesses around (like gshare) XOR in the last word
-  };
-  perceptron_result result;
-  std::transform(std::cbegin(ghist_words), std::cend(ghist_words), std::begin(result.indices), get_index);
+  index_array_type folded_history;
+  std::transform(std::cbegin(ghist_words), std::cend(ghist_words), std::begin(folded_history),
+                 [](const auto& hist) { return static_cast<uint32_t>(hist.value()); });
 
-  // add the selected weights to the perceptron sum
-  result.yout = std::inner_product(std::begin(tables), std::end(tables), std::begin(result.indices), 0, std::plus<>{},
-                                   [](const auto& table, const auto& index) { return table.at(index).value(); });
+  // seed in the PC to spread accesses around (like gshare), then add the selected weights to the perceptron sum
+  perceptron_result result;
+  result.yout = predict_kernel(active_kernel, tables, folded_history, pc.slice_lower<TABLE_INDEX_BITS>().to<uint32_t>(), result.indices);
   last_result = result;
   return result.yout >= THRESHOLD;
 }
 
+champsim::branch_confidence hashed_perceptron::prediction_confidence(champsim::address) const
+{
+  // A sum within the training threshold is weak, and the perceptron is still learning it
+  auto magnitude = std::abs(last_result.yout);
+  if (magnitude >= theta) {
+    return champsim::branch_confidence::high;
+  }
+  return (2 * magnitude >= theta) ? champsim::branch_confidence::medium : champsim::branch_confidence::low;
+}
+
 void hashed_perceptron::last_branch_result(champsim::address pc, champsim::address branch_target, bool taken, uint8_t branch_type)
 {
   for (auto& hist : ghist_words) {
@@ -74,8 +83,7 @@ void hashed_perceptron::last_branch_result(champsim::address pc, champsim::addre
   bool prediction_correct = (taken == (last_result.yout >= THRESHOLD));
   bool prediction_weak = (std::abs(last_result.yout) < theta);
   if (!prediction_correct || prediction_weak) {
-    for (std::size_t i = 0; i < std::size(tables); i++)
-      tables[i][last_result.indices[i]] += taken ? 1 : -1; // update weights
+    train_kernel(active_kernel, tables, last_result.indices, taken); // update weights
     adjust_threshold(prediction_correct);
   }
 }
@@ -3,13 +3,18 @@
 
 #include <array>
 #include <cstdint>
-#include <tuple>
 #include <vector>
 
 #include "folded_shift_register.h"
 #include "modules.h"
 #include "msl/bits.h"
 #include "msl/fwcounter.h"
+#include "msl/packed_fwcounter.h"
+
+// The AVX2 kernels are built wherever the compiler can target AVX2, and used on the hosts that support it
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define HASHED_PERCEPTRON_AVX2_KERNEL
+#endif
 
 class hashed_perceptron : champsim::modules::branch_predictor
 {
@@ -21,12 +26,25 @@ class hashed_perceptron : champsim::modules::branch_predictor
   constexpr static bits TABLE_INDEX_BITS{champsim::msl::lg2(TABLE_SIZE)};
   constexpr static int THRESHOLD = 1;
 
+  // The vector kernel is bit-identical to the scalar kernel, but the speed of its gathers differs widely between hosts: it has measured both
+  // twice as slow as the scalar kernel and 20% faster. If this is set, the kernels are timed when the first predictor is built, and the
+  // faster one is used.
+  constexpr static bool USE_VECTOR_KERNEL = true;
+
   constexpr static std::array<bits, NTABLES> history_lengths = {
       bits{},   MINHIST,  bits{4},  bits{6},  bits{8},  bits{10},  bits{14},  bits{19},
       bits{26}, bits{36}, bits{49}, bits{67}, bits{91}, bits{125}, bits{170}, MAXHIST}; // geometric global history lengths
 
-  // tables of 8-bit weights
-  std::array<std::array<champsim::msl::sfwcounter<8>, TABLE_SIZE>, NTABLES> tables{};
+  // tables of 8-bit weights, stored back-to-back: table i occupies [i * TABLE_SIZE, (i+1) * TABLE_SIZE)
+  // The SIMD gather reads four bytes at a time, so the array is padded to keep the last read in bounds.
+  constexpr static std::size_t GATHER_PADDING = sizeof(uint32_t) - 1;
+
+public:
+  using weight_array_type = champsim::msl::packed_fwcounter_array<champsim::msl::sfwcounter<8>, NTABLES * TABLE_SIZE + GATHER_PADDING>;
+  using index_array_type = std::array<uint32_t, NTABLES>;
+
+private:
+  weight_array_type tables{};
 
   // words that store the global history
   using history_type = folded_shift_register<TABLE_INDEX_BITS>;
@@ -39,9 +57,32 @@ class hashed_perceptron : champsim::modules::branch_predictor
   int theta = 10;
   int tc = 0; // counter for threshold setting algorithm
 
+public:
+  /**
+   * The implementations of the prediction and training kernels.
+   * Each produces bit-identical results; the vector kernels are only available on hosts that support them.
+   */
+  enum class kernel { scalar, avx2 };
+
+  static bool kernel_supported(kernel k);
+  static kernel default_kernel();
+
+  // Compute the weight indices for each table and return the perceptron sum
+  static int predict_kernel(kernel k, const weight_array_type& weights, const index_array_type& folded_history, uint32_t pc_slice,
+                            index_array_type& indices);
+
+  // Move each selected weight one step towards the outcome, saturating
+  static void train_kernel(kernel k, weight_array_type& weights, const index_array_type& indices, bool taken);
+
+  // The seconds the kernel takes over a short stream of random predictions and updates
+  static double time_kernel(kernel k);
+
+private:
+  kernel active_kernel = default_kernel();
+
   struct perceptron_result {
-    std::array<uint64_t, std::tuple_size_v<decltype(history_lengths)>> indices = {}; // remember the indices into the tables from prediction to update
-    int yout = 0;                                                                    // perceptron sum
+    index_array_type indices = {}; // remember the indices into the tables from prediction to update
+    int yout = 0;                  // perceptron sum
   };
 
   perceptron_result last_result{};
@@ -49,8 +90,11 @@ class hashed_perceptron : champsim::modules::branch_predictor
 public:
   using branch_predictor::branch_predictor;
   bool predict_branch(champsim::address pc);
+  champsim::branch_confidence prediction_confidence(champsim::address pc) const;
   void last_branch_result(champsim::address pc, champsim::address branch_target, bool taken, uint8_t branch_type);
   void adjust_threshold(bool correct);
+
+  void select_kernel(kernel k) { active_kernel = k; }
 };
 
 #endif
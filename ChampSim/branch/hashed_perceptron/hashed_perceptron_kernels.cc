@@ -0,0 +1,174 @@
+/*
+ * Prediction and training kernels for the hashed perceptron.
+ *
+ * Every table is consulted on every prediction, so the per-table work is done as a batch: the indices are formed by XORing the folded
+ * histories with the PC, the weights are gathered and summed, and on training the same weights are stepped towards the outcome with
+ * saturating arithmetic.
+ *
+ * The scalar kernel is portable. The AVX2 kernel is compiled with a function-level target attribute, so that it is available without
+ * changing the global compiler flags, and can only be selected when the host reports AVX2 support at run time. Both kernels produce
+ * bit-identical predictions, so the default is whichever is faster on the host.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <numeric>
+
+#include "hashed_perceptron.h"
+
+#ifdef HASHED_PERCEPTRON_AVX2_KERNEL
+#include <immintrin.h>
+#endif
+
+namespace
+{
+template <typename Weights, typename Indices>
+int predict_scalar(const Weights& weights, const Indices& folded_history, uint32_t pc_slice, Indices& indices, std::size_t table_size)
+{
+  for (std::size_t i = 0; i < std::size(indices); ++i) {
+    indices[i] = static_cast<uint32_t>(((folded_history[i] ^ pc_slice) + i * table_size));
+  }
+  return std::accumulate(std::cbegin(indices), std::cend(indices), 0, [&weights](int sum, auto idx) { return sum + static_cast<int>(weights[idx].value()); });
+}
+
+template <typename Weights, typename Indices>
+void train_scalar(Weights& weights, const Indices& indices, bool taken)
+{
+  for (auto idx : indices) {
+    weights[idx] += taken ? 1 : -1;
+  }
+}
+
+#ifdef HASHED_PERCEPTRON_AVX2_KERNEL
+// The weights are 8-bit lanes biased by 128, so on this little-endian target lane i is byte i of the backing storage,
+// and saturating the biased value at [0, 255] is the same as saturating the weight at [-128, 127].
+constexpr int WEIGHT_BIAS = 128;
+
+__attribute__((target("avx2"))) __m128i load_biased(const unsigned char* base, const uint32_t* indices)
+{
+  // Gather four bytes at each weight and keep the lowest, then narrow the two vectors of 32-bit lanes into one vector of bytes
+  const auto mask = _mm256_set1_epi32(0xff);
+  const auto lo_idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices));
+  const auto hi_idx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + 8));
+  auto lo = _mm256_and_si256(_mm256_i32gather_epi32(reinterpret_cast<const int*>(base), lo_idx, 1), mask);
+  auto hi = _mm256_and_si256(_mm256_i32gather_epi32(reinterpret_cast<const int*>(base), hi_idx, 1), mask);
+  auto halves = _mm256_packus_epi32(lo, hi); // packs within 128-bit halves: lanes 0-3, 8-11 | 4-7, 12-15
+  auto bytes = _mm256_packus_epi16(halves, halves);
+  bytes = _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 4, 1, 5, 0, 0, 0, 0));
+  return _mm256_castsi256_si128(bytes);
+}
+
+__attribute__((target("avx2"))) int predict_avx2(const unsigned char* base, const uint32_t* folded_history, uint32_t pc_slice, uint32_t* indices,
+                                                 uint32_t table_size)
+{
+  const __m256i pc = _mm256_set1_epi32(static_cast<int>(pc_slice));
+  const __m256i stride = _mm256_set1_epi32(static_cast<int>(8 * table_size));
+  const __m256i table_base = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(table_size)));
+
+  auto lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(folded_history));
+  auto hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(folded_history + 8));
+  lo = _mm256_add_epi32(_mm256_xor_si256(lo, pc), table_base);
+  hi = _mm256_add_epi32(_mm256_xor_si256(hi, pc), _mm256_add_epi32(table_base, stride));
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(indices), lo);
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(indices + 8), hi);
+
+  // The sum of absolute differences against zero is the horizontal sum of the unsigned bytes
+  auto sums = _mm_sad_epu8(load_biased(base, indices), _mm_setzero_si128());
+  return _mm_cvtsi128_si32(_mm_add_epi64(sums, _mm_unpackhi_epi64(sums, sums))) - 16 * WEIGHT_BIAS;
+}
+
+__attribute__((target("avx2"))) void train_avx2(unsigned char* base, const uint32_t* indices, bool taken)
+{
+  const auto one = _mm_set1_epi8(1);
+  const auto weights = load_biased(base, indices);
+  const auto updated = taken ? _mm_adds_epu8(weights, one) : _mm_subs_epu8(weights, one);
+
+  // AVX2 has no scatter, so the updated lanes are written back one at a time
+  alignas(16) unsigned char lanes[16];
+  _mm_store_si128(reinterpret_cast<__m128i*>(lanes), updated);
+  for (std::size_t i = 0; i < std::size(lanes); ++i) {
+    base[indices[i]] = lanes[i];
+  }
+}
+#endif
+} // namespace
+
+bool hashed_perceptron::kernel_supported(kernel k)
+{
+  switch (k) {
+  case kernel::scalar:
+    return true;
+  case kernel::avx2:
+#ifdef HASHED_PERCEPTRON_AVX2_KERNEL
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+  }
+  return false;
+}
+
+double hashed_perceptron::time_kernel(kernel k)
+{
+  constexpr int ITERATIONS = 20000;
+  auto weights = std::make_unique<weight_array_type>();
+  index_array_type folded{};
+  index_array_type indices{};
+  uint32_t lcg = 1;
+
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < ITERATIONS; ++i) {
+    for (auto& fold : folded) {
+      lcg = lcg * 1664525 + 1013904223;
+      fold = (lcg >> 8) % TABLE_SIZE;
+    }
+    auto sum = predict_kernel(k, *weights, folded, lcg >> 20, indices);
+    train_kernel(k, *weights, indices, (sum ^ i) & 1);
+  }
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+auto hashed_perceptron::default_kernel() -> kernel
+{
+  static const kernel selected = []() {
+    if (!USE_VECTOR_KERNEL || !kernel_supported(kernel::avx2)) {
+      return kernel::scalar;
+    }
+
+    // Take the best of a few timings of each kernel, so that one interruption does not decide
+    constexpr int TRIALS = 3;
+    double scalar_time = time_kernel(kernel::scalar);
+    double avx2_time = time_kernel(kernel::avx2);
+    for (int i = 1; i < TRIALS; ++i) {
+      scalar_time = std::min(scalar_time, time_kernel(kernel::scalar));
+      avx2_time = std::min(avx2_time, time_kernel(kernel::avx2));
+    }
+    return avx2_time < scalar_time ? kernel::avx2 : kernel::scalar;
+  }();
+  return selected;
+}
+
+int hashed_perceptron::predict_kernel(kernel k, const weight_array_type& weights, const index_array_type& folded_history, uint32_t pc_slice,
+                                      index_array_type& indices)
+{
+#ifdef HASHED_PERCEPTRON_AVX2_KERNEL
+  static_assert(NTABLES == 16, "The AVX2 kernel processes exactly two vectors of tables");
+  static_assert(weight_array_type::width == 8 && weight_array_type::minimum == -128);
+  if (k == kernel::avx2) {
+    return predict_avx2(reinterpret_cast<const unsigned char*>(weights.data()), folded_history.data(), pc_slice, indices.data(), TABLE_SIZE);
+  }
+#endif
+  return predict_scalar(weights, folded_history, pc_slice, indices, TABLE_SIZE);
+}
+
+void hashed_perceptron::train_kernel(kernel k, weight_array_type& weights, const index_array_type& indices, bool taken)
+{
+#ifdef HASHED_PERCEPTRON_AVX2_KERNEL
+  if (k == kernel::avx2) {
+    train_avx2(reinterpret_cast<unsigned char*>(weights.data()), indices.data(), taken);
+    return;
+  }
+#endif
+  train_scalar(weights, indices, taken);
+}
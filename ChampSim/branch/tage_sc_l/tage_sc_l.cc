@@ -0,0 +1,344 @@
+/*
+ * This predictor follows the structure of Seznec, "TAGE-SC-L Branch Predictors," CBP-4 (2014), and "TAGE-SC-L Branch Predictors Again,"
+ * CBP-5 (2016). It keeps the three components and their interaction, but not the many small side predictors of the contest entries.
+ */
+
+#include "tage_sc_l.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <numeric>
+#include <stdexcept>
+
+#include "instruction.h"
+#include "ooo_cpu.h"
+
+using champsim::msl::tage::mask;
+
+auto tage_sc_l::history_lengths() -> std::array<unsigned, NUM_TAGGED> { return champsim::msl::tage::geometric_lengths<NUM_TAGGED>(MIN_HISTORY, MAX_HISTORY); }
+
+std::size_t tage_sc_l::storage_bits(geometry_type geom)
+{
+  auto tagged_entry_bits = std::accumulate(std::begin(TAG_BITS), std::end(TAG_BITS), std::size_t{0},
+                                           [](auto acc, auto tag_bits) { return acc + COUNTER_BITS + tag_bits + USEFUL_BITS; });
+  auto tagged_bits = tagged_entry_bits << geom.tagged_log_entries;
+  auto bimodal_bits = BIMODAL_BITS << geom.bimodal_log_entries;
+  auto loop_bits = LOOP_SETS * LOOP_WAYS * (LOOP_TAG_BITS + 2 * LOOP_ITER_BITS + 1 + LOOP_CONFIDENCE_BITS + LOOP_AGE_BITS);
+  auto corrector_bits = (SC_TABLES + 1) * (SC_COUNTER_BITS << SC_LOG_ENTRIES);
+  // The folded histories are state as well
+  auto fold_bits = std::accumulate(std::begin(TAG_BITS), std::end(TAG_BITS), std::size_t{0},
+                                   [log_entries = geom.tagged_log_entries](auto acc, auto tag_bits) { return acc + log_entries + 2 * tag_bits - 1; })
+                   + SC_TABLES * SC_LOG_ENTRIES;
+  return tagged_bits + bimodal_bits + loop_bits + corrector_bits + fold_bits + MAX_HISTORY;
+}
+
+auto tage_sc_l::geometry_for(std::size_t budget) -> geometry_type
+{
+  for (unsigned log_entries = 24; log_entries >= MIN_TAGGED_LOG_ENTRIES; --log_entries) {
+    geometry_type candidate{log_entries, log_entries + BIMODAL_RATIO_LOG};
+    if (storage_bits(candidate) <= 8 * budget) {
+      return candidate;
+    }
+  }
+  throw std::invalid_argument{"The storage budget is too small for TAGE-SC-L"};
+}
+
+void tage_sc_l::initialize_branch_predictor()
+{
+  auto budget = intern_->BRANCH_PREDICTOR_BUDGET > 0 ? intern_->BRANCH_PREDICTOR_BUDGET : DEFAULT_BUDGET;
+  geometry = geometry_for(budget);
+
+  bimodal.assign(std::size_t{1} << geometry.bimodal_log_entries, champsim::msl::fwcounter<BIMODAL_BITS>{1 << (BIMODAL_BITS - 1)});
+  for (auto& table : tagged) {
+    table.assign(std::size_t{1} << geometry.tagged_log_entries, tagged_entry{});
+  }
+  for (auto& table : corrector) {
+    table.assign(std::size_t{1} << SC_LOG_ENTRIES, {});
+  }
+
+  auto lengths = history_lengths();
+  for (std::size_t i = 0; i < NUM_TAGGED; ++i) {
+    index_folds.at(i) = champsim::msl::tage::folded_history{lengths.at(i), geometry.tagged_log_entries};
+    tag_folds.at(i) = champsim::msl::tage::folded_history{lengths.at(i), TAG_BITS.at(i)};
+    alt_tag_folds.at(i) = champsim::msl::tage::folded_history{lengths.at(i), TAG_BITS.at(i) - 1};
+  }
+  for (std::size_t i = 0; i < SC_TABLES; ++i) {
+    corrector_folds.at(i) = champsim::msl::tage::folded_history{SC_HISTORY.at(i), SC_LOG_ENTRIES};
+  }
+}
+
+std::size_t tage_sc_l::loop_set(uint64_t ip) const { return (ip ^ (ip >> 4)) % LOOP_SETS; }
+
+void tage_sc_l::predict_tage(prediction_type& pred) const
+{
+  const auto log_entries = geometry.tagged_log_entries;
+  for (std::size_t i = 0; i < NUM_TAGGED; ++i) {
+    auto tag_bits = TAG_BITS.at(i);
+    pred.indices.at(i) = (pred.ip ^ (pred.ip >> (log_entries + i)) ^ index_folds.at(i).value()) & mask(log_entries);
+    pred.tags.at(i) = (pred.ip ^ tag_folds.at(i).value() ^ (alt_tag_folds.at(i).value() << 1)) & mask(tag_bits);
+  }
+  pred.bimodal_index = pred.ip & mask(geometry.bimodal_log_entries);
+
+  // The provider is the hitting table with the longest history, and the alternate is the next one
+  for (std::size_t i = NUM_TAGGED; i > 0; --i) {
+    if (tagged.at(i - 1).at(pred.indices.at(i - 1)).tag == pred.tags.at(i - 1)) {
+      if (!pred.provider.has_value()) {
+        pred.provider = i - 1;
+      } else {
+        pred.alternate = i - 1;
+        break;
+      }
+    }
+  }
+
+  auto bimodal_prediction = bimodal.at(pred.bimodal_index).value() >= (1 << (BIMODAL_BITS - 1));
+  pred.alternate_prediction = pred.alternate.has_value() ? tagged.at(*pred.alternate).at(pred.indices.at(*pred.alternate)).ctr.value() >= 0 : bimodal_prediction;
+
+  if (pred.provider.has_value()) {
+    const auto& entry = tagged.at(*pred.provider).at(pred.indices.at(*pred.provider));
+    pred.provider_prediction = entry.ctr.value() >= 0;
+    pred.provider_weak = (entry.ctr.value() == 0 || entry.ctr.value() == -1);
+
+    // A newly allocated entry is often less accurate than the alternate prediction
+    bool new_allocation = pred.provider_weak && entry.useful.value() == 0;
+    pred.tage_prediction = (new_allocation && use_alt_on_new_alloc.value() >= 0) ? pred.alternate_prediction : pred.provider_prediction;
+  } else {
+    pred.provider_prediction = bimodal_prediction;
+    pred.tage_prediction = bimodal_prediction;
+  }
+}
+
+void tage_sc_l::predict_loop(prediction_type& pred) const
+{
+  auto set_begin = std::next(std::begin(loops), static_cast<long>(loop_set(pred.ip) * LOOP_WAYS));
+  auto set_end = std::next(set_begin, LOOP_WAYS);
+  auto tag = (pred.ip >> champsim::msl::lg2(LOOP_SETS)) & mask(LOOP_TAG_BITS);
+  auto found = std::find_if(set_begin, set_end, [tag](const auto& x) { return x.tag == tag && x.past_iterations > 0; });
+  if (found == set_end) {
+    return;
+  }
+
+  pred.loop_valid = found->confidence.is_max();
+  pred.loop_prediction = (found->current_iterations == found->past_iterations) ? !found->direction : found->direction;
+}
+
+void tage_sc_l::predict_corrector(prediction_type& pred) const
+{
+  auto centered = [](const auto& ctr) {
+    return 2 * static_cast<int>(ctr.value()) + 1;
+  };
+
+  pred.corrector_bias_index = ((pred.ip << 1) | (pred.tage_prediction ? 1 : 0)) & mask(SC_LOG_ENTRIES);
+  pred.corrector_sum = centered(corrector_bias.at(pred.corrector_bias_index));
+  for (std::size_t i = 0; i < SC_TABLES; ++i) {
+    pred.corrector_indices.at(i) =
+        (pred.ip ^ (pred.ip >> (SC_LOG_ENTRIES - i)) ^ corrector_folds.at(i).value() ^ (pred.tage_prediction ? 1 : 0))
+        & mask(SC_LOG_ENTRIES);
+    pred.corrector_sum += centered(corrector.at(i).at(pred.corrector_indices.at(i)));
+  }
+  pred.corrector_prediction = pred.corrector_sum >= 0;
+}
+
+bool tage_sc_l::predict_branch(champsim::address ip)
+{
+  prediction_type pred{};
+  pred.ip = ip.to<uint64_t>();
+
+  predict_tage(pred);
+  predict_loop(pred);
+  predict_corrector(pred);
+
+  pred.loop_used = pred.loop_valid && loop_usefulness.value() >= 0;
+  pred.corrector_used = pred.corrector_prediction != pred.tage_prediction && std::abs(pred.corrector_sum) >= corrector_threshold;
+  if (pred.loop_used) {
+    pred.final_prediction = pred.loop_prediction;
+  } else if (pred.corrector_used) {
+    pred.final_prediction = pred.corrector_prediction;
+  } else {
+    pred.final_prediction = pred.tage_prediction;
+  }
+
+  last = pred;
+  return pred.final_prediction;
+}
+
+champsim::branch_confidence tage_sc_l::prediction_confidence(champsim::address) const
+{
+  // A confident loop is all but certain, and the corrector only reverts predictions it has seen to be unreliable
+  if (last.loop_used) {
+    return champsim::branch_confidence::high;
+  }
+  if (last.corrector_used || (last.provider.has_value() && last.provider_weak)) {
+    return champsim::branch_confidence::low;
+  }
+  if (!last.provider.has_value()) {
+    return champsim::branch_confidence::medium;
+  }
+
+  // The provider counter is confident only when it is saturated
+  auto ctr = tagged.at(*last.provider).at(last.indices.at(*last.provider)).ctr;
+  return (ctr.is_max() || ctr.is_min()) ? champsim::branch_confidence::high : champsim::branch_confidence::medium;
+}
+
+void tage_sc_l::update_tage(const prediction_type& pred, bool taken)
+{
+  if (pred.provider.has_value()) {
+    auto& entry = tagged.at(*pred.provider).at(pred.indices.at(*pred.provider));
+    bool new_allocation = pred.provider_weak && entry.useful.value() == 0;
+    if (new_allocation && pred.provider_prediction != pred.alternate_prediction) {
+      use_alt_on_new_alloc += (pred.alternate_prediction == taken) ? 1 : -1;
+    }
+
+    // The useful bits record whether the provider was right where the alternate was not
+    if (pred.provider_prediction != pred.alternate_prediction) {
+      entry.useful += (pred.provider_prediction == taken) ? 1 : -1;
+    }
+    entry.ctr += taken ? 1 : -1;
+
+    // A new entry has not learned yet, so the alternate keeps learning
+    if (new_allocation) {
+      if (pred.alternate.has_value()) {
+        tagged.at(*pred.alternate).at(pred.indices.at(*pred.alternate)).ctr += taken ? 1 : -1;
+      } else {
+        bimodal.at(pred.bimodal_index) += taken ? 1 : -1;
+      }
+    }
+  } else {
+    bimodal.at(pred.bimodal_index) += taken ? 1 : -1;
+  }
+
+  // Allocate entries with longer histories after a misprediction
+  auto first_candidate = pred.provider.has_value() ? *pred.provider + 1 : std::size_t{0};
+  if (pred.tage_prediction != taken && first_candidate < NUM_TAGGED) {
+    // Randomly skip the first candidate, to spread allocations over the tables
+    if (first_candidate + 1 < NUM_TAGGED && (rng() & 0x3) == 0) {
+      ++first_candidate;
+    }
+
+    unsigned allocated = 0;
+    for (auto i = first_candidate; i < NUM_TAGGED && allocated < MAX_ALLOCATIONS; ++i) {
+      auto& entry = tagged.at(i).at(pred.indices.at(i));
+      if (entry.useful.value() == 0) {
+        entry = tagged_entry{};
+        entry.ctr = taken ? 0 : -1;
+        entry.tag = pred.tags.at(i);
+        ++allocated;
+        ++stats.allocations;
+      }
+    }
+
+    // If every candidate is useful, age them so that a later allocation succeeds
+    if (allocated == 0) {
+      for (auto i = first_candidate; i < NUM_TAGGED; ++i) {
+        --tagged.at(i).at(pred.indices.at(i)).useful;
+      }
+    }
+  }
+
+  // Gracefully reset the useful bits, so that entries that are no longer useful can be replaced
+  if ((++branch_count & mask(USEFUL_RESET_PERIOD_LOG)) == 0) {
+    for (auto& table : tagged) {
+      for (auto& entry : table) {
+        entry.useful = entry.useful.value() >> 1;
+      }
+    }
+  }
+}
+
+void tage_sc_l::update_loop(const prediction_type& pred, bool taken)
+{
+  auto set_begin = std::next(std::begin(loops), static_cast<long>(loop_set(pred.ip) * LOOP_WAYS));
+  auto set_end = std::next(set_begin, LOOP_WAYS);
+  auto tag = (pred.ip >> champsim::msl::lg2(LOOP_SETS)) & mask(LOOP_TAG_BITS);
+  auto found = std::find_if(set_begin, set_end, [tag](const auto& x) { return x.tag == tag; });
+
+  if (found == set_end) {
+    // Try to capture a loop when TAGE mispredicts what may be its exit
+    if (pred.tage_prediction != taken) {
+      auto victim = std::find_if(set_begin, set_end, [](const auto& x) { return x.age.value() == 0; });
+      if (victim != set_end) {
+        *victim = loop_entry{};
+        victim->tag = tag;
+        victim->direction = !taken;
+        victim->age = victim->age.maximum;
+      } else {
+        std::for_each(set_begin, set_end, [](auto& x) { --x.age; });
+      }
+    }
+    return;
+  }
+
+  if (pred.loop_valid && pred.loop_prediction != pred.tage_prediction) {
+    loop_usefulness += (pred.loop_prediction == taken) ? 1 : -1;
+  }
+
+  if (taken == found->direction) {
+    ++found->current_iterations;
+    if (found->current_iterations > mask(LOOP_ITER_BITS)) {
+      *found = loop_entry{}; // not a loop with a constant trip count that fits
+    }
+    return;
+  }
+
+  // The loop exited, so check that it ran for as many iterations as the last time
+  if (found->current_iterations == found->past_iterations && found->past_iterations > 0) {
+    ++found->confidence;
+    ++found->age;
+  } else {
+    found->past_iterations = found->current_iterations;
+    found->confidence = 0;
+  }
+  found->current_iterations = 0;
+}
+
+void tage_sc_l::update_corrector(const prediction_type& pred, bool taken)
+{
+  // The threshold rises when reversals are wrong, and falls when they would have been right
+  if (pred.corrector_prediction != pred.tage_prediction) {
+    if (pred.corrector_prediction == taken) {
+      corrector_threshold = std::max(corrector_threshold - 1, 2);
+    } else {
+      corrector_threshold = std::min(corrector_threshold + 1, 63);
+    }
+  }
+
+  if (pred.corrector_prediction != taken || std::abs(pred.corrector_sum) < corrector_threshold) {
+    corrector_bias.at(pred.corrector_bias_index) += taken ? 1 : -1;
+    for (std::size_t i = 0; i < SC_TABLES; ++i) {
+      corrector.at(i).at(pred.corrector_indices.at(i)) += taken ? 1 : -1;
+    }
+  }
+}
+
+void tage_sc_l::last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type)
+{
+  if (branch_type == BRANCH_CONDITIONAL && last.ip == ip.to<uint64_t>()) {
+    if (last.provider.has_value()) {
+      ++stats.provider_predictions;
+    }
+    if (last.loop_used) {
+      ++stats.loop_predictions;
+    } else if (last.corrector_used) {
+      ++stats.corrector_reversals;
+    }
+
+    update_tage(last, taken);
+    update_loop(last, taken);
+    update_corrector(last, taken);
+  }
+
+  // All branches enter the global history
+  for (auto& fold : index_folds) {
+    fold.push_back(taken);
+  }
+  for (auto& fold : tag_folds) {
+    fold.push_back(taken);
+  }
+  for (auto& fold : alt_tag_folds) {
+    fold.push_back(taken);
+  }
+  for (auto& fold : corrector_folds) {
+    fold.push_back(taken);
+  }
+}
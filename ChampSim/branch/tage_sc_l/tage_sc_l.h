@@ -0,0 +1,170 @@
+#ifndef BRANCH_TAGE_SC_L_H
+#define BRANCH_TAGE_SC_L_H
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "address.h"
+#include "modules.h"
+#include "msl/bits.h"
+#include "msl/fwcounter.h"
+#include "msl/tage_hashing.h"
+
+/*
+ * A TAGE-SC-L conditional branch predictor.
+ *
+ * A bimodal base predictor is overridden by a set of partially tagged tables indexed with geometrically increasing lengths of global
+ * history (TAGE). A loop predictor overrides TAGE for branches with a constant trip count, and a statistical corrector reverts TAGE
+ * predictions that have been wrong in similar contexts.
+ *
+ * The geometry of the tagged tables is set here. Their size is derived from the storage budget of the core, so that the whole predictor
+ * fits in it.
+ */
+class tage_sc_l : champsim::modules::branch_predictor
+{
+public:
+  using bits = champsim::data::bits;
+
+  // tagged geometric tables
+  constexpr static std::size_t NUM_TAGGED = 12;
+  constexpr static unsigned MIN_HISTORY = 4;
+  constexpr static unsigned MAX_HISTORY = 640;
+  constexpr static std::array<unsigned, NUM_TAGGED> TAG_BITS = {8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+  constexpr static std::size_t COUNTER_BITS = 3;
+  constexpr static std::size_t USEFUL_BITS = 2;
+  constexpr static std::size_t BIMODAL_BITS = 2;
+  constexpr static unsigned BIMODAL_RATIO_LOG = 2; // the bimodal table has this many times more entries than each tagged table, as a power of 2
+
+  // allocation policy
+  constexpr static unsigned MAX_ALLOCATIONS = 1;           // tagged entries allocated after a misprediction
+  constexpr static unsigned USEFUL_RESET_PERIOD_LOG = 18;  // branches between the graceful resets of the useful bits, as a power of 2
+  constexpr static std::size_t USE_ALT_COUNTER_BITS = 4;   // confidence that a newly allocated entry is less accurate than the alternate
+
+  // loop predictor
+  constexpr static std::size_t LOOP_SETS = 16;
+  constexpr static std::size_t LOOP_WAYS = 4;
+  constexpr static unsigned LOOP_TAG_BITS = 10;
+  constexpr static unsigned LOOP_ITER_BITS = 14;
+  constexpr static std::size_t LOOP_CONFIDENCE_BITS = 2;
+  constexpr static std::size_t LOOP_AGE_BITS = 3;
+
+  // statistical corrector
+  constexpr static std::size_t SC_TABLES = 4;
+  constexpr static unsigned SC_LOG_ENTRIES = 10;
+  constexpr static std::size_t SC_COUNTER_BITS = 6;
+  constexpr static std::array<unsigned, SC_TABLES> SC_HISTORY = {0, 6, 12, 24};
+
+  constexpr static std::size_t DEFAULT_BUDGET = 64 * 1024; // bytes
+  constexpr static unsigned MIN_TAGGED_LOG_ENTRIES = 4;
+
+  struct tagged_entry {
+    champsim::msl::sfwcounter<COUNTER_BITS> ctr{};
+    uint64_t tag = 0;
+    champsim::msl::fwcounter<USEFUL_BITS> useful{};
+  };
+
+  struct loop_entry {
+    uint64_t tag = 0;
+    uint64_t past_iterations = 0;
+    uint64_t current_iterations = 0;
+    bool direction = false; // the direction of the branch while the loop continues
+    champsim::msl::fwcounter<LOOP_CONFIDENCE_BITS> confidence{};
+    champsim::msl::fwcounter<LOOP_AGE_BITS> age{};
+  };
+
+  // The size of each structure, chosen from the storage budget
+  struct geometry_type {
+    unsigned tagged_log_entries = 0;
+    unsigned bimodal_log_entries = 0;
+  };
+
+  /**
+   * The largest geometry that fits in the given number of bytes
+   */
+  [[nodiscard]] static geometry_type geometry_for(std::size_t budget);
+
+  /**
+   * The number of bits of storage used by a geometry
+   */
+  [[nodiscard]] static std::size_t storage_bits(geometry_type geometry);
+
+  /**
+   * The history lengths of the tagged tables
+   */
+  [[nodiscard]] static std::array<unsigned, NUM_TAGGED> history_lengths();
+
+  geometry_type geometry{};
+  std::vector<champsim::msl::fwcounter<BIMODAL_BITS>> bimodal{};
+  std::array<std::vector<tagged_entry>, NUM_TAGGED> tagged{};
+  std::vector<loop_entry> loops = std::vector<loop_entry>(LOOP_SETS * LOOP_WAYS);
+  std::array<std::vector<champsim::msl::sfwcounter<SC_COUNTER_BITS>>, SC_TABLES> corrector{};
+  std::vector<champsim::msl::sfwcounter<SC_COUNTER_BITS>> corrector_bias = std::vector<champsim::msl::sfwcounter<SC_COUNTER_BITS>>(std::size_t{1} << SC_LOG_ENTRIES);
+
+  struct stats_type {
+    uint64_t provider_predictions = 0; // predictions made by a tagged table
+    uint64_t loop_predictions = 0;
+    uint64_t corrector_reversals = 0;
+    uint64_t allocations = 0;
+  } stats{};
+
+  using branch_predictor::branch_predictor;
+
+  void initialize_branch_predictor();
+  bool predict_branch(champsim::address ip);
+  champsim::branch_confidence prediction_confidence(champsim::address ip) const;
+  void last_branch_result(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+
+private:
+  // Each history is folded to the width of the index or tag it is hashed into
+  std::array<champsim::msl::tage::folded_history, NUM_TAGGED> index_folds{};
+  std::array<champsim::msl::tage::folded_history, NUM_TAGGED> tag_folds{};
+  std::array<champsim::msl::tage::folded_history, NUM_TAGGED> alt_tag_folds{}; // one bit narrower, so that the two tag folds differ
+  std::array<champsim::msl::tage::folded_history, SC_TABLES> corrector_folds{};
+
+  champsim::msl::sfwcounter<USE_ALT_COUNTER_BITS> use_alt_on_new_alloc{};
+  champsim::msl::sfwcounter<7> loop_usefulness{};
+  int corrector_threshold = 6;
+  uint64_t branch_count = 0;
+  champsim::msl::tage::xorshift rng{};
+
+  // The state of the last prediction, kept until the branch resolves
+  struct prediction_type {
+    uint64_t ip = 0;
+    std::array<std::size_t, NUM_TAGGED> indices{};
+    std::array<uint64_t, NUM_TAGGED> tags{};
+    std::size_t bimodal_index = 0;
+    std::optional<std::size_t> provider{};
+    std::optional<std::size_t> alternate{};
+    bool provider_prediction = false;
+    bool alternate_prediction = false;
+    bool tage_prediction = false;
+    bool provider_weak = false;
+
+    bool loop_valid = false;
+    bool loop_prediction = false;
+
+    std::array<std::size_t, SC_TABLES> corrector_indices{};
+    std::size_t corrector_bias_index = 0;
+    int corrector_sum = 0;
+    bool corrector_prediction = false;
+
+    bool final_prediction = false;
+    bool loop_used = false;
+    bool corrector_used = false;
+  };
+  prediction_type last{};
+
+  [[nodiscard]] std::size_t loop_set(uint64_t ip) const;
+
+  void predict_tage(prediction_type& pred) const;
+  void predict_loop(prediction_type& pred) const;
+  void predict_corrector(prediction_type& pred) const;
+
+  void update_tage(const prediction_type& pred, bool taken);
+  void update_loop(const prediction_type& pred, bool taken);
+  void update_corrector(const prediction_type& pred, bool taken);
+};
+
+#endif
@@ -4,28 +4,74 @@
  * It uses a set-associative BTB to predict the targets of non-return branches,
  * and it uses a small Return Address Stack (RAS) to predict the target of
  * returns.
+ *
+ * If PREFILL is set, the BTB is also filled ahead of the branches' first
+ * execution from the blocks that the L1I fills.
  */
 
 #include "basic_btb.h"
 
 #include "instruction.h"
+#include "ooo_cpu.h"
+
+void basic_btb::initialize_btb()
+{
+  if constexpr (PREFILL)
+    prefill.attach(intern_);
+}
 
 std::pair<champsim::address, bool> basic_btb::btb_prediction(champsim::address ip)
 {
   // use BTB for all other branches + direct calls
-  auto btb_entry = direct.check_hit(ip);
+  auto [btb_entry, level, latency] = direct.lookup(ip);
+
+  // move a predecoded branch into the BTB on its first use
+  if (PREFILL && !btb_entry.has_value()) {
+    btb_entry = prefill.take(ip);
+    if (btb_entry.has_value()) {
+      direct.fill(btb_entry.value());
+      level = 0; // the prefetch buffer is searched alongside the first level
+      latency = direct.latency.front();
+    }
+  }
+
+  if (intern_ != nullptr) {
+    intern_->last_btb_lookup = {direct.num_levels(), btb_entry.has_value() ? std::optional{level} : std::nullopt, latency};
+  }
+
+  // a known branch is missing, so bring its block into the L1I to predecode it
+  if (PREFILL && !btb_entry.has_value())
+    prefill.miss(ip);
 
   // no prediction for this IP
   if (!btb_entry.has_value())
     return {champsim::address{}, false};
 
-  if (btb_entry->type == direct_predictor::branch_info::RETURN)
+  return target_of(btb_entry.value(), ip);
+}
+
+std::pair<champsim::address, bool> basic_btb::btb_peek(champsim::address ip) const
+{
+  // the same search as btb_prediction, but it leaves the BTB, the prefetch buffer, and the L1I as they were
+  auto btb_entry = direct.peek(ip);
+  if (PREFILL && !btb_entry.has_value())
+    btb_entry = prefill.peek(ip);
+
+  if (!btb_entry.has_value())
+    return {champsim::address{}, false};
+
+  return target_of(btb_entry.value(), ip);
+}
+
+std::pair<champsim::address, bool> basic_btb::target_of(const direct_predictor::btb_entry_t& entry, champsim::address ip) const
+{
+  if (entry.type == direct_predictor::branch_info::RETURN)
     return ras.prediction();
 
-  if (btb_entry->type == direct_predictor::branch_info::INDIRECT)
+  if (entry.type == direct_predictor::branch_info::INDIRECT)
     return indirect.prediction(ip);
 
-  return {btb_entry->target, btb_entry->type != direct_predictor::branch_info::CONDITIONAL};
+  return {entry.target, entry.type != direct_predictor::branch_info::CONDITIONAL};
 }
 
 void basic_btb::update_btb(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type)
@@ -1,24 +1,44 @@
 #ifndef BTB_BASIC_BTB_H
 #define BTB_BASIC_BTB_H
 
+#include <array>
+
 #include "address.h"
 #include "direct_predictor.h"
 #include "indirect_predictor.h"
 #include "modules.h"
+#include "predecoder.h"
 #include "return_stack.h"
 
 class basic_btb : champsim::modules::btb
 {
+  // The levels of the BTB, from the fastest, as {sets, ways, latency}. For example, a small L1 BTB backed by a large, slower L2 BTB
+  // would be {{{64, 4, 0}, {4096, 8, 2}}}.
+  static constexpr std::array<direct_predictor::level_type, 1> BTB_LEVELS{{{1024, 8, 0}}};
+
+  // If nonzero, a miss in the first level copies up the region of this many bytes around the branch from the lower levels
+  static constexpr std::size_t BULK_TRANSFER_REGION = 0;
+
+  // If set, the BTB is filled ahead of the branches' first execution from the blocks that the L1I fills, as described in predecoder.h.
+  // The predecoded branches wait in a prefetch buffer of this geometry until their first lookup.
+  static constexpr bool PREFILL = false;
+  static constexpr std::size_t PREFETCH_BUFFER_SETS = 1;
+  static constexpr std::size_t PREFETCH_BUFFER_WAYS = 32;
+
   return_stack ras{};
   indirect_predictor indirect{};
-  direct_predictor direct{};
+  direct_predictor direct{{std::begin(BTB_LEVELS), std::end(BTB_LEVELS)}, BULK_TRANSFER_REGION};
+  predecoder prefill{PREFETCH_BUFFER_SETS, PREFETCH_BUFFER_WAYS};
+
+  [[nodiscard]] std::pair<champsim::address, bool> target_of(const direct_predictor::btb_entry_t& entry, champsim::address ip) const;
 
 public:
   using btb::btb;
   basic_btb() : btb(nullptr) {}
 
-  // void initialize_btb();
+  void initialize_btb();
   std::pair<champsim::address, bool> btb_prediction(champsim::address ip);
+  [[nodiscard]] std::pair<champsim::address, bool> btb_peek(champsim::address ip) const;
   void update_btb(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
 };
 
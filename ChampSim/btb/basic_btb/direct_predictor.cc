@@ -1,24 +1,83 @@
 #include "direct_predictor.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 #include "instruction.h"
 
-auto direct_predictor::check_hit(champsim::address ip) -> std::optional<btb_entry_t>
+direct_predictor::direct_predictor(std::vector<level_type> levels, std::size_t bulk_transfer_region_) : bulk_transfer_region(bulk_transfer_region_)
+{
+  if (std::empty(levels))
+    throw std::invalid_argument{"The BTB must have at least one level"};
+
+  for (auto level : levels) {
+    BTB.emplace_back(level.sets, level.ways);
+    latency.push_back(level.latency);
+  }
+}
+
+auto direct_predictor::lookup(champsim::address ip) -> lookup_result
+{
+  lookup_result result{std::nullopt, num_levels(), 0};
+  for (std::size_t level = 0; level < num_levels() && !result.entry.has_value(); ++level) {
+    auto hit = BTB.at(level).check_hit({ip, champsim::address{}, branch_info::ALWAYS_TAKEN});
+    if (hit.has_value()) {
+      for (std::size_t upper = 0; upper < level; ++upper)
+        BTB.at(upper).fill(hit.value());
+      result = {hit, level, latency.at(level)};
+    }
+  }
+
+  // a miss in the first level brings up the rest of the region, in case its other branches are needed soon
+  if (bulk_transfer_region > 0 && result.level > 0)
+    transfer_region(ip);
+
+  return result;
+}
+
+auto direct_predictor::check_hit(champsim::address ip) -> std::optional<btb_entry_t> { return lookup(ip).entry; }
+
+auto direct_predictor::peek(champsim::address ip) const -> std::optional<btb_entry_t>
 {
-  return BTB.check_hit({ip, champsim::address{}, branch_info::ALWAYS_TAKEN});
+  for (const auto& level : BTB) {
+    if (auto hit = level.peek({ip, champsim::address{}, branch_info::ALWAYS_TAKEN}); hit.has_value())
+      return hit;
+  }
+  return std::nullopt;
+}
+
+void direct_predictor::fill(const btb_entry_t& entry)
+{
+  for (auto& level : BTB)
+    level.fill(entry);
+
+  if (bulk_transfer_region > 0) {
+    auto& members = region_members[region_of(entry.ip_tag)];
+    if (std::find(std::begin(members), std::end(members), entry.ip_tag) == std::end(members))
+      members.push_back(entry.ip_tag);
+  }
+}
+
+auto direct_predictor::classify(uint8_t branch_type) -> branch_info
+{
+  if ((branch_type == BRANCH_INDIRECT) || (branch_type == BRANCH_INDIRECT_CALL))
+    return branch_info::INDIRECT;
+  if (branch_type == BRANCH_RETURN)
+    return branch_info::RETURN;
+  if (branch_type == BRANCH_CONDITIONAL)
+    return branch_info::CONDITIONAL;
+  return branch_info::ALWAYS_TAKEN;
 }
 
 void direct_predictor::update(champsim::address ip, champsim::address branch_target, uint8_t branch_type)
 {
   // update btb entry
-  auto type = branch_info::ALWAYS_TAKEN;
-  if ((branch_type == BRANCH_INDIRECT) || (branch_type == BRANCH_INDIRECT_CALL))
-    type = branch_info::INDIRECT;
-  else if (branch_type == BRANCH_RETURN)
-    type = branch_info::RETURN;
-  else if (branch_type == BRANCH_CONDITIONAL)
-    type = branch_info::CONDITIONAL;
+  auto type = classify(branch_type);
+
+  std::optional<btb_entry_t> opt_entry;
+  for (auto level = std::begin(BTB); level != std::end(BTB) && !opt_entry.has_value(); ++level)
+    opt_entry = level->check_hit({ip, branch_target, type});
 
-  auto opt_entry = BTB.check_hit({ip, branch_target, type});
   if (opt_entry.has_value()) {
     opt_entry->type = type;
     if (branch_target != champsim::address{})
@@ -26,6 +85,35 @@ void direct_predictor::update(champsim::address ip, champsim::address branch_tar
   }
 
   if (branch_target != champsim::address{}) {
-    BTB.fill(opt_entry.value_or(btb_entry_t{ip, branch_target, type}));
+    fill(opt_entry.value_or(btb_entry_t{ip, branch_target, type}));
   }
 }
+
+uint64_t direct_predictor::region_of(champsim::address ip) const { return ip.to<uint64_t>() / bulk_transfer_region; }
+
+void direct_predictor::transfer_region(champsim::address ip)
+{
+  auto region = region_of(ip);
+  if (last_transferred_region == region)
+    return;
+  last_transferred_region = region;
+
+  auto members = region_members.find(region);
+  if (members == std::end(region_members))
+    return;
+
+  // Copy each branch of the region up from the first level that holds it, and forget the branches that have left the BTB
+  auto still_present = [this](champsim::address member) {
+    for (std::size_t level = 1; level < num_levels(); ++level) {
+      auto hit = BTB.at(level).check_hit({member, champsim::address{}, branch_info::ALWAYS_TAKEN});
+      if (hit.has_value()) {
+        for (std::size_t upper = 0; upper < level; ++upper)
+          BTB.at(upper).fill(hit.value());
+        return true;
+      }
+    }
+    return false;
+  };
+  auto& list = members->second;
+  list.erase(std::remove_if(std::begin(list), std::end(list), [&](auto member) { return !still_present(member); }), std::end(list));
+}
@@ -2,12 +2,18 @@
 #define BTB_BASIC_BTB_DIRECT_PREDICTOR_H
 
 #include <cstdint>
+#include <map>
 #include <optional>
+#include <vector>
 
 #include "address.h"
 #include "champsim.h"
 #include "msl/lru_table.h"
 
+/*
+ * A hierarchy of set-associative BTB levels. The first level is the fastest. Each level holds a subset of the entries of the
+ * levels below it, and an entry found in a lower level is copied into all of the levels above it.
+ */
 struct direct_predictor {
   enum class branch_info {
     INDIRECT,
@@ -16,8 +22,11 @@ struct direct_predictor {
     CONDITIONAL,
   };
 
-  static constexpr std::size_t sets = 1024;
-  static constexpr std::size_t ways = 8;
+  struct level_type {
+    std::size_t sets;
+    std::size_t ways;
+    unsigned latency; // the cycles before a hit in this level can redirect the branch prediction unit
+  };
 
   struct btb_entry_t {
     champsim::address ip_tag{};
@@ -36,9 +45,41 @@ struct direct_predictor {
     }
   };
 
-  champsim::msl::lru_table<btb_entry_t> BTB{sets, ways};
+  struct lookup_result {
+    std::optional<btb_entry_t> entry{};
+    std::size_t level{}; // the level that held the entry, or the number of levels on a miss
+    unsigned latency{};
+  };
+
+  /**
+   * \param levels the geometry of each level, from the fastest
+   * \param bulk_transfer_region if nonzero, a miss in the first level copies up the entries of the lower levels that lie in the same region
+   * of this many bytes
+   *
+   * \throws std::invalid_argument if there are no levels
+   */
+  explicit direct_predictor(std::vector<level_type> levels = {{1024, 8, 0}}, std::size_t bulk_transfer_region = 0);
+
+  std::vector<champsim::msl::lru_table<btb_entry_t>> BTB;
+  std::vector<unsigned> latency;
+
+  lookup_result lookup(champsim::address ip);
   std::optional<btb_entry_t> check_hit(champsim::address ip);
+  [[nodiscard]] std::optional<btb_entry_t> peek(champsim::address ip) const; // a lookup that neither promotes the entry nor updates LRU
+  void fill(const btb_entry_t& entry);
   void update(champsim::address ip, champsim::address branch_target, uint8_t branch_type);
+
+  [[nodiscard]] std::size_t num_levels() const { return std::size(BTB); }
+
+  static branch_info classify(uint8_t branch_type);
+
+private:
+  std::size_t bulk_transfer_region;
+  std::map<uint64_t, std::vector<champsim::address>> region_members{}; // the branches filled into the BTB, by region
+  std::optional<uint64_t> last_transferred_region{};
+
+  [[nodiscard]] uint64_t region_of(champsim::address ip) const;
+  void transfer_region(champsim::address ip);
 };
 
 #endif
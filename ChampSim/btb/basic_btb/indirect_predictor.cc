@@ -1,6 +1,6 @@
 #include "indirect_predictor.h"
 
-std::pair<champsim::address, bool> indirect_predictor::prediction(champsim::address ip)
+std::pair<champsim::address, bool> indirect_predictor::prediction(champsim::address ip) const
 {
   using namespace champsim::data::data_literals;
   auto hash = ip.slice_upper<2_b>().to<unsigned long long>() ^ conditional_history.to_ullong();
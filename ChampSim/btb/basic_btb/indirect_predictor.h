@@ -15,7 +15,7 @@ struct indirect_predictor {
   std::array<champsim::address, size> predictor = {};
   std::bitset<champsim::msl::lg2(size)> conditional_history = {};
 
-  std::pair<champsim::address, bool> prediction(champsim::address ip);
+  std::pair<champsim::address, bool> prediction(champsim::address ip) const;
   void update_target(champsim::address ip, champsim::address branch_target);
   void update_direction(bool taken);
 };
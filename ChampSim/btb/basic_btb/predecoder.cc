@@ -0,0 +1,45 @@
+#include "predecoder.h"
+
+#include "cache.h"
+#include "ooo_cpu.h"
+
+void predecoder::attach(O3_CPU* cpu_)
+{
+  if (cpu_ == nullptr || cpu_->l1i == nullptr)
+    return;
+
+  cpu = cpu_;
+  cpu->record_code_map = true;
+  cpu->l1i->fill_observers.emplace_back([this](champsim::address block_addr) { predecode(block_addr); });
+}
+
+void predecoder::predecode(champsim::address block_addr)
+{
+  champsim::address block_begin{champsim::block_number{block_addr}};
+  champsim::address block_end{champsim::block_number{block_addr} + 1};
+  for (auto [ip, info] : cpu->code_map.branches_in(block_begin, block_end)) {
+    // A branch that has never been taken has no target to predict
+    if (info.target != champsim::address{})
+      prefetch_buffer.fill({ip, info.target, direct_predictor::classify(info.branch_type)});
+  }
+}
+
+auto predecoder::take(champsim::address ip) -> std::optional<direct_predictor::btb_entry_t>
+{
+  return prefetch_buffer.invalidate({ip, champsim::address{}, direct_predictor::branch_info::ALWAYS_TAKEN});
+}
+
+auto predecoder::peek(champsim::address ip) const -> std::optional<direct_predictor::btb_entry_t>
+{
+  return prefetch_buffer.peek({ip, champsim::address{}, direct_predictor::branch_info::ALWAYS_TAKEN});
+}
+
+void predecoder::miss(champsim::address ip) const
+{
+  if (cpu == nullptr)
+    return;
+
+  auto known = cpu->code_map.next_branch(ip, ip + 1);
+  if (known.has_value() && known->second.target != champsim::address{})
+    cpu->l1i->prefetch_line(ip, true, 0);
+}
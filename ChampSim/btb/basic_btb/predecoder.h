@@ -0,0 +1,42 @@
+#ifndef BTB_BASIC_BTB_PREDECODER_H
+#define BTB_BASIC_BTB_PREDECODER_H
+
+#include <optional>
+
+#include "address.h"
+#include "direct_predictor.h"
+#include "msl/lru_table.h"
+
+class O3_CPU;
+
+/*
+ * Fills the BTB ahead of the branches' first execution. The branches in each block that the L1I fills are predecoded into a small prefetch
+ * buffer, where they wait until their first lookup so that they do not displace trained entries. A BTB miss on a branch that the core has
+ * seen prefetches its block into the L1I, so that it may be predecoded.
+ *
+ * The branches are learned from those seen so far in the trace, so a core with a predecoder keeps a code map that grows with the code
+ * footprint of the trace. The prefetches are issued through the L1I, and are counted with those of its prefetcher.
+ */
+class predecoder
+{
+  O3_CPU* cpu = nullptr;
+
+  void predecode(champsim::address block_addr);
+
+public:
+  champsim::msl::lru_table<direct_predictor::btb_entry_t> prefetch_buffer;
+
+  predecoder(std::size_t sets, std::size_t ways) : prefetch_buffer(sets, ways) {}
+
+  // Begin predecoding the blocks that the core's L1I fills
+  void attach(O3_CPU* cpu_);
+
+  // Remove the predecoded branch from the buffer, to be filled into the BTB
+  std::optional<direct_predictor::btb_entry_t> take(champsim::address ip);
+  [[nodiscard]] std::optional<direct_predictor::btb_entry_t> peek(champsim::address ip) const;
+
+  // The BTB has missed on this branch, so bring its block into the L1I if the branch is known
+  void miss(champsim::address ip) const;
+};
+
+#endif
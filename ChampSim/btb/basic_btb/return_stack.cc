@@ -1,6 +1,6 @@
 #include "return_stack.h"
 
-std::pair<champsim::address, bool> return_stack::prediction()
+std::pair<champsim::address, bool> return_stack::prediction() const
 {
   if (std::empty(stack))
     return {champsim::address{}, true};
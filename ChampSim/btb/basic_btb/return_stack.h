@@ -23,7 +23,7 @@ struct return_stack {
 
   return_stack() { std::fill(std::begin(call_size_trackers), std::end(call_size_trackers), 4); }
 
-  std::pair<champsim::address, bool> prediction();
+  std::pair<champsim::address, bool> prediction() const;
   void push(champsim::address ip);
   void calibrate_call_size(champsim::address branch_target);
 };
@@ -0,0 +1,192 @@
+/*
+ * This predictor follows the structure of Seznec, "A 64-Kbytes ITTAGE indirect branch predictor," JWAC-2 (2011). It keeps the tagged
+ * tables, their allocation policy, and the alternate prediction for new entries, but not the per-table target region compression.
+ */
+
+#include "ittage.h"
+
+#include "instruction.h"
+
+namespace
+{
+// The target is replaced only once the entry has lost confidence in it
+template <typename T>
+void train(T& entry, champsim::address branch_target)
+{
+  if (entry.target == branch_target) {
+    ++entry.confidence;
+  } else if (entry.confidence.value() == 0) {
+    entry.target = branch_target;
+  } else {
+    --entry.confidence;
+  }
+}
+
+bool is_indirect(uint8_t branch_type) { return branch_type == BRANCH_INDIRECT || branch_type == BRANCH_INDIRECT_CALL; }
+} // namespace
+
+using champsim::msl::tage::mask;
+
+auto ittage::history_lengths() -> std::array<unsigned, NUM_TAGGED> { return champsim::msl::tage::geometric_lengths<NUM_TAGGED>(MIN_HISTORY, MAX_HISTORY); }
+
+void ittage::initialize_btb()
+{
+  for (auto& table : tagged) {
+    table.assign(std::size_t{1} << TAGGED_LOG_ENTRIES, target_entry{});
+  }
+
+  auto lengths = history_lengths();
+  for (std::size_t i = 0; i < NUM_TAGGED; ++i) {
+    auto history_bits = lengths.at(i) * HISTORY_BITS_PER_BRANCH;
+    index_folds.at(i) = champsim::msl::tage::folded_history{history_bits, TAGGED_LOG_ENTRIES};
+    tag_folds.at(i) = champsim::msl::tage::folded_history{history_bits, TAG_BITS.at(i)};
+    alt_tag_folds.at(i) = champsim::msl::tage::folded_history{history_bits, TAG_BITS.at(i) - 1};
+  }
+}
+
+auto ittage::lookup(champsim::address ip) const -> lookup_type
+{
+  using namespace champsim::data::data_literals;
+  lookup_type retval{};
+  auto raw_ip = ip.slice_upper<2_b>().to<uint64_t>();
+  for (std::size_t i = 0; i < NUM_TAGGED; ++i) {
+    auto tag_bits = TAG_BITS.at(i);
+    retval.indices.at(i) = (raw_ip ^ (raw_ip >> (TAGGED_LOG_ENTRIES + i)) ^ index_folds.at(i).value()) & mask(TAGGED_LOG_ENTRIES);
+    retval.tags.at(i) = (raw_ip ^ tag_folds.at(i).value() ^ (alt_tag_folds.at(i).value() << 1)) & mask(tag_bits);
+  }
+  retval.base_index = raw_ip & mask(BASE_LOG_ENTRIES);
+
+  // The provider is the hitting table with the longest history, and the alternate is the next one
+  for (std::size_t i = NUM_TAGGED; i > 0; --i) {
+    const auto& table = tagged.at(i - 1);
+    if (!std::empty(table) && table.at(retval.indices.at(i - 1)).tag == retval.tags.at(i - 1)
+        && table.at(retval.indices.at(i - 1)).target != champsim::address{}) {
+      if (!retval.provider.has_value()) {
+        retval.provider = i - 1;
+      } else {
+        retval.alternate = i - 1;
+        break;
+      }
+    }
+  }
+
+  retval.alternate_target = retval.alternate.has_value() ? tagged.at(*retval.alternate).at(retval.indices.at(*retval.alternate)).target
+                                                         : base.at(retval.base_index).target;
+  if (!retval.provider.has_value()) {
+    retval.prediction = retval.alternate_target;
+    return retval;
+  }
+
+  const auto& entry = tagged.at(*retval.provider).at(retval.indices.at(*retval.provider));
+  retval.provider_target = entry.target;
+
+  // A newly allocated entry is often less accurate than the alternate prediction
+  retval.new_allocation = entry.confidence.value() == 0 && entry.useful.value() == 0;
+  bool use_alternate = retval.new_allocation && use_alt_on_new_alloc.value() >= 0 && retval.alternate_target != champsim::address{};
+  retval.prediction = use_alternate ? retval.alternate_target : retval.provider_target;
+  return retval;
+}
+
+std::pair<champsim::address, bool> ittage::btb_prediction(champsim::address ip, uint8_t branch_type) { return btb_peek(ip, branch_type); }
+
+std::pair<champsim::address, bool> ittage::btb_peek(champsim::address ip, uint8_t branch_type) const
+{
+  if (!is_indirect(branch_type)) {
+    return {champsim::address{}, false};
+  }
+
+  return {lookup(ip).prediction, true};
+}
+
+void ittage::allocate(const lookup_type& found, champsim::address branch_target)
+{
+  auto first_candidate = found.provider.has_value() ? *found.provider + 1 : std::size_t{0};
+  if (first_candidate >= NUM_TAGGED) {
+    return;
+  }
+
+  // Randomly skip the first candidate, to spread allocations over the tables
+  if (first_candidate + 1 < NUM_TAGGED && (rng() & 0x3) == 0) {
+    ++first_candidate;
+  }
+
+  for (auto i = first_candidate; i < NUM_TAGGED; ++i) {
+    auto& entry = tagged.at(i).at(found.indices.at(i));
+    if (entry.useful.value() == 0) {
+      entry = target_entry{branch_target, found.tags.at(i), {}, {}};
+      ++stats.allocations;
+      return;
+    }
+  }
+
+  // If every candidate is useful, age them so that a later allocation succeeds
+  for (auto i = first_candidate; i < NUM_TAGGED; ++i) {
+    --tagged.at(i).at(found.indices.at(i)).useful;
+  }
+}
+
+void ittage::push_history(champsim::address ip, champsim::address branch_target, bool taken)
+{
+  using namespace champsim::data::data_literals;
+  // Each branch adds its direction, then the taken branches add a few bits of their path
+  auto path = taken ? (ip.slice_upper<2_b>().to<uint64_t>() ^ branch_target.slice_upper<2_b>().to<uint64_t>()) : uint64_t{0};
+  auto push_all = [this](bool bit) {
+    for (auto& fold : index_folds) {
+      fold.push_back(bit);
+    }
+    for (auto& fold : tag_folds) {
+      fold.push_back(bit);
+    }
+    for (auto& fold : alt_tag_folds) {
+      fold.push_back(bit);
+    }
+  };
+
+  push_all(taken);
+  for (unsigned i = 0; i < PATH_BITS; ++i) {
+    push_all(((path >> i) & 1) != 0);
+  }
+}
+
+void ittage::update_btb(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type)
+{
+  if (is_indirect(branch_type) && branch_target != champsim::address{} && !std::empty(tagged.front())) {
+    auto found = lookup(ip);
+    if (found.prediction != branch_target) {
+      ++stats.mispredictions;
+    }
+
+    if (found.provider.has_value()) {
+      ++stats.provider_predictions;
+      auto& entry = tagged.at(*found.provider).at(found.indices.at(*found.provider));
+      if (found.new_allocation && found.provider_target != found.alternate_target) {
+        use_alt_on_new_alloc += (found.alternate_target == branch_target) ? 1 : -1;
+      }
+
+      // The useful bit records whether the provider was right where the alternate was not
+      if (found.provider_target != found.alternate_target) {
+        entry.useful += (found.provider_target == branch_target) ? 1 : -1;
+      }
+
+      train(entry, branch_target);
+    } else {
+      train(base.at(found.base_index), branch_target);
+    }
+
+    if (found.prediction != branch_target) {
+      allocate(found, branch_target);
+    }
+
+    // Reset the useful bits, so that entries that are no longer useful can be replaced
+    if ((++branch_count & mask(USEFUL_RESET_PERIOD_LOG)) == 0) {
+      for (auto& table : tagged) {
+        for (auto& entry : table) {
+          entry.useful = 0;
+        }
+      }
+    }
+  }
+
+  // All branches enter the global history
+  push_history(ip, branch_target, taken);
+}
@@ -0,0 +1,108 @@
+#ifndef BTB_ITTAGE_H
+#define BTB_ITTAGE_H
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "msl/tage_hashing.h"
+#include "address.h"
+#include "modules.h"
+#include "msl/bits.h"
+#include "msl/fwcounter.h"
+
+/*
+ * An ITTAGE indirect target predictor.
+ *
+ * A target table indexed by the instruction pointer is overridden by a set of partially tagged tables indexed with geometrically
+ * increasing lengths of global path history. Each branch enters the history with its direction and a few bits of its path.
+ *
+ * This module predicts only indirect jumps and calls. List it after another BTB, as in "btb": ["basic_btb", "ittage"], so that it
+ * overrides that BTB's prediction for indirect branches and leaves the other branches to it.
+ */
+class ittage : champsim::modules::btb
+{
+public:
+  using bits = champsim::data::bits;
+
+  // tagged geometric tables
+  constexpr static std::size_t NUM_TAGGED = 8;
+  constexpr static unsigned MIN_HISTORY = 4;   // branches
+  constexpr static unsigned MAX_HISTORY = 300; // branches
+  constexpr static unsigned TAGGED_LOG_ENTRIES = 10;
+  constexpr static std::array<unsigned, NUM_TAGGED> TAG_BITS = {9, 9, 10, 10, 11, 11, 12, 12};
+  constexpr static std::size_t CONFIDENCE_BITS = 2;
+  constexpr static std::size_t USEFUL_BITS = 1;
+  constexpr static unsigned BASE_LOG_ENTRIES = 12;
+
+  // path history
+  constexpr static unsigned PATH_BITS = 2; // bits of the path that each taken branch adds to the history, after its direction
+  constexpr static unsigned HISTORY_BITS_PER_BRANCH = 1 + PATH_BITS;
+
+  // allocation policy
+  constexpr static unsigned USEFUL_RESET_PERIOD_LOG = 18; // indirect branches between resets of the useful bits, as a power of 2
+  constexpr static std::size_t USE_ALT_COUNTER_BITS = 4;  // confidence that a newly allocated entry is less accurate than the alternate
+
+  struct target_entry {
+    champsim::address target{};
+    uint64_t tag = 0;
+    champsim::msl::fwcounter<CONFIDENCE_BITS> confidence{};
+    champsim::msl::fwcounter<USEFUL_BITS> useful{};
+  };
+
+  struct base_entry {
+    champsim::address target{};
+    champsim::msl::fwcounter<CONFIDENCE_BITS> confidence{};
+  };
+
+  /**
+   * The history lengths of the tagged tables, in branches
+   */
+  [[nodiscard]] static std::array<unsigned, NUM_TAGGED> history_lengths();
+
+  std::vector<base_entry> base = std::vector<base_entry>(std::size_t{1} << BASE_LOG_ENTRIES);
+  std::array<std::vector<target_entry>, NUM_TAGGED> tagged{};
+
+  struct stats_type {
+    uint64_t provider_predictions = 0; // predictions made by a tagged table
+    uint64_t mispredictions = 0;
+    uint64_t allocations = 0;
+  } stats{};
+
+  using btb::btb;
+  ittage() : btb(nullptr) {}
+
+  void initialize_btb();
+  std::pair<champsim::address, bool> btb_prediction(champsim::address ip, uint8_t branch_type);
+  [[nodiscard]] std::pair<champsim::address, bool> btb_peek(champsim::address ip, uint8_t branch_type) const;
+  void update_btb(champsim::address ip, champsim::address branch_target, bool taken, uint8_t branch_type);
+
+private:
+  // Each history is folded to the width of the index or tag it is hashed into
+  std::array<champsim::msl::tage::folded_history, NUM_TAGGED> index_folds{};
+  std::array<champsim::msl::tage::folded_history, NUM_TAGGED> tag_folds{};
+  std::array<champsim::msl::tage::folded_history, NUM_TAGGED> alt_tag_folds{}; // one bit narrower, so that the two tag folds differ
+
+  champsim::msl::sfwcounter<USE_ALT_COUNTER_BITS> use_alt_on_new_alloc{};
+  uint64_t branch_count = 0;
+  champsim::msl::tage::xorshift rng{};
+
+  struct lookup_type {
+    std::array<std::size_t, NUM_TAGGED> indices{};
+    std::array<uint64_t, NUM_TAGGED> tags{};
+    std::size_t base_index = 0;
+    std::optional<std::size_t> provider{};
+    std::optional<std::size_t> alternate{};
+    champsim::address provider_target{};
+    champsim::address alternate_target{};
+    bool new_allocation = false; // the provider was allocated recently and has not been confirmed
+    champsim::address prediction{};
+  };
+
+  [[nodiscard]] lookup_type lookup(champsim::address ip) const;
+  void allocate(const lookup_type& found, champsim::address branch_target);
+  void push_history(champsim::address ip, champsim::address branch_target, bool taken);
+};
+
+#endif
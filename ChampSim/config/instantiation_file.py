@@ -29,6 +29,9 @@ queue_fmtstr = '{rq_size}, {pq_size}, {wq_size}, champsim::data::bits{{{_offset_
 
 core_builder_parts = {
     'ifetch_buffer_size': '.ifetch_buffer_size({ifetch_buffer_size})',
+    'ftq_size': '.ftq_size({ftq_size})',
+    'wrong_path_fetch': '.wrong_path_fetch({wrong_path_fetch:b})',
+    'lsd_size': '.lsd_size({lsd_size})',
     'decode_buffer_size': '.decode_buffer_size({decode_buffer_size})',
     'dispatch_buffer_size': '.dispatch_buffer_size({dispatch_buffer_size})',
     'register_file_size': '.register_file_size({register_file_size})',
@@ -36,6 +39,8 @@ core_builder_parts = {
     'lq_size': '.lq_size({lq_size})',
     'sq_size': '.sq_size({sq_size})',
     'fetch_width': '.fetch_width(champsim::bandwidth::maximum_type{{{fetch_width}}})',
+    'taken_branches_per_cycle': '.taken_branches_per_cycle(champsim::bandwidth::maximum_type{{{taken_branches_per_cycle}}})',
+    'fetch_blocks_per_cycle': '.fetch_blocks_per_cycle(champsim::bandwidth::maximum_type{{{fetch_blocks_per_cycle}}})',
     'decode_width': '.decode_width(champsim::bandwidth::maximum_type{{{decode_width}}})',
     'dispatch_width': '.dispatch_width(champsim::bandwidth::maximum_type{{{dispatch_width}}})',
     'scheduler_size': '.schedule_width(champsim::bandwidth::maximum_type{{{scheduler_size}}})',
@@ -44,6 +49,8 @@ core_builder_parts = {
     'sq_width': '.sq_width(champsim::bandwidth::maximum_type{{{sq_width}}})',
     'retire_width': '.retire_width(champsim::bandwidth::maximum_type{{{retire_width}}})',
     'mispredict_penalty': '.mispredict_penalty({mispredict_penalty})',
+    'branch_predictor_budget': '.branch_predictor_budget({branch_predictor_budget})',
+    'slow_predictor_latency': '.slow_predictor_latency({slow_predictor_latency})',
     'decode_latency': '.decode_latency({decode_latency})',
     'dispatch_latency': '.dispatch_latency({dispatch_latency})',
     'schedule_latency': '.schedule_latency({schedule_latency})',
@@ -65,6 +72,16 @@ dib_builder_parts = {
     'window_size': '  .dib_window({DIB[window_size]})'
 }
 
+uop_cache_builder_parts = {
+    'sets': '  .uop_cache_set({uop_cache[sets]})',
+    'ways': '  .uop_cache_way({uop_cache[ways]})',
+    'window_size': '  .uop_cache_window({uop_cache[window_size]})',
+    'uops_per_line': '  .uop_cache_uops_per_line({uop_cache[uops_per_line]})',
+    'lines_per_window': '  .uop_cache_lines_per_window({uop_cache[lines_per_window]})',
+    'partial_windows': '  .uop_cache_partial_windows({uop_cache[partial_windows]:b})',
+    'switch_penalty': '  .uop_cache_switch_penalty({uop_cache[switch_penalty]})'
+}
+
 cache_builder_parts = {
     'size': '.size(champsim::data::bytes{{{size}}})',
     'log2_size': '.log2_size({log2_size})',
@@ -130,7 +147,8 @@ def get_cpu_builder(cpu, caches, ul_pairs):
         ('champsim::core_builder{{ champsim::defaults::default_core }}',),
         required_parts,
         *(util.wrap_list(v) for k,v in core_builder_parts.items() if k in cpu),
-        (v for k,v in dib_builder_parts.items() if k in cpu.get('DIB',{}))
+        (v for k,v in dib_builder_parts.items() if k in cpu.get('DIB',{})),
+        (v for k,v in uop_cache_builder_parts.items() if k in cpu.get('uop_cache',{}))
     ), indent=1, line_end=''))
     yield from (part.format(**cpu, **local_params) for part in builder_parts)
 
@@ -149,7 +167,11 @@ def get_cache_builder(elem, ul_pairs):
         ('wq_check_full_addr', True): '.set_wq_checks_full_addr()',
         ('wq_check_full_addr', False): '.reset_wq_checks_full_addr()',
         ('virtual_prefetch', True): '.set_virtual_prefetch()',
-        ('virtual_prefetch', False): '.reset_virtual_prefetch()'
+        ('virtual_prefetch', False): '.reset_virtual_prefetch()',
+        ('translation_prefetch', True): '.set_translation_prefetch()',
+        ('translation_prefetch', False): '.reset_translation_prefetch()',
+        ('instruction_prefetch', True): '.set_instruction_prefetch()',
+        ('instruction_prefetch', False): '.reset_instruction_prefetch()'
     }
 
     uppers = (v for v in ul_pairs if v[0] == elem.get('name'))
@@ -125,6 +125,7 @@ def core_default_names(cpu):
     default_core = {
         'frequency' : 4000,
         'DIB': {},
+        'uop_cache': {},
     }
     return util.chain(cpu, default_element_names, default_core)
 
@@ -231,10 +232,10 @@ class NormalizedConfiguration:
         # Default core elements
         core_from_config = util.subdict(config_file,
             (
-                'frequency', 'ifetch_buffer_size', 'decode_buffer_size', 'dispatch_buffer_size', 'register_file_size', 'rob_size', 'lq_size',
-                'sq_size', 'fetch_width', 'decode_width', 'dispatch_width', 'execute_width', 'lq_width', 'sq_width',
-                'retire_width', 'mispredict_penalty', 'scheduler_size', 'decode_latency', 'dispatch_latency',
-                'schedule_latency', 'execute_latency', 'branch_predictor', 'btb', 'DIB'
+                'frequency', 'ifetch_buffer_size', 'ftq_size', 'wrong_path_fetch', 'lsd_size', 'decode_buffer_size', 'dispatch_buffer_size', 'register_file_size', 'rob_size', 'lq_size',
+                'sq_size', 'fetch_width', 'taken_branches_per_cycle', 'fetch_blocks_per_cycle', 'decode_width', 'dispatch_width', 'execute_width', 'lq_width', 'sq_width',
+                'retire_width', 'mispredict_penalty', 'branch_predictor_budget', 'slow_predictor_latency', 'scheduler_size', 'decode_latency', 'dispatch_latency',
+                'schedule_latency', 'execute_latency', 'branch_predictor', 'btb', 'DIB', 'uop_cache'
             )
         )
         self.cores = [util.chain(cpu, core_from_config, {'name': f'cpu{i}'}) for i,cpu in enumerate(self.cores)]
@@ -343,7 +344,7 @@ class NormalizedConfiguration:
         )
 
         # Give cores numeric indices and default cache names
-        cores = [{'_index': i, **core_default_names(cpu)} for i,cpu in enumerate(self.cores)]
+        cores = [{'_index': i, **core_default_names(cpu), **transform_for_keys(cpu, ('branch_predictor_budget',), int_or_prefixed_size)} for i,cpu in enumerate(self.cores)]
 
         path_root_names = tuple(tuple(cpu[name] for cpu in cores) for name in ('L1I', 'L1D', 'ITLB', 'DTLB'))
 
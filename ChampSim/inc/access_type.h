@@ -26,10 +26,11 @@ enum class access_type : unsigned {
   PREFETCH,
   WRITE,
   TRANSLATION,
+  IFETCH,
   NUM_TYPES,
 };
 
 using namespace std::literals::string_view_literals;
 inline constexpr std::array<std::string_view, static_cast<std::size_t>(access_type::NUM_TYPES)> access_type_names{"LOAD"sv, "RFO"sv, "PREFETCH"sv, "WRITE"sv,
-                                                                                                                  "TRANSLATION"};
+                                                                                                                  "TRANSLATION"sv, "IFETCH"sv};
 #endif
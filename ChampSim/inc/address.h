@@ -17,7 +17,7 @@
 /** \file */
 
 #ifdef CHAMPSIM_MODULE
-#define SET_ASIDE_CHAMPSIM_MODULE
+#define ADDRESS_H_SET_ASIDE_CHAMPSIM_MODULE
 #undef CHAMPSIM_MODULE
 #endif
 
@@ -668,7 +668,7 @@ struct fmt::formatter<champsim::address_slice<Extent>> {
 
 #endif
 
-#ifdef SET_ASIDE_CHAMPSIM_MODULE
-#undef SET_ASIDE_CHAMPSIM_MODULE
+#ifdef ADDRESS_H_SET_ASIDE_CHAMPSIM_MODULE
+#undef ADDRESS_H_SET_ASIDE_CHAMPSIM_MODULE
 #define CHAMPSIM_MODULE
 #endif
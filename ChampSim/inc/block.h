@@ -25,6 +25,8 @@ struct cache_block {
   bool valid = false;
   bool prefetch = false;
   bool dirty = false;
+  bool wrong_path = false;     // filled by a wrong-path fetch, and not yet used by the correct path
+  bool is_instruction = false; // filled or used by an instruction fetch
 
   champsim::address address{};
   champsim::address v_address{};
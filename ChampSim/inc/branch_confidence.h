@@ -0,0 +1,29 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BRANCH_CONFIDENCE_H
+#define BRANCH_CONFIDENCE_H
+
+namespace champsim
+{
+/**
+ * How likely a branch prediction is to be correct, as estimated by the branch predictor.
+ * Predictors that do not estimate their confidence are taken to be highly confident.
+ */
+enum class branch_confidence { low, medium, high };
+} // namespace champsim
+
+#endif
@@ -26,9 +26,11 @@
 #include <cstddef> // for size_t
 #include <cstdint> // for uint64_t, uint32_t, uint8_t
 #include <deque>
+#include <functional>
 #include <iterator> // for size
 #include <limits>   // for numeric_limits
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -37,6 +39,7 @@
 #include "address.h"
 #include "bandwidth.h"
 #include "block.h"
+#include "branch_confidence.h"
 #include "cache_builder.h"
 #include "cache_stats.h"
 #include "champsim.h"
@@ -71,6 +74,8 @@ class CACHE : public champsim::operable
     bool prefetch_from_this;
     bool skip_fill;
     bool is_translated;
+    bool wrong_path;
+    bool is_instruction;
     bool translate_issued = false;
 
     uint8_t asid[2] = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()};
@@ -100,6 +105,9 @@ public:
 
     access_type type;
     bool prefetch_from_this;
+    bool wrong_path;              // the miss was started by a wrong-path fetch
+    bool wrong_path_used = false; // the correct path merged into the miss
+    bool is_instruction;          // an instruction fetch started or merged into the miss
 
     uint8_t asid[2] = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()};
 
@@ -120,7 +128,8 @@ private:
   void finish_packet(const response_type& packet);
   void finish_translation(const response_type& packet);
 
-  void issue_translation(tag_lookup_type& q_entry) const;
+  void issue_translation(tag_lookup_type& q_entry);
+  void issue_translation_prefetch(champsim::address v_addr);
 
 public:
   using BLOCK = champsim::cache_block;
@@ -149,6 +158,14 @@ private:
   std::deque<tag_lookup_type> inflight_tag_check{};
   std::deque<tag_lookup_type> translation_stash{};
 
+  // Pages whose translation was requested ahead of the prefetches into them
+  struct translation_prefetch_type {
+    champsim::page_number v_page;
+    bool returned = false;
+  };
+  std::deque<translation_prefetch_type> translation_prefetches{};
+  std::optional<champsim::page_number> last_translated_page{};
+
 public:
   std::vector<channel_type*> upper_levels;
   channel_type* lower_level;
@@ -166,8 +183,14 @@ public:
   bool prefetch_as_load;
   bool match_offset_bits;
   bool virtual_prefetch;
+  bool translation_prefetch;
+  bool instruction_prefetch;
   std::vector<access_type> pref_activate_mask;
 
+  // Called with the virtual address of each block placed in this cache, and of each block that its own prefetches find already present.
+  // Front-end structures use this to predecode the blocks that pass through the instruction cache.
+  std::vector<std::function<void(champsim::address)>> fill_observers{};
+
   using stats_type = cache_stats;
 
   stats_type sim_stats, roi_stats;
@@ -233,7 +256,10 @@ public:
                                                 uint32_t metadata_in) = 0;
     virtual void impl_prefetcher_cycle_operate() = 0;
     virtual void impl_prefetcher_final_stats() = 0;
-    virtual void impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target) = 0;
+    virtual void impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target,
+                                                champsim::branch_confidence confidence) = 0;
+    virtual void impl_prefetcher_ftq_enqueue(champsim::address fetch_addr, bool wrong_path) = 0;
+    virtual void impl_prefetcher_retire(champsim::address ip) = 0;
   };
 
   struct replacement_module_concept {
@@ -245,9 +271,9 @@ public:
     virtual long impl_find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const BLOCK* current_set, champsim::address ip,
                                   champsim::address full_addr, access_type type) = 0;
     virtual void impl_update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
-                                               champsim::address victim_addr, access_type type, bool hit) = 0;
+                                               champsim::address victim_addr, access_type type, bool hit, bool is_instruction) = 0;
     virtual void impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
-                                             champsim::address victim_addr, access_type type) = 0;
+                                             champsim::address victim_addr, access_type type, bool is_instruction) = 0;
     virtual void impl_replacement_final_stats() = 0;
   };
 
@@ -267,7 +293,10 @@ public:
                                                       uint32_t metadata_in) final;
     void impl_prefetcher_cycle_operate() final;
     void impl_prefetcher_final_stats() final;
-    void impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target) final;
+    void impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target,
+                                        champsim::branch_confidence confidence) final;
+    void impl_prefetcher_ftq_enqueue(champsim::address fetch_addr, bool wrong_path) final;
+    void impl_prefetcher_retire(champsim::address ip) final;
   };
 
   template <typename... Rs>
@@ -286,15 +315,29 @@ public:
     [[nodiscard]] long impl_find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const BLOCK* current_set, champsim::address ip,
                                         champsim::address full_addr, access_type type) final;
     void impl_update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
-                                       champsim::address victim_addr, access_type type, bool hit) final;
+                                       champsim::address victim_addr, access_type type, bool hit, bool is_instruction) final;
     void impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
-                                     champsim::address victim_addr, access_type type) final;
+                                     champsim::address victim_addr, access_type type, bool is_instruction) final;
     void impl_replacement_final_stats() final;
   };
 
   std::unique_ptr<prefetcher_module_concept> pref_module_pimpl;
   std::unique_ptr<replacement_module_concept> repl_module_pimpl;
 
+  // Host time spent in the module hooks, when host profiling is enabled
+  struct hook_timer_type {
+    champsim::host_timer prefetcher_cache_operate{};
+    champsim::host_timer prefetcher_cache_fill{};
+    champsim::host_timer prefetcher_cycle_operate{};
+    champsim::host_timer prefetcher_branch_operate{};
+    champsim::host_timer prefetcher_ftq_enqueue{};
+    champsim::host_timer prefetcher_retire{};
+    champsim::host_timer find_victim{};
+    champsim::host_timer update_replacement_state{};
+    champsim::host_timer replacement_cache_fill{};
+  };
+  mutable hook_timer_type hook_timers{};
+
   // NOLINTBEGIN(readability-make-member-function-const): legacy modules use non-const hooks
   void impl_prefetcher_initialize() const;
   [[nodiscard]] uint32_t impl_prefetcher_cache_operate(champsim::address addr, champsim::address ip, bool cache_hit, bool useful_prefetch, access_type type,
@@ -303,15 +346,18 @@ public:
                                                     uint32_t metadata_in) const;
   void impl_prefetcher_cycle_operate() const;
   void impl_prefetcher_final_stats() const;
-  void impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target) const;
+  void impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target,
+                                      champsim::branch_confidence confidence = champsim::branch_confidence::high) const;
+  void impl_prefetcher_ftq_enqueue(champsim::address fetch_addr, bool wrong_path) const;
+  void impl_prefetcher_retire(champsim::address ip) const;
 
   void impl_initialize_replacement() const;
   [[nodiscard]] long impl_find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const BLOCK* current_set, champsim::address ip,
                                       champsim::address full_addr, access_type type) const;
   void impl_update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
-                                     champsim::address victim_addr, access_type type, bool hit) const;
+                                     champsim::address victim_addr, access_type type, bool hit, bool is_instruction = false) const;
   void impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
-                                   champsim::address victim_addr, access_type type) const;
+                                   champsim::address victim_addr, access_type type, bool is_instruction = false) const;
   void impl_replacement_final_stats() const;
   // NOLINTEND(readability-make-member-function-const)
 
@@ -320,7 +366,8 @@ public:
       : champsim::operable(b.m_clock_period), upper_levels(b.m_uls), lower_level(b.m_ll), lower_translate(b.m_lt), NAME(b.m_name), NUM_SET(b.get_num_sets()),
         NUM_WAY(b.get_num_ways()), MSHR_SIZE(b.get_num_mshrs()), PQ_SIZE(b.m_pq_size), HIT_LATENCY(b.get_hit_latency() * b.m_clock_period),
         FILL_LATENCY(b.get_fill_latency() * b.m_clock_period), OFFSET_BITS(b.m_offset_bits), MAX_TAG(b.get_tag_bandwidth()), MAX_FILL(b.get_fill_bandwidth()),
-        prefetch_as_load(b.m_pref_load), match_offset_bits(b.m_wq_full_addr), virtual_prefetch(b.m_va_pref), pref_activate_mask(b.m_pref_act_mask),
+        prefetch_as_load(b.m_pref_load), match_offset_bits(b.m_wq_full_addr), virtual_prefetch(b.m_va_pref), translation_prefetch(b.m_translation_pref), instruction_prefetch(b.m_instr_pref),
+        pref_activate_mask(b.m_pref_act_mask),
         pref_module_pimpl(std::make_unique<prefetcher_module_model<Ps...>>(this)), repl_module_pimpl(std::make_unique<replacement_module_model<Rs...>>(this))
   {
   }
@@ -410,11 +457,14 @@ void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_final_stats()
 }
 
 template <typename... Ps>
-void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target)
+void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target,
+                                                                         champsim::branch_confidence confidence)
 {
   [[maybe_unused]] auto process_one = [&](auto& p) {
     using namespace champsim::modules;
-    if constexpr (prefetcher::has_branch_operate<decltype(p), champsim::address, uint8_t, champsim::address>)
+    if constexpr (prefetcher::has_branch_operate<decltype(p), champsim::address, uint8_t, champsim::address, champsim::branch_confidence>)
+      p.prefetcher_branch_operate(ip, branch_type, branch_target, confidence);
+    else if constexpr (prefetcher::has_branch_operate<decltype(p), champsim::address, uint8_t, champsim::address>)
       p.prefetcher_branch_operate(ip, branch_type, branch_target);
     if constexpr (prefetcher::has_branch_operate<decltype(p), uint64_t, uint8_t, uint64_t>)
       p.prefetcher_branch_operate(ip.to<uint64_t>(), branch_type, branch_target.to<uint64_t>());
@@ -423,6 +473,38 @@ void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_branch_operate(champ
   std::apply([&](auto&... p) { (..., process_one(p)); }, intern_);
 }
 
+template <typename... Ps>
+void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_ftq_enqueue(champsim::address fetch_addr, bool wrong_path)
+{
+  [[maybe_unused]] auto process_one = [&](auto& p) {
+    using namespace champsim::modules;
+    if constexpr (prefetcher::has_ftq_enqueue<decltype(p), champsim::address, bool>)
+      p.prefetcher_ftq_enqueue(fetch_addr, wrong_path);
+    if constexpr (prefetcher::has_ftq_enqueue<decltype(p), uint64_t, bool>)
+      p.prefetcher_ftq_enqueue(fetch_addr.to<uint64_t>(), wrong_path);
+    if constexpr (prefetcher::has_ftq_enqueue<decltype(p), champsim::address>)
+      p.prefetcher_ftq_enqueue(fetch_addr);
+    if constexpr (prefetcher::has_ftq_enqueue<decltype(p), uint64_t>)
+      p.prefetcher_ftq_enqueue(fetch_addr.to<uint64_t>());
+  };
+
+  std::apply([&](auto&... p) { (..., process_one(p)); }, intern_);
+}
+
+template <typename... Ps>
+void CACHE::prefetcher_module_model<Ps...>::impl_prefetcher_retire(champsim::address ip)
+{
+  [[maybe_unused]] auto process_one = [&](auto& p) {
+    using namespace champsim::modules;
+    if constexpr (prefetcher::has_retire<decltype(p), champsim::address>)
+      p.prefetcher_retire(ip);
+    if constexpr (prefetcher::has_retire<decltype(p), uint64_t>)
+      p.prefetcher_retire(ip.to<uint64_t>());
+  };
+
+  std::apply([&](auto&... p) { (..., process_one(p)); }, intern_);
+}
+
 template <typename... Rs>
 void CACHE::replacement_module_model<Rs...>::impl_initialize_replacement()
 {
@@ -467,16 +549,23 @@ long CACHE::replacement_module_model<Rs...>::impl_find_victim(uint32_t triggerin
 
 template <typename... Rs>
 void CACHE::replacement_module_model<Rs...>::impl_update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr,
-                                                                           champsim::address ip, champsim::address victim_addr, access_type type, bool hit)
+                                                                           champsim::address ip, champsim::address victim_addr, access_type type, bool hit,
+                                                                           bool is_instruction)
 {
   [[maybe_unused]] auto process_one = [&](auto& r) {
     using namespace champsim::modules;
 
-    if (hit || replacement::has_cache_fill<decltype(r), uint32_t, long, long, champsim::address, champsim::address, champsim::address, access_type>) {
+    if (hit || replacement::has_cache_fill<decltype(r), uint32_t, long, long, champsim::address, champsim::address, champsim::address, access_type>
+        || replacement::has_cache_fill<decltype(r), uint32_t, long, long, champsim::address, champsim::address, champsim::address, access_type, bool>) {
       auto new_victim_addr = hit ? champsim::address{} : victim_addr;
 
+      /* Strong addresses, told whether the access fetches instructions */
+      if constexpr (replacement::has_update_state<decltype(r), uint32_t, long, long, champsim::address, champsim::address, champsim::address, access_type,
+                                                  bool, bool>)
+        r.update_replacement_state(triggering_cpu, set, way, full_addr, ip, new_victim_addr, type, hit, is_instruction);
+
       /* Strong addresses */
-      if constexpr (replacement::has_update_state<decltype(r), uint32_t, long, long, champsim::address, champsim::address, access_type, bool>)
+      else if constexpr (replacement::has_update_state<decltype(r), uint32_t, long, long, champsim::address, champsim::address, access_type, bool>)
         r.update_replacement_state(triggering_cpu, set, way, full_addr, ip, type, hit);
 
       /* Strong addresses */
@@ -502,17 +591,22 @@ void CACHE::replacement_module_model<Rs...>::impl_update_replacement_state(uint3
 
 template <typename... Rs>
 void CACHE::replacement_module_model<Rs...>::impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr,
-                                                                         champsim::address ip, champsim::address victim_addr, access_type type)
+                                                                         champsim::address ip, champsim::address victim_addr, access_type type,
+                                                                         bool is_instruction)
 {
   [[maybe_unused]] auto process_one = [&](auto& r) {
     using namespace champsim::modules;
 
+    /* Strong addresses, told whether the fill was fetched by an instruction fetch */
+    if constexpr (replacement::has_cache_fill<decltype(r), uint32_t, long, long, champsim::address, champsim::address, champsim::address, access_type, bool>)
+      r.replacement_cache_fill(triggering_cpu, set, way, full_addr, ip, victim_addr, type, is_instruction);
+
     /* Strong addresses */
-    if constexpr (replacement::has_cache_fill<decltype(r), uint32_t, long, long, champsim::address, champsim::address, champsim::address, access_type>)
+    else if constexpr (replacement::has_cache_fill<decltype(r), uint32_t, long, long, champsim::address, champsim::address, champsim::address, access_type>)
       r.replacement_cache_fill(triggering_cpu, set, way, full_addr, ip, victim_addr, type);
 
     else
-      impl_update_replacement_state(triggering_cpu, set, way, full_addr, ip, victim_addr, type, false);
+      impl_update_replacement_state(triggering_cpu, set, way, full_addr, ip, victim_addr, type, false, is_instruction);
   };
 
   std::apply([&](auto&... r) { (..., process_one(r)); }, intern_);
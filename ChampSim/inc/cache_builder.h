@@ -57,8 +57,10 @@ struct cache_builder_base {
   bool m_pref_load{};
   bool m_wq_full_addr{};
   bool m_va_pref{};
+  bool m_translation_pref{};
+  bool m_instr_pref{};
 
-  std::vector<access_type> m_pref_act_mask{access_type::LOAD, access_type::PREFETCH};
+  std::vector<access_type> m_pref_act_mask{access_type::LOAD, access_type::IFETCH, access_type::PREFETCH};
   std::vector<champsim::channel*> m_uls{};
   champsim::channel* m_ll{};
   champsim::channel* m_lt{nullptr};
@@ -212,6 +214,27 @@ public:
    */
   self_type& reset_virtual_prefetch();
 
+  /**
+   * Specify that prefetches into a new virtual page should request their translation from the lower translation level as soon as they are issued.
+   * This has no effect unless prefetchers operate in the virtual address space.
+   */
+  self_type& set_translation_prefetch();
+
+  /**
+   * Specify that prefetches should request their translation only when they reach the tag check.
+   */
+  self_type& reset_translation_prefetch();
+
+  /**
+   * Specify that the prefetches issued by this cache fetch instructions, so that lower levels treat them as code.
+   */
+  self_type& set_instruction_prefetch();
+
+  /**
+   * Specify that the prefetches issued by this cache fetch data.
+   */
+  self_type& reset_instruction_prefetch();
+
   /**
    * Specify the ``access_type`` values that should activate the prefetcher.
    */
@@ -485,6 +508,34 @@ auto champsim::cache_builder<P, R>::reset_virtual_prefetch() -> self_type&
   return *this;
 }
 
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::set_translation_prefetch() -> self_type&
+{
+  m_translation_pref = true;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::reset_translation_prefetch() -> self_type&
+{
+  m_translation_pref = false;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::set_instruction_prefetch() -> self_type&
+{
+  m_instr_pref = true;
+  return *this;
+}
+
+template <typename P, typename R>
+auto champsim::cache_builder<P, R>::reset_instruction_prefetch() -> self_type&
+{
+  m_instr_pref = false;
+  return *this;
+}
+
 template <typename P, typename R>
 template <typename... Elems>
 auto champsim::cache_builder<P, R>::prefetch_activate(Elems... pref_act_elems) -> self_type&
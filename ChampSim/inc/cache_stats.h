@@ -8,6 +8,7 @@
 
 #include "channel.h"
 #include "event_counter.h"
+#include "hotspot_counter.h"
 
 struct cache_stats {
   std::string name;
@@ -18,12 +19,23 @@ struct cache_stats {
   uint64_t pf_useless = 0;
   uint64_t pf_fill = 0;
 
+  uint64_t translation_pf_issued = 0;
+  uint64_t translation_pf_useful = 0;
+
+  uint64_t wrong_path_fill = 0;
+  uint64_t wrong_path_useful = 0;
+
   champsim::stats::event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>> hits = {};
   champsim::stats::event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>> misses = {};
   champsim::stats::event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>> mshr_merge = {};
   champsim::stats::event_counter<std::pair<access_type, std::remove_cv_t<decltype(NUM_CPUS)>>> mshr_return = {};
 
   long total_miss_latency_cycles{};
+
+  // The code and data responsible for the most demand misses, by CPU and virtual address, if hotspots are reported
+  champsim::stats::hotspot_counter<std::pair<uint32_t, uint64_t>> miss_block_hotspots = {};     // by block
+  champsim::stats::hotspot_counter<std::pair<uint32_t, uint64_t>> miss_ip_hotspots = {};        // by instruction pointer
+  champsim::stats::hotspot_counter<std::pair<uint32_t, uint64_t>> late_prefetch_hotspots = {}; // by block, for demands that merged with a prefetch
 };
 
 cache_stats operator-(cache_stats lhs, cache_stats rhs);
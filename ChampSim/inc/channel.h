@@ -53,6 +53,8 @@ class channel
     bool forward_checked = false;
     bool is_translated = true;
     bool response_requested = true;
+    bool wrong_path = false;
+    bool is_instruction = false; // code rather than data: a fetch, whose type is IFETCH, or an instruction prefetch
 
     uint8_t asid[2] = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()};
     access_type type{access_type::LOAD};
@@ -0,0 +1,138 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CODE_LAYOUT_H
+#define CODE_LAYOUT_H
+
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "instruction.h"
+
+namespace champsim
+{
+/**
+ * A relayout of the code, as a map from ranges of original instruction addresses to the addresses where the ranges are moved.
+ * Addresses outside of every range keep their place.
+ *
+ * The layout file has one range per line, as the hexadecimal first address, the hexadecimal address past the end, and the hexadecimal new first address.
+ * Everything after a '#' is a comment.
+ */
+class code_layout
+{
+public:
+  struct range_type {
+    uint64_t begin;
+    uint64_t end;
+    uint64_t new_begin;
+  };
+
+private:
+  std::map<uint64_t, range_type> ranges{};     // by original first address
+  std::map<uint64_t, uint64_t> new_extents{}; // the first and past-the-end addresses of each moved range
+
+public:
+  /**
+   * Move the original addresses [begin, end) to begin at new_begin.
+   *
+   * \throws std::invalid_argument if the range is empty, or if it overlaps another range before or after it is moved
+   */
+  void add(uint64_t begin, uint64_t end, uint64_t new_begin);
+
+  /**
+   * The address in the new layout of an original address
+   */
+  [[nodiscard]] uint64_t remap(uint64_t addr) const;
+
+  [[nodiscard]] bool empty() const { return std::empty(ranges); }
+  [[nodiscard]] std::size_t size() const { return std::size(ranges); }
+
+  /**
+   * All ranges, ordered by their original first address
+   */
+  [[nodiscard]] std::vector<range_type> layout() const;
+};
+
+/**
+ * Read a layout file
+ *
+ * \throws std::invalid_argument if a line is not a range, or if the ranges overlap
+ */
+code_layout read_code_layout(std::istream& in);
+
+/**
+ * Write a layout file that read_code_layout() reads back
+ */
+void write_code_layout(std::ostream& out, const code_layout& layout);
+
+/**
+ * The parameters of the profile-guided layout
+ */
+struct code_layout_parameters {
+  uint64_t base = 0;                // the first address of the new layout, or 0 to begin at the first address of the original code
+  uint64_t alignment = 16;          // bytes, of each chunk of code in the new layout
+  uint64_t max_cluster_size = 4096; // bytes of code that are placed together along the hottest calls and jumps
+  double cold_fraction = 0.0001;    // chunks that execute less than this fraction of the instructions are moved after all others
+};
+
+/**
+ * Parse a list of comma-separated key=value pairs, where the keys are the member names of code_layout_parameters.
+ *
+ * \throws std::invalid_argument if a key is not known or a value cannot be parsed
+ */
+code_layout_parameters parse_code_layout_parameters(std::string_view spec);
+
+/**
+ * A profiling pass over an instruction stream that derives a code layout in the manner of the call-chain clustering of HFSort.
+ *
+ * The executed code is cut into chunks wherever code that never executes lies between two instructions, so that the hot paths of a function
+ * are split from its cold paths. In order of hotness, each chunk joins the end of the cluster of the chunk that calls or jumps to it most
+ * often, up to a size limit. The clusters are placed in order of their density of executed instructions, and the cold chunks follow in their
+ * original order.
+ */
+class code_layout_profiler
+{
+  constexpr static uint64_t max_instruction_size = 16; // bytes, rounded up from the longest x86 instruction
+
+  code_layout_parameters params;
+
+  std::map<uint64_t, uint64_t> executions{};                     // by instruction pointer
+  std::map<std::pair<uint64_t, uint64_t>, uint64_t> transfers{}; // taken calls and jumps, by (branch, target)
+  std::optional<uint64_t> last_transfer{};                       // the branch before this instruction, if it was taken
+  uint64_t num_instructions = 0;
+
+public:
+  explicit code_layout_profiler(code_layout_parameters p);
+
+  /**
+   * Profile the next instruction of the stream
+   */
+  void operator()(const ooo_model_instr& instr);
+
+  /**
+   * The layout of the code profiled so far
+   */
+  [[nodiscard]] code_layout layout() const;
+};
+} // namespace champsim
+
+#endif
@@ -0,0 +1,145 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CODE_PREFETCH_HINTS_H
+#define CODE_PREFETCH_HINTS_H
+
+#include <cstdint>
+#include <deque>
+#include <istream>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "trace_instruction.h"
+
+namespace champsim
+{
+/**
+ * Software code prefetches, in the style of AsmDB, as a table from the instruction pointers where the prefetches are inserted to the
+ * blocks they prefetch.
+ *
+ * The hint file has one hint per line, as the hexadecimal trigger IP followed by the hexadecimal target address. Everything after a '#' is a comment.
+ */
+class code_prefetch_hints
+{
+  std::unordered_map<uint64_t, std::vector<uint64_t>> table;
+  std::size_t num_hints = 0;
+
+public:
+  /**
+   * Insert a prefetch of the target when execution reaches the trigger
+   */
+  void add(uint64_t trigger_ip, uint64_t target);
+
+  /**
+   * The targets to prefetch when execution reaches the given instruction pointer, which are empty if it is not a trigger
+   */
+  [[nodiscard]] const std::vector<uint64_t>& targets(uint64_t ip) const;
+
+  [[nodiscard]] bool empty() const { return num_hints == 0; }
+  [[nodiscard]] std::size_t size() const { return num_hints; }
+
+  /**
+   * All hints, ordered by trigger
+   */
+  [[nodiscard]] std::vector<std::pair<uint64_t, uint64_t>> hints() const;
+};
+
+/**
+ * Read a hint file
+ *
+ * \throws std::invalid_argument if a line is not a pair of addresses
+ */
+code_prefetch_hints read_code_prefetch_hints(std::istream& in);
+
+/**
+ * Write a hint file that read_code_prefetch_hints() reads back
+ */
+void write_code_prefetch_hints(std::ostream& out, const code_prefetch_hints& hints);
+
+/**
+ * The parameters of the offline analysis that chooses code prefetch hints
+ */
+struct code_prefetch_analysis_parameters {
+  uint64_t block_size = 64; // bytes
+  std::size_t sets = 64;    // of the modeled L1I
+  std::size_t ways = 8;     // of the modeled L1I
+
+  std::size_t distance = 64; // instructions between a prefetch and the miss it covers
+  uint64_t min_misses = 2;   // the fewest misses a hint must cover
+  double min_accuracy = 0.5; // the smallest fraction of the trigger's executions that must be followed by the miss
+};
+
+/**
+ * Parse a list of comma-separated key=value pairs, where the keys are the member names of code_prefetch_analysis_parameters.
+ *
+ * \throws std::invalid_argument if a key is not known or a value cannot be parsed
+ */
+code_prefetch_analysis_parameters parse_code_prefetch_analysis_parameters(std::string_view spec);
+
+/**
+ * An offline analysis of an instruction stream that finds the fetch blocks that miss in an LRU model of the L1I, and chooses for each miss the
+ * instruction the configured distance earlier in the dynamic stream as the place to prefetch it.
+ *
+ * A candidate becomes a hint if it covers enough misses and if the miss follows enough of the trigger's executions, so that hints are not placed
+ * on paths that rarely lead to the miss.
+ */
+class code_prefetch_analyzer
+{
+  code_prefetch_analysis_parameters params;
+
+  std::vector<std::vector<uint64_t>> l1i; // block numbers of each set, most recently used first
+  std::deque<uint64_t> history{};         // the most recent instruction pointers, oldest first
+  std::optional<uint64_t> last_block{};
+
+  std::unordered_map<uint64_t, uint64_t> executions{};
+  std::map<std::pair<uint64_t, uint64_t>, uint64_t> candidates{}; // misses by (trigger, block)
+  uint64_t num_instructions = 0;
+  uint64_t num_misses = 0;
+
+  bool access(uint64_t block);
+  [[nodiscard]] bool is_chosen(const decltype(candidates)::value_type& candidate) const;
+
+public:
+  struct stats_type {
+    uint64_t instructions = 0;
+    uint64_t misses = 0;
+    uint64_t covered_misses = 0; // by the chosen hints
+  };
+
+  explicit code_prefetch_analyzer(code_prefetch_analysis_parameters p);
+
+  /**
+   * Analyze the next instruction of the stream
+   */
+  void operator()(const input_instr& instr);
+  void operator()(uint64_t ip);
+
+  /**
+   * The hints chosen from the stream so far
+   */
+  [[nodiscard]] code_prefetch_hints hints() const;
+
+  [[nodiscard]] stats_type stats() const;
+};
+} // namespace champsim
+
+#endif
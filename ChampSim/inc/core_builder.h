@@ -39,11 +39,21 @@ struct core_builder_base {
   std::size_t m_dib_set{1};
   std::size_t m_dib_way{1};
   std::size_t m_dib_window{1};
+  std::size_t m_uop_cache_set{0};
+  std::size_t m_uop_cache_way{8};
+  std::size_t m_uop_cache_window{32};
+  std::size_t m_uop_cache_uops_per_line{6};
+  std::size_t m_uop_cache_lines_per_window{3};
+  bool m_uop_cache_partial_windows{false};
+  unsigned m_uop_cache_switch_penalty{1};
   std::size_t m_ifetch_buffer_size{1};
   std::size_t m_decode_buffer_size{1};
   std::size_t m_dispatch_buffer_size{1};
 
   std::size_t m_dib_hit_buffer_size{1};
+  std::size_t m_ftq_size{1};
+  bool m_wrong_path_fetch{false};
+  std::size_t m_lsd_size{0};
 
   std::size_t m_register_file_size{1};
   std::size_t m_rob_size{1};
@@ -58,11 +68,15 @@ struct core_builder_base {
   champsim::bandwidth::maximum_type m_lq_width{1};
   champsim::bandwidth::maximum_type m_sq_width{1};
   champsim::bandwidth::maximum_type m_retire_width{1};
+  champsim::bandwidth::maximum_type m_taken_branches_per_cycle{1};
+  champsim::bandwidth::maximum_type m_fetch_blocks_per_cycle{std::numeric_limits<long>::max()};
   champsim::bandwidth::maximum_type m_dib_inorder_width{1};
 
   unsigned m_dib_hit_latency{};
 
   unsigned m_mispredict_penalty{};
+  std::size_t m_branch_predictor_budget{0};
+  unsigned m_slow_predictor_latency{0};
   unsigned m_decode_latency{};
   unsigned m_dispatch_latency{};
   unsigned m_schedule_latency{};
@@ -113,6 +127,42 @@ public:
    */
   self_type& dib_window(std::size_t dib_window_);
 
+  /**
+   * Specify the number of sets in the micro-op cache. A nonzero number of sets replaces the Decoded Instruction Buffer with a micro-op cache.
+   */
+  self_type& uop_cache_set(std::size_t uop_cache_set_);
+
+  /**
+   * Specify the number of lines in each set of the micro-op cache.
+   */
+  self_type& uop_cache_way(std::size_t uop_cache_way_);
+
+  /**
+   * Specify the size of the aligned code window whose micro-ops share the lines of the micro-op cache.
+   */
+  self_type& uop_cache_window(std::size_t uop_cache_window_);
+
+  /**
+   * Specify the number of micro-ops held by each line of the micro-op cache.
+   */
+  self_type& uop_cache_uops_per_line(std::size_t uop_cache_uops_per_line_);
+
+  /**
+   * Specify the most lines of the micro-op cache that one code window may occupy.
+   */
+  self_type& uop_cache_lines_per_window(std::size_t uop_cache_lines_per_window_);
+
+  /**
+   * Specify whether a code window that does not fit in the micro-op cache keeps the micro-ops that do. Otherwise, the window is evicted when it
+   * overflows.
+   */
+  self_type& uop_cache_partial_windows(bool uop_cache_partial_windows_);
+
+  /**
+   * Specify the cycles lost each time fetch switches between the micro-op cache and the decoders.
+   */
+  self_type& uop_cache_switch_penalty(unsigned uop_cache_switch_penalty_);
+
   /**
    * Specify the maximum size of the instruction fetch buffer.
    */
@@ -133,6 +183,23 @@ public:
    */
   self_type& dib_hit_buffer_size(std::size_t dib_hit_buffer_size_);
 
+  /**
+   * Specify the maximum number of fetch blocks in the fetch target queue, which limits how far branch prediction may run ahead of fetch.
+   */
+  self_type& ftq_size(std::size_t ftq_size_);
+
+  /**
+   * Specify whether the front end continues to fetch down the predicted path after a branch misprediction, until the branch resolves.
+   * The wrong path is reconstructed from the branches seen so far in the trace.
+   */
+  self_type& wrong_path_fetch(bool wrong_path_fetch_);
+
+  /**
+   * Specify the size of the loop stream detector, in instructions. A loop whose body fits is replayed without accessing the L1I, the DIB, or the
+   * decoders, until it exits. A size of zero disables the loop stream detector.
+   */
+  self_type& lsd_size(std::size_t lsd_size_);
+
   /**
    * Specify the maximum size of the physical register file.
    */
@@ -158,6 +225,16 @@ public:
    */
   self_type& fetch_width(champsim::bandwidth::maximum_type fetch_width_);
 
+  /**
+   * Specify the number of correctly predicted taken branches that the branch prediction unit and fetch may follow in one cycle.
+   */
+  self_type& taken_branches_per_cycle(champsim::bandwidth::maximum_type taken_branches_per_cycle_);
+
+  /**
+   * Specify the number of fetch blocks that may move from the fetch target queue into the instruction fetch buffer in one cycle.
+   */
+  self_type& fetch_blocks_per_cycle(champsim::bandwidth::maximum_type fetch_blocks_per_cycle_);
+
   /**
    * Specify the width of the decode.
    */
@@ -205,6 +282,18 @@ public:
    */
   self_type& mispredict_penalty(unsigned mispredict_penalty_);
 
+  /**
+   * Specify the storage budget of the branch predictor, in bytes. Predictors that support a budget size their tables to fit in it. A budget of
+   * zero leaves the size to the predictor.
+   */
+  self_type& branch_predictor_budget(std::size_t branch_predictor_budget_);
+
+  /**
+   * Specify the latency of the slow branch predictor, in cycles. If this is nonzero, the first of the branch predictors gives a prediction at once,
+   * and the last overrides it after this many cycles. When the two disagree, the branch prediction unit is redirected after the same delay.
+   */
+  self_type& slow_predictor_latency(unsigned slow_predictor_latency_);
+
   /**
    * Specify the latency of the decode.
    */
@@ -304,6 +393,55 @@ auto champsim::core_builder<B, T>::dib_window(std::size_t dib_window_) -> self_t
   return *this;
 }
 
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::uop_cache_set(std::size_t uop_cache_set_) -> self_type&
+{
+  m_uop_cache_set = uop_cache_set_;
+  return *this;
+}
+
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::uop_cache_way(std::size_t uop_cache_way_) -> self_type&
+{
+  m_uop_cache_way = uop_cache_way_;
+  return *this;
+}
+
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::uop_cache_window(std::size_t uop_cache_window_) -> self_type&
+{
+  m_uop_cache_window = uop_cache_window_;
+  return *this;
+}
+
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::uop_cache_uops_per_line(std::size_t uop_cache_uops_per_line_) -> self_type&
+{
+  m_uop_cache_uops_per_line = uop_cache_uops_per_line_;
+  return *this;
+}
+
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::uop_cache_lines_per_window(std::size_t uop_cache_lines_per_window_) -> self_type&
+{
+  m_uop_cache_lines_per_window = uop_cache_lines_per_window_;
+  return *this;
+}
+
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::uop_cache_partial_windows(bool uop_cache_partial_windows_) -> self_type&
+{
+  m_uop_cache_partial_windows = uop_cache_partial_windows_;
+  return *this;
+}
+
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::uop_cache_switch_penalty(unsigned uop_cache_switch_penalty_) -> self_type&
+{
+  m_uop_cache_switch_penalty = uop_cache_switch_penalty_;
+  return *this;
+}
+
 template <typename B, typename T>
 auto champsim::core_builder<B, T>::ifetch_buffer_size(std::size_t ifetch_buffer_size_) -> self_type&
 {
@@ -346,6 +484,27 @@ auto champsim::core_builder<B, T>::dib_hit_buffer_size(std::size_t dib_hit_buffe
   return *this;
 }
 
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::ftq_size(std::size_t ftq_size_) -> self_type&
+{
+  m_ftq_size = ftq_size_;
+  return *this;
+}
+
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::wrong_path_fetch(bool wrong_path_fetch_) -> self_type&
+{
+  m_wrong_path_fetch = wrong_path_fetch_;
+  return *this;
+}
+
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::lsd_size(std::size_t lsd_size_) -> self_type&
+{
+  m_lsd_size = lsd_size_;
+  return *this;
+}
+
 template <typename B, typename T>
 auto champsim::core_builder<B, T>::lq_size(std::size_t lq_size_) -> self_type&
 {
@@ -367,6 +526,20 @@ auto champsim::core_builder<B, T>::fetch_width(champsim::bandwidth::maximum_type
   return *this;
 }
 
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::taken_branches_per_cycle(champsim::bandwidth::maximum_type taken_branches_per_cycle_) -> self_type&
+{
+  m_taken_branches_per_cycle = taken_branches_per_cycle_;
+  return *this;
+}
+
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::fetch_blocks_per_cycle(champsim::bandwidth::maximum_type fetch_blocks_per_cycle_) -> self_type&
+{
+  m_fetch_blocks_per_cycle = fetch_blocks_per_cycle_;
+  return *this;
+}
+
 template <typename B, typename T>
 auto champsim::core_builder<B, T>::decode_width(champsim::bandwidth::maximum_type decode_width_) -> self_type&
 {
@@ -430,6 +603,20 @@ auto champsim::core_builder<B, T>::mispredict_penalty(unsigned mispredict_penalt
   return *this;
 }
 
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::branch_predictor_budget(std::size_t branch_predictor_budget_) -> self_type&
+{
+  m_branch_predictor_budget = branch_predictor_budget_;
+  return *this;
+}
+
+template <typename B, typename T>
+auto champsim::core_builder<B, T>::slow_predictor_latency(unsigned slow_predictor_latency_) -> self_type&
+{
+  m_slow_predictor_latency = slow_predictor_latency_;
+  return *this;
+}
+
 template <typename B, typename T>
 auto champsim::core_builder<B, T>::decode_latency(unsigned decode_latency_) -> self_type&
 {
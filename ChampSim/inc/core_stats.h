@@ -5,6 +5,7 @@
 #include <string>
 
 #include "event_counter.h"
+#include "hotspot_counter.h"
 #include "instruction.h"
 
 struct cpu_stats {
@@ -18,6 +19,34 @@ struct cpu_stats {
   champsim::stats::event_counter<branch_type> total_branch_types = {};
   champsim::stats::event_counter<branch_type> branch_type_misses = {};
 
+  // by BTB level, if the BTB reports its levels. They are printed only for a BTB of several levels.
+  std::size_t btb_levels = 0;
+  champsim::stats::event_counter<std::size_t> btb_level_hits = {};
+  champsim::stats::event_counter<std::size_t> btb_level_misses = {};
+  uint64_t btb_redirect_bubbles = 0; // cycles
+
+  // a slow branch predictor that overrides a fast one
+  uint64_t predictor_overrides = 0;
+  uint64_t predictor_override_bubbles = 0; // cycles
+
+  // loop stream detector
+  uint64_t lsd_locks = 0;
+  uint64_t lsd_hits = 0; // instructions replayed
+  uint64_t lsd_l1i_accesses_avoided = 0;
+
+  // micro-op cache, if the core has one instead of a DIB
+  uint64_t uop_cache_hits = 0;
+  uint64_t uop_cache_misses = 0;
+  uint64_t uop_cache_switches = 0; // between the micro-op cache and the decoders
+
+  // software code prefetches
+  uint64_t prefetch_hints_issued = 0;
+  uint64_t prefetch_hints_dropped = 0; // the L1I prefetch queue was full
+
+  // the branches responsible for the most mispredicts and BTB misses, if hotspots are reported
+  champsim::stats::hotspot_counter<std::pair<uint64_t, branch_type>> mispredict_hotspots = {}; // by branch IP and type
+  champsim::stats::hotspot_counter<uint64_t> btb_miss_hotspots = {};                          // by branch IP, for taken branches
+
   [[nodiscard]] auto instrs() const { return end_instrs - begin_instrs; }
   [[nodiscard]] auto cycles() const { return end_cycles - begin_cycles; }
 };
@@ -36,6 +36,7 @@ const auto default_core =
         .decode_buffer_size(32)
         .dispatch_buffer_size(32)
         .dib_hit_buffer_size(32) // assumed
+        .ftq_size(24)            // assumed
         .register_file_size(128)
         .rob_size(352)
         .lq_size(128)
@@ -65,8 +66,9 @@ const auto default_l1i = champsim::cache_builder<champsim::cache_builder_module_
                              .offset_bits(champsim::data::bits{LOG2_BLOCK_SIZE})
                              .reset_prefetch_as_load()
                              .set_virtual_prefetch()
+                             .set_instruction_prefetch()
                              .set_wq_checks_full_addr()
-                             .prefetch_activate(access_type::LOAD, access_type::PREFETCH);
+                             .prefetch_activate(access_type::LOAD, access_type::IFETCH, access_type::PREFETCH);
 
 const auto default_l1d = champsim::cache_builder<champsim::cache_builder_module_type_holder<no>, champsim::cache_builder_module_type_holder<lru>>{}
                              .sets_factor(64)
@@ -86,7 +88,7 @@ const auto default_l2c = champsim::cache_builder<champsim::cache_builder_module_
                              .reset_prefetch_as_load()
                              .reset_virtual_prefetch()
                              .reset_wq_checks_full_addr()
-                             .prefetch_activate(access_type::LOAD, access_type::PREFETCH);
+                             .prefetch_activate(access_type::LOAD, access_type::IFETCH, access_type::PREFETCH);
 
 const auto default_itlb = champsim::cache_builder<champsim::cache_builder_module_type_holder<no>, champsim::cache_builder_module_type_holder<lru>>{}
                               .sets_factor(16)
@@ -128,7 +130,7 @@ const auto default_llc = champsim::cache_builder<champsim::cache_builder_module_
                              .reset_prefetch_as_load()
                              .reset_virtual_prefetch()
                              .reset_wq_checks_full_addr()
-                             .prefetch_activate(access_type::LOAD, access_type::PREFETCH);
+                             .prefetch_activate(access_type::LOAD, access_type::IFETCH, access_type::PREFETCH);
 
 const auto default_ptw = champsim::ptw_builder{}.bandwidth_factor(2).mshr_factor(5).add_pscl(5, 1, 2).add_pscl(4, 1, 4).add_pscl(3, 2, 4).add_pscl(2, 4, 8);
 } // namespace champsim::defaults
@@ -99,6 +99,8 @@ struct DRAM_CHANNEL final : public champsim::operable {
     bool scheduled = false;
     bool forward_checked = false;
 
+    access_type type{access_type::LOAD};
+
     uint8_t asid[2] = {std::numeric_limits<uint8_t>::max(), std::numeric_limits<uint8_t>::max()};
 
     uint32_t pf_metadata = 0;
@@ -4,12 +4,19 @@
 #include <cstdint>
 #include <string>
 
+#include "access_type.h"
+#include "event_counter.h"
+
 struct dram_stats {
   std::string name{};
   long dbus_cycle_congested{};
   uint64_t dbus_count_congested = 0;
   uint64_t refresh_cycles = 0;
   unsigned WQ_ROW_BUFFER_HIT = 0, WQ_ROW_BUFFER_MISS = 0, RQ_ROW_BUFFER_HIT = 0, RQ_ROW_BUFFER_MISS = 0, WQ_FULL = 0;
+
+  // The reads counted above, by the access type of the request that missed in the LLC
+  champsim::stats::event_counter<access_type> RQ_ROW_BUFFER_HIT_BY_TYPE = {};
+  champsim::stats::event_counter<access_type> RQ_ROW_BUFFER_MISS_BY_TYPE = {};
 };
 
 dram_stats operator-(dram_stats lhs, dram_stats rhs);
@@ -0,0 +1,103 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOST_PROFILE_H
+#define HOST_PROFILE_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * Whether the simulator measures the host time spent in its components. This is off unless requested, since reading the host clock is not free.
+ */
+extern bool host_profiling; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+/**
+ * The accumulated host time spent in one component
+ */
+struct host_timer {
+  using clock_type = std::chrono::steady_clock;
+
+  clock_type::duration elapsed{};
+  uint64_t calls = 0;
+
+  [[nodiscard]] double seconds() const { return std::chrono::duration<double>{elapsed}.count(); }
+};
+
+/**
+ * Add the host time spent in the enclosing scope to a timer, if host profiling is enabled
+ */
+class scoped_host_timer
+{
+  host_timer* timer;
+  host_timer::clock_type::time_point start{};
+
+public:
+  explicit scoped_host_timer(host_timer& t) : timer(host_profiling ? &t : nullptr)
+  {
+    if (timer != nullptr) {
+      start = host_timer::clock_type::now();
+    }
+  }
+
+  ~scoped_host_timer()
+  {
+    if (timer != nullptr) {
+      timer->elapsed += host_timer::clock_type::now() - start;
+      ++timer->calls;
+    }
+  }
+
+  scoped_host_timer(const scoped_host_timer&) = delete;
+  scoped_host_timer& operator=(const scoped_host_timer&) = delete;
+  scoped_host_timer(scoped_host_timer&&) = delete;
+  scoped_host_timer& operator=(scoped_host_timer&&) = delete;
+};
+
+/**
+ * The host time spent in a phase, and how it divides among the components of the simulated system.
+ * Module hooks run inside the operate() of their owner, so their time is also counted there.
+ */
+struct host_profile {
+  struct entry {
+    std::string name;
+    std::string hook;
+    double seconds;
+    uint64_t calls;
+  };
+
+  bool enabled = false;
+  double seconds = 0;
+  std::vector<long long> instructions{}; // per CPU
+  std::vector<entry> entries{};
+
+  /**
+   * The simulated thousands of instructions per host second for the given CPU
+   */
+  [[nodiscard]] double kips(std::size_t cpu) const;
+};
+
+/**
+ * Simulated thousands of instructions per host second
+ */
+double kips(long long instructions, std::chrono::duration<double> host_time);
+} // namespace champsim
+
+#endif
@@ -0,0 +1,120 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HOTSPOT_COUNTER_H
+#define HOTSPOT_COUNTER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace champsim
+{
+/**
+ * The number of hotspots reported for each kind of event, such as the branches that mispredict most often. Hotspots are not tracked unless
+ * this is set, since tracking them costs a lookup for every event.
+ */
+extern std::size_t hotspot_report_size; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+} // namespace champsim
+
+namespace champsim::stats
+{
+/**
+ * Counts the events of the most frequent keys in bounded memory, with the Space-Saving algorithm of Metwally et al.
+ *
+ * A fixed number of keys are monitored. An event of an unmonitored key replaces the monitored key with the fewest events, and inherits its count
+ * as an overestimate. Any key with more than (total events / monitored keys) events is monitored, and no count is overestimated by more than
+ * its recorded error.
+ */
+template <typename Key>
+class hotspot_counter
+{
+public:
+  using key_type = std::remove_cv_t<Key>;
+  using value_type = long;
+
+  /**
+   * A monitored key, with a count of at least its number of events and at most error more than that
+   */
+  struct entry_type {
+    key_type key;
+    value_type count;
+    value_type error;
+  };
+
+  // Monitoring more keys than are reported tightens the error of the reported counts
+  constexpr static std::size_t monitored_per_reported = 4;
+
+private:
+  std::size_t report_size;
+  std::map<key_type, std::pair<value_type, value_type>> counts{}; // count and error, by key
+  std::set<std::pair<value_type, key_type>> by_count{};
+
+public:
+  hotspot_counter() : hotspot_counter(hotspot_report_size) {}
+  explicit hotspot_counter(std::size_t n) : report_size(n) {}
+
+  /**
+   * Whether events are counted at all
+   */
+  [[nodiscard]] bool enabled() const { return report_size > 0; }
+
+  void increment(key_type key)
+  {
+    if (!enabled()) {
+      return;
+    }
+
+    auto found = counts.find(key);
+    if (found == std::end(counts)) {
+      value_type inherited = 0;
+      if (std::size(counts) == monitored_per_reported * report_size) {
+        auto victim = std::begin(by_count);
+        inherited = victim->first;
+        counts.erase(victim->second);
+        by_count.erase(victim);
+      }
+      found = counts.emplace(key, std::pair{inherited, inherited}).first;
+    } else {
+      by_count.erase(std::pair{found->second.first, key});
+    }
+
+    ++found->second.first;
+    by_count.emplace(found->second.first, key);
+  }
+
+  /**
+   * The reported hotspots, most events first
+   */
+  [[nodiscard]] std::vector<entry_type> top() const
+  {
+    std::vector<entry_type> retval{};
+    for (auto it = std::rbegin(by_count); it != std::rend(by_count) && std::size(retval) < report_size; ++it) {
+      auto [count, error] = counts.at(it->second);
+      retval.push_back(entry_type{it->second, count, error});
+    }
+    return retval;
+  }
+
+  [[nodiscard]] bool empty() const { return std::empty(counts); }
+};
+} // namespace champsim::stats
+
+#endif
@@ -24,6 +24,7 @@
 #include "access_type.h"
 #include "address.h"
 #include "block.h"
+#include "branch_confidence.h"
 #include "champsim.h"
 
 class CACHE;
@@ -67,8 +68,16 @@ struct branch_predictor : public bound_to<O3_CPU> {
   template <typename T, typename... Args>
   constexpr static bool has_last_branch_result = decltype(last_branch_result_member_impl<T, Args...>(0))::value;
 
+  template <typename T, typename... Args>
+  static auto prediction_confidence_member_impl(int) -> decltype(std::declval<T>().prediction_confidence(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto prediction_confidence_member_impl(long) -> std::false_type;
+
   template <typename T, typename... Args>
   constexpr static bool has_predict_branch = decltype(predict_branch_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_prediction_confidence = decltype(prediction_confidence_member_impl<T, Args...>(0))::value;
 };
 
 struct btb : public bound_to<O3_CPU> {
@@ -89,6 +98,11 @@ struct btb : public bound_to<O3_CPU> {
   template <typename, typename...>
   static auto predict_branch_member_impl(long) -> std::false_type;
 
+  template <typename T, typename... Args>
+  static auto peek_member_impl(int) -> decltype(std::declval<T>().btb_peek(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto peek_member_impl(long) -> std::false_type;
+
   template <typename T, typename... Args>
   constexpr static bool has_initialize = decltype(initialize_member_impl<T, Args...>(0))::value;
 
@@ -97,6 +111,9 @@ struct btb : public bound_to<O3_CPU> {
 
   template <typename T, typename... Args>
   constexpr static bool has_btb_prediction = decltype(predict_branch_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_btb_peek = decltype(peek_member_impl<T, Args...>(0))::value;
 };
 
 struct prefetcher : public bound_to<CACHE> {
@@ -134,6 +151,16 @@ struct prefetcher : public bound_to<CACHE> {
   template <typename, typename...>
   static auto branch_operate_member_impl(long) -> std::false_type;
 
+  template <typename T, typename... Args>
+  static auto ftq_enqueue_member_impl(int) -> decltype(std::declval<T>().prefetcher_ftq_enqueue(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto ftq_enqueue_member_impl(long) -> std::false_type;
+
+  template <typename T, typename... Args>
+  static auto retire_member_impl(int) -> decltype(std::declval<T>().prefetcher_retire(std::declval<Args>()...), std::true_type{});
+  template <typename, typename...>
+  static auto retire_member_impl(long) -> std::false_type;
+
   template <typename T, typename... Args>
   constexpr static bool has_initialize = decltype(initiailize_memory_impl<T, Args...>(0))::value;
 
@@ -151,6 +178,12 @@ struct prefetcher : public bound_to<CACHE> {
 
   template <typename T, typename... Args>
   constexpr static bool has_branch_operate = decltype(branch_operate_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_ftq_enqueue = decltype(ftq_enqueue_member_impl<T, Args...>(0))::value;
+
+  template <typename T, typename... Args>
+  constexpr static bool has_retire = decltype(retire_member_impl<T, Args...>(0))::value;
 };
 
 struct replacement : public bound_to<CACHE> {
@@ -88,7 +88,7 @@ private:
   uint64_t access_count = 0;
   block_vec_type block;
 
-  auto get_set_span(const value_type& elem)
+  diff_type set_offset(const value_type& elem) const
   {
     diff_type set_idx;
     if constexpr (champsim::is_specialization_v<std::invoke_result_t<SetProj, decltype(elem)>, champsim::address_slice>) {
@@ -98,13 +98,24 @@ private:
     }
     if (set_idx < 0)
       throw std::range_error{"Set projection produced negative set index: " + std::to_string(set_idx)};
-    diff_type raw_idx{(set_idx % NUM_SET) * NUM_WAY};
-    auto begin = std::next(std::begin(block), raw_idx);
+    return (set_idx % NUM_SET) * NUM_WAY;
+  }
+
+  auto get_set_span(const value_type& elem)
+  {
+    auto begin = std::next(std::begin(block), set_offset(elem));
     auto end = std::next(begin, NUM_WAY);
     return std::pair{begin, end};
   }
 
-  auto match_func(const value_type& elem)
+  auto get_set_span(const value_type& elem) const
+  {
+    auto begin = std::next(std::cbegin(block), set_offset(elem));
+    auto end = std::next(begin, NUM_WAY);
+    return std::pair{begin, end};
+  }
+
+  auto match_func(const value_type& elem) const
   {
     return [tag = tag_projection(elem), proj = this->tag_projection](const block_t& x) {
       return x.last_used > 0 && proj(x.data) == tag;
@@ -138,6 +149,21 @@ public:
     return hit->data;
   }
 
+  /**
+   * Find the element without marking it as used, so that looking does not disturb the replacement order
+   */
+  std::optional<value_type> peek(const value_type& elem) const
+  {
+    auto [set_begin, set_end] = get_set_span(elem);
+    auto hit = std::find_if(set_begin, set_end, match_func(elem));
+
+    if (hit == set_end) {
+      return std::nullopt;
+    }
+
+    return hit->data;
+  }
+
   void fill(const value_type& elem)
   {
     auto tag = tag_projection(elem);
@@ -0,0 +1,315 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MSL_PACKED_FWCOUNTER_H
+#define MSL_PACKED_FWCOUNTER_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "msl/bits.h"
+#include "msl/fwcounter.h"
+
+namespace champsim::msl
+{
+/**
+ * A fixed-size array of saturating counters, packed into 64-bit words.
+ *
+ * Each counter occupies exactly as many bits as the counter type it models, so a table of 2-bit counters is 32 times smaller than the equivalent
+ * array of champsim::msl::fwcounter. Counters never straddle a word boundary: a word holds ``64 / width`` lanes, and any remaining bits are unused.
+ *
+ * Element access through ``operator[]`` and ``at()`` returns a proxy reference that supports the same operations as the counter type, so that
+ * existing code written for ``std::array<fwcounter<N>, SIZE>`` continues to work with this container.
+ *
+ * \tparam Counter The counter type to emulate, for example ``champsim::msl::fwcounter<2>`` or ``champsim::msl::sfwcounter<8>``.
+ * \tparam SIZE The number of counters in the array.
+ */
+template <typename Counter, std::size_t SIZE>
+class packed_fwcounter_array
+{
+public:
+  using counter_type = Counter;
+  using value_type = typename Counter::value_type;
+  using word_type = uint64_t;
+
+  constexpr static value_type minimum = Counter::minimum;
+  constexpr static value_type maximum = Counter::maximum;
+
+  /**
+   * The number of bits occupied by each counter.
+   */
+  constexpr static unsigned width = lg2(static_cast<unsigned long long>(maximum - minimum)) + 1;
+
+  /**
+   * The number of counters held in each 64-bit word.
+   */
+  constexpr static std::size_t lanes_per_word = std::numeric_limits<word_type>::digits / width;
+
+  static_assert(width <= 32, "Packed counters must be no wider than 32 bits");
+
+private:
+  constexpr static word_type lane_mask = (word_type{1} << width) - 1;
+  constexpr static word_type raw_max = static_cast<word_type>(maximum - minimum);
+
+  std::array<word_type, (SIZE + lanes_per_word - 1) / lanes_per_word> words{};
+
+  // Counters are stored biased by their minimum, so that the zero-initialized array holds the same values as a value-initialized Counter array.
+  constexpr static value_type initial_value = std::clamp(value_type{}, minimum, maximum);
+
+  static constexpr word_type encode(value_type val) { return static_cast<word_type>(std::clamp(val, minimum, maximum) - minimum); }
+  static constexpr value_type decode(word_type raw) { return static_cast<value_type>(raw) + minimum; }
+
+  static constexpr std::size_t word_index(std::size_t idx) { return idx / lanes_per_word; }
+  static constexpr unsigned lane_shift(std::size_t idx) { return static_cast<unsigned>(idx % lanes_per_word) * width; }
+
+  void check_range(std::size_t idx) const
+  {
+    if (idx >= SIZE) {
+      throw std::out_of_range{"packed_fwcounter_array::at"};
+    }
+  }
+
+public:
+  /**
+   * A proxy for a single counter in the array.
+   * The proxy supports the arithmetic, comparison, and query operations of the emulated counter type.
+   */
+  class reference
+  {
+    word_type* word;
+    unsigned shift;
+
+    word_type raw() const { return (*word >> shift) & lane_mask; }
+    void set_raw(word_type raw) { *word = (*word & ~(lane_mask << shift)) | (raw << shift); }
+
+    friend class packed_fwcounter_array;
+    reference(word_type* w, unsigned s) : word(w), shift(s) {}
+
+  public:
+    constexpr static value_type minimum = packed_fwcounter_array::minimum;
+    constexpr static value_type maximum = packed_fwcounter_array::maximum;
+
+    reference(const reference&) = default;
+
+    reference& operator=(const reference& other)
+    {
+      set_raw(other.raw());
+      return *this;
+    }
+
+    reference& operator=(Counter other)
+    {
+      set_raw(encode(other.value()));
+      return *this;
+    }
+
+    template <typename Numeric, typename = std::enable_if_t<std::is_arithmetic_v<Numeric>>>
+    reference& operator=(Numeric rhs)
+    {
+      set_raw(encode(static_cast<value_type>(rhs)));
+      return *this;
+    }
+
+    /**
+     * Increment the value, saturating at the maximum value.
+     */
+    reference& operator++()
+    {
+      if (raw() != raw_max) {
+        *word += word_type{1} << shift;
+      }
+      return *this;
+    }
+
+    Counter operator++(int)
+    {
+      Counter result{value()};
+      operator++();
+      return result;
+    }
+
+    /**
+     * Decrement the value, saturating at the minimum value.
+     */
+    reference& operator--()
+    {
+      if (raw() != 0) {
+        *word -= word_type{1} << shift;
+      }
+      return *this;
+    }
+
+    Counter operator--(int)
+    {
+      Counter result{value()};
+      operator--();
+      return result;
+    }
+
+    template <typename Numeric>
+    reference& operator+=(Numeric rhs)
+    {
+      return (*this = value() + rhs);
+    }
+
+    template <typename Numeric>
+    reference& operator-=(Numeric rhs)
+    {
+      return (*this = value() - rhs);
+    }
+
+    template <typename Numeric>
+    reference& operator*=(Numeric rhs)
+    {
+      return (*this = value() * rhs);
+    }
+
+    template <typename Numeric>
+    reference& operator/=(Numeric rhs)
+    {
+      return (*this = value() / rhs);
+    }
+
+    template <typename Numeric>
+    reference& operator>>=(Numeric rhs)
+    {
+      return (*this = value() >> rhs);
+    }
+
+    /**
+     * Detect whether the counter is saturated at its maximum.
+     */
+    bool is_max() const { return raw() == raw_max; }
+
+    /**
+     * Detect whether the counter is saturated at its minimum.
+     */
+    bool is_min() const { return raw() == 0; }
+
+    /**
+     * Unpack the wrapped value.
+     */
+    value_type value() const { return decode(raw()); }
+
+    operator Counter() const { return Counter{value()}; }
+
+    /*
+     * Comparators forward to the unpacked value
+     */
+    template <typename Numeric, typename = std::enable_if_t<std::is_arithmetic_v<Numeric>>>
+    friend bool operator==(const reference& lhs, Numeric rhs)
+    {
+      return lhs.value() == rhs;
+    }
+
+    template <typename Numeric, typename = std::enable_if_t<std::is_arithmetic_v<Numeric>>>
+    friend bool operator!=(const reference& lhs, Numeric rhs)
+    {
+      return lhs.value() != rhs;
+    }
+
+    template <typename Numeric, typename = std::enable_if_t<std::is_arithmetic_v<Numeric>>>
+    friend bool operator<(const reference& lhs, Numeric rhs)
+    {
+      return lhs.value() < rhs;
+    }
+
+    template <typename Numeric, typename = std::enable_if_t<std::is_arithmetic_v<Numeric>>>
+    friend bool operator>(const reference& lhs, Numeric rhs)
+    {
+      return lhs.value() > rhs;
+    }
+
+    template <typename Numeric, typename = std::enable_if_t<std::is_arithmetic_v<Numeric>>>
+    friend bool operator<=(const reference& lhs, Numeric rhs)
+    {
+      return lhs.value() <= rhs;
+    }
+
+    template <typename Numeric, typename = std::enable_if_t<std::is_arithmetic_v<Numeric>>>
+    friend bool operator>=(const reference& lhs, Numeric rhs)
+    {
+      return lhs.value() >= rhs;
+    }
+  };
+
+  packed_fwcounter_array()
+  {
+    if constexpr (initial_value != minimum) {
+      fill(Counter{initial_value});
+    }
+  }
+
+  /**
+   * Set every counter in the array to the given value.
+   */
+  void fill(Counter val)
+  {
+    word_type pattern{};
+    for (std::size_t i = 0; i < lanes_per_word; ++i) {
+      pattern |= encode(val.value()) << (i * width);
+    }
+    std::fill(std::begin(words), std::end(words), pattern);
+  }
+
+  reference operator[](std::size_t idx) { return reference{&words[word_index(idx)], lane_shift(idx)}; }
+  Counter operator[](std::size_t idx) const { return Counter{decode((words[word_index(idx)] >> lane_shift(idx)) & lane_mask)}; }
+
+  reference at(std::size_t idx)
+  {
+    check_range(idx);
+    return (*this)[idx];
+  }
+
+  Counter at(std::size_t idx) const
+  {
+    check_range(idx);
+    return (*this)[idx];
+  }
+
+  /**
+   * Increment the counter at the given index, saturating at the maximum value.
+   */
+  void increment(std::size_t idx) { ++(*this)[idx]; }
+
+  /**
+   * Decrement the counter at the given index, saturating at the minimum value.
+   */
+  void decrement(std::size_t idx) { --(*this)[idx]; }
+
+  constexpr static std::size_t size() { return SIZE; }
+
+  /**
+   * Access the backing storage.
+   * Counter ``i`` occupies bits ``[(i % lanes_per_word) * width, (i % lanes_per_word + 1) * width)`` of word ``i / lanes_per_word``,
+   * and is stored biased by ``-minimum``, so that every stored lane is non-negative.
+   */
+  word_type* data() { return words.data(); }
+  const word_type* data() const { return words.data(); }
+
+  /**
+   * The number of bytes of backing storage used by the array.
+   */
+  constexpr static std::size_t storage_bytes() { return std::tuple_size_v<decltype(words)> * sizeof(word_type); }
+};
+
+} // namespace champsim::msl
+
+#endif
@@ -0,0 +1,116 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MSL_TAGE_HASHING_H
+#define MSL_TAGE_HASHING_H
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+/*
+ * The hashing and history helpers shared by the TAGE-like predictors, TAGE-SC-L and ITTAGE.
+ */
+namespace champsim::msl::tage
+{
+constexpr uint64_t mask(unsigned width) { return (uint64_t{1} << width) - 1; }
+
+/**
+ * History lengths that form a geometric series from the shortest to the longest
+ */
+template <std::size_t N>
+std::array<unsigned, N> geometric_lengths(unsigned min_length, unsigned max_length)
+{
+  static_assert(N > 1);
+  std::array<unsigned, N> retval{};
+  for (std::size_t i = 0; i < N; ++i) {
+    auto ratio = static_cast<double>(i) / static_cast<double>(N - 1);
+    retval.at(i) = static_cast<unsigned>(std::lround(min_length * std::pow(static_cast<double>(max_length) / min_length, ratio)));
+  }
+  return retval;
+}
+
+/**
+ * A xorshift generator for the random choices of allocation, so that simulations are repeatable
+ */
+class xorshift
+{
+  uint64_t state = 0x2545f4914f6cdd1d;
+
+public:
+  uint64_t operator()()
+  {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return state;
+  }
+};
+
+/**
+ * A global history folded by XOR into a chosen number of bits, as in the index and tag hashes of TAGE.
+ *
+ * Unlike folded_shift_register, the width is chosen at run time, so that each table can fold its history to the width of its own index or tag.
+ * The folded value is maintained incrementally as bits are pushed, so reading it is a single load.
+ */
+class folded_history
+{
+  unsigned length = 0;
+  unsigned width = 0;
+  std::vector<bool> history{}; // a ring buffer of the history, where head is the oldest bit
+  std::size_t head = 0;
+  uint64_t folded = 0;
+
+public:
+  folded_history() = default;
+
+  /**
+   * :param length: the number of bits of history
+   * :param width: the number of bits the history is folded into
+   */
+  folded_history(unsigned length_, unsigned width_) : length(length_), width(width_), history(length_)
+  {
+    if (width == 0 || width >= 64) {
+      throw std::invalid_argument{"A folded history must be between 1 and 63 bits wide"};
+    }
+  }
+
+  [[nodiscard]] uint64_t value() const { return folded; }
+
+  /**
+   * Insert this bit into the history
+   */
+  void push_back(bool ins)
+  {
+    if (length == 0) {
+      return;
+    }
+
+    bool outgoing = history[head];
+    history[head] = ins;
+    head = (head + 1) % length;
+
+    // Rotate the fold to follow the shift, then remove the outgoing bit from the position it would have folded onto
+    folded = ((folded << 1) | (folded >> (width - 1))) & ((uint64_t{1} << width) - 1);
+    folded ^= ins ? 1 : 0;
+    folded ^= uint64_t{outgoing ? 1u : 0u} << (length % width);
+  }
+};
+} // namespace champsim::msl::tage
+
+#endif
@@ -34,14 +34,18 @@
 #include <vector>
 
 #include "bandwidth.h"
+#include "branch_confidence.h"
 #include "champsim.h"
 #include "channel.h"
+#include "code_prefetch_hints.h"
 #include "core_builder.h"
 #include "core_stats.h"
 #include "instruction.h"
 #include "modules.h"
 #include "operable.h"
 #include "register_allocator.h"
+#include "static_code_map.h"
+#include "uop_cache.h"
 #include "util/lru_table.h"
 #include "util/to_underlying.h"
 
@@ -60,6 +64,7 @@ class CacheBus
 public:
   CacheBus(uint32_t cpu_idx, champsim::channel* ll) : lower_level(ll), cpu(cpu_idx) {}
   bool issue_read(request_type packet);
+  bool issue_fetch(request_type packet);
   bool issue_write(request_type packet);
 };
 
@@ -110,6 +115,21 @@ public:
   using dib_type = champsim::lru_table<champsim::address, dib_shift, dib_shift>;
   dib_type DIB;
 
+  // micro-op cache, which replaces the DIB if it is configured
+  std::optional<champsim::uop_cache> UOP_CACHE;
+  const champsim::chrono::clock::duration UOP_CACHE_SWITCH_PENALTY;
+  std::optional<bool> last_uop_cache_hit{};              // whether the last instruction checked was delivered by the micro-op cache
+  champsim::chrono::clock::time_point uop_cache_resume_time{}; // the end of the stall after a switch between the micro-op cache and the decoders
+
+  // fetch target queue
+  struct ftq_entry {
+    champsim::address fetch_addr{}; // the first instruction of the fetch block
+    std::deque<ooo_model_instr> instrs{};
+    bool redirect = false;   // the block ends in a branch that moves the stream elsewhere, so no more instructions join it
+    bool wrong_path = false; // the block lies past a mispredicted branch, so it is fetched but none of its instructions execute
+  };
+  std::deque<ftq_entry> FTQ;
+
   // reorder buffer, load/store queue, register file
   std::deque<ooo_model_instr> IFETCH_BUFFER;
   std::deque<ooo_model_instr> DISPATCH_BUFFER;
@@ -121,10 +141,11 @@ public:
   std::deque<LSQ_ENTRY> SQ;
 
   // Constants
-  const std::size_t IFETCH_BUFFER_SIZE, DISPATCH_BUFFER_SIZE, DECODE_BUFFER_SIZE, REGISTER_FILE_SIZE, ROB_SIZE, SQ_SIZE, DIB_HIT_BUFFER_SIZE;
+  const std::size_t IFETCH_BUFFER_SIZE, DISPATCH_BUFFER_SIZE, DECODE_BUFFER_SIZE, REGISTER_FILE_SIZE, ROB_SIZE, SQ_SIZE, DIB_HIT_BUFFER_SIZE, FTQ_SIZE;
   champsim::bandwidth::maximum_type FETCH_WIDTH, DECODE_WIDTH, DISPATCH_WIDTH, SCHEDULER_SIZE, EXEC_WIDTH, DIB_INORDER_WIDTH;
   champsim::bandwidth::maximum_type LQ_WIDTH, SQ_WIDTH;
   champsim::bandwidth::maximum_type RETIRE_WIDTH;
+  champsim::bandwidth::maximum_type TAKEN_BRANCHES_PER_CYCLE, FETCH_BLOCKS_PER_CYCLE;
   champsim::chrono::clock::duration BRANCH_MISPREDICT_PENALTY;
   champsim::chrono::clock::duration DISPATCH_LATENCY;
   champsim::chrono::clock::duration DECODE_LATENCY;
@@ -134,11 +155,52 @@ public:
 
   champsim::bandwidth::maximum_type L1I_BANDWIDTH, L1D_BANDWIDTH;
 
+  const std::size_t BRANCH_PREDICTOR_BUDGET; // bytes of storage for the branch predictor, or 0 if the predictor chooses its own size
+  const unsigned SLOW_PREDICTOR_LATENCY;      // cycles before the last branch predictor overrides the first, or 0 if there is no override
+
   RegisterAllocator reg_allocator{REGISTER_FILE_SIZE};
 
   // branch
   champsim::chrono::clock::time_point fetch_resume_time{};
 
+  // The result of the BTB lookup for the instruction being predicted, as reported by a BTB module that has several levels
+  struct btb_lookup_type {
+    std::size_t levels = 0;                 // the number of levels searched, or 0 if the BTB did not report
+    std::optional<std::size_t> hit_level{}; // the level that held the branch
+    unsigned redirect_latency = 0;          // the cycles before a taken prediction from that level can redirect the branch prediction unit
+  };
+  btb_lookup_type last_btb_lookup{};
+
+  // The directions predicted by the first and the last of the branch predictor modules, which are the same if there is only one
+  struct branch_prediction_type {
+    bool fast = false;
+    bool slow = false;
+  };
+
+  // wrong-path fetch
+  const bool WRONG_PATH_FETCH;
+  std::optional<champsim::address> wrong_path_addr{}; // the next fetch block on the wrong path, while a misprediction is unresolved
+
+  // The branches seen so far in the trace. These are kept if wrong-path fetch is enabled, or if a module asks for them.
+  champsim::static_code_map code_map{};
+  bool record_code_map = false;
+
+  // loop stream detector
+  constexpr static unsigned LSD_LOCK_ITERATIONS = 2; // the iterations that must fit before a loop is locked
+  const std::size_t LSD_SIZE;                        // the most instructions in a loop body that can be replayed, or 0 if there is no LSD
+  struct lsd_type {
+    std::optional<champsim::address> branch_ip{}; // the backward branch that closes the candidate loop
+    champsim::address head{};                     // the target of that branch
+    std::size_t body_size = 0;                    // the instructions seen since the branch was last taken
+    unsigned iterations = 0;                      // the consecutive iterations that fit
+    bool locked = false;                          // the loop is being replayed
+  };
+  lsd_type lsd{};
+
+  // Software code prefetches, which issue to the L1I when their trigger instructions are fetched
+  champsim::code_prefetch_hints prefetch_hints{};
+  bool prefetch_hints_take_fetch_slots = false; // each prefetch uses a fetch slot that the cycle has left
+
   const long IN_QUEUE_SIZE;
   std::deque<ooo_model_instr> input_queue;
 
@@ -151,6 +213,8 @@ public:
   void end_phase(unsigned cpu) final;
 
   void initialize_instruction();
+  void predict_wrong_path();
+  long fetch_from_ftq();
   long check_dib();
   long fetch_instruction();
   long promote_to_decode();
@@ -165,8 +229,11 @@ public:
 
   bool do_init_instruction(ooo_model_instr& instr);
   bool do_predict_branch(ooo_model_instr& instr);
+  void do_loop_stream(ooo_model_instr& instr, bool starts_block);
+  long do_prefetch_hints(const ooo_model_instr& instr);
   void do_check_dib(ooo_model_instr& instr);
   bool do_fetch_instruction(std::deque<ooo_model_instr>::iterator begin, std::deque<ooo_model_instr>::iterator end);
+  bool do_fetch_wrong_path(champsim::address fetch_addr);
   void do_dib_update(const ooo_model_instr& instr);
   void do_scheduling(ooo_model_instr& instr);
   void do_execution(ooo_model_instr& instr);
@@ -192,7 +259,8 @@ public:
 
     virtual void impl_initialize_branch_predictor() = 0;
     virtual void impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) = 0;
-    virtual bool impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) = 0;
+    virtual branch_prediction_type impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) = 0;
+    virtual champsim::branch_confidence impl_prediction_confidence(champsim::address ip) = 0;
   };
 
   struct btb_module_concept {
@@ -201,6 +269,7 @@ public:
     virtual void impl_initialize_btb() = 0;
     virtual void impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) = 0;
     virtual std::pair<champsim::address, bool> impl_btb_prediction(champsim::address ip, uint8_t branch_type) = 0;
+    virtual std::pair<champsim::address, bool> impl_btb_peek(champsim::address ip, uint8_t branch_type) const = 0;
   };
 
   template <typename... Bs>
@@ -210,7 +279,9 @@ public:
 
     void impl_initialize_branch_predictor() final;
     void impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) final;
-    [[nodiscard]] bool impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) final;
+    [[nodiscard]] branch_prediction_type impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken,
+                                                             uint8_t branch_type) final;
+    [[nodiscard]] champsim::branch_confidence impl_prediction_confidence(champsim::address ip) final;
   };
 
   template <typename... Ts>
@@ -221,33 +292,54 @@ public:
     void impl_initialize_btb() final;
     void impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) final;
     [[nodiscard]] std::pair<champsim::address, bool> impl_btb_prediction(champsim::address ip, uint8_t branch_type) final;
+    [[nodiscard]] std::pair<champsim::address, bool> impl_btb_peek(champsim::address ip, uint8_t branch_type) const final;
   };
 
   std::unique_ptr<branch_module_concept> branch_module_pimpl;
   std::unique_ptr<btb_module_concept> btb_module_pimpl;
 
+  // Host time spent in the module hooks, when host profiling is enabled
+  struct hook_timer_type {
+    champsim::host_timer predict_branch{};
+    champsim::host_timer last_branch_result{};
+    champsim::host_timer btb_prediction{};
+    champsim::host_timer update_btb{};
+  };
+  mutable hook_timer_type hook_timers{};
+
   // NOLINTBEGIN(readability-make-member-function-const): legacy modules use non-const hooks
   void impl_initialize_branch_predictor() const;
   void impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) const;
-  [[nodiscard]] bool impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) const;
+  [[nodiscard]] branch_prediction_type impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken,
+                                                           uint8_t branch_type) const;
+  [[nodiscard]] champsim::branch_confidence impl_prediction_confidence(champsim::address ip) const;
 
   void impl_initialize_btb() const;
   void impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) const;
   [[nodiscard]] std::pair<champsim::address, bool> impl_btb_prediction(champsim::address ip, uint8_t branch_type) const;
+  [[nodiscard]] std::pair<champsim::address, bool> impl_btb_peek(champsim::address ip, uint8_t branch_type) const;
   // NOLINTEND(readability-make-member-function-const)
 
   template <typename... Bs, typename... Ts>
   explicit O3_CPU(champsim::core_builder<champsim::core_builder_module_type_holder<Bs...>, champsim::core_builder_module_type_holder<Ts...>> b)
       : champsim::operable(b.m_clock_period), cpu(b.m_cpu),
         DIB(b.m_dib_set, b.m_dib_way, {champsim::data::bits{champsim::lg2(b.m_dib_window)}}, {champsim::data::bits{champsim::lg2(b.m_dib_window)}}),
+        UOP_CACHE(b.m_uop_cache_set > 0 ? std::optional<champsim::uop_cache>{std::in_place, b.m_uop_cache_set, b.m_uop_cache_way, b.m_uop_cache_window,
+                                                                             b.m_uop_cache_uops_per_line, b.m_uop_cache_lines_per_window,
+                                                                             b.m_uop_cache_partial_windows}
+                                        : std::nullopt),
+        UOP_CACHE_SWITCH_PENALTY(b.m_uop_cache_switch_penalty * b.m_clock_period),
         LQ(b.m_lq_size), IFETCH_BUFFER_SIZE(b.m_ifetch_buffer_size), DISPATCH_BUFFER_SIZE(b.m_dispatch_buffer_size), DECODE_BUFFER_SIZE(b.m_decode_buffer_size),
         REGISTER_FILE_SIZE(b.m_register_file_size), ROB_SIZE(b.m_rob_size), SQ_SIZE(b.m_sq_size), DIB_HIT_BUFFER_SIZE(b.m_dib_hit_buffer_size),
+        FTQ_SIZE(b.m_ftq_size),
         FETCH_WIDTH(b.m_fetch_width), DECODE_WIDTH(b.m_decode_width), DISPATCH_WIDTH(b.m_dispatch_width), SCHEDULER_SIZE(b.m_schedule_width),
         EXEC_WIDTH(b.m_execute_width), DIB_INORDER_WIDTH(b.m_dib_inorder_width), LQ_WIDTH(b.m_lq_width), SQ_WIDTH(b.m_sq_width), RETIRE_WIDTH(b.m_retire_width),
+        TAKEN_BRANCHES_PER_CYCLE(b.m_taken_branches_per_cycle), FETCH_BLOCKS_PER_CYCLE(b.m_fetch_blocks_per_cycle),
         BRANCH_MISPREDICT_PENALTY(b.m_mispredict_penalty * b.m_clock_period), DISPATCH_LATENCY(b.m_dispatch_latency * b.m_clock_period),
         DECODE_LATENCY(b.m_decode_latency * b.m_clock_period), SCHEDULING_LATENCY(b.m_schedule_latency * b.m_clock_period),
         EXEC_LATENCY(b.m_execute_latency * b.m_clock_period), DIB_HIT_LATENCY(b.m_dib_hit_latency * b.m_clock_period), L1I_BANDWIDTH(b.m_l1i_bw),
-        L1D_BANDWIDTH(b.m_l1d_bw), IN_QUEUE_SIZE(2 * champsim::to_underlying(b.m_fetch_width)), L1I_bus(b.m_cpu, b.m_fetch_queues),
+        L1D_BANDWIDTH(b.m_l1d_bw), BRANCH_PREDICTOR_BUDGET(b.m_branch_predictor_budget), SLOW_PREDICTOR_LATENCY(b.m_slow_predictor_latency),
+        WRONG_PATH_FETCH(b.m_wrong_path_fetch), LSD_SIZE(b.m_lsd_size), IN_QUEUE_SIZE(2 * champsim::to_underlying(b.m_fetch_width)), L1I_bus(b.m_cpu, b.m_fetch_queues),
         L1D_bus(b.m_cpu, b.m_data_queues), l1i(b.m_l1i), branch_module_pimpl(std::make_unique<branch_module_model<Bs...>>(this)),
         btb_module_pimpl(std::make_unique<btb_module_model<Ts...>>(this))
   {
@@ -281,7 +373,8 @@ void O3_CPU::branch_module_model<Bs...>::impl_last_branch_result(champsim::addre
 }
 
 template <typename... Bs>
-bool O3_CPU::branch_module_model<Bs...>::impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type)
+auto O3_CPU::branch_module_model<Bs...>::impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type)
+    -> branch_prediction_type
 {
   using return_type = bool;
   [[maybe_unused]] auto process_one = [&](auto& b) {
@@ -306,9 +399,38 @@ bool O3_CPU::branch_module_model<Bs...>::impl_predict_branch(champsim::address i
   };
 
   if constexpr (sizeof...(Bs)) {
-    return std::apply([&](auto&... b) { return (..., process_one(b)); }, intern_);
+    // The first module is the fast predictor, and the last is the slow predictor that overrides it
+    return std::apply(
+        [&](auto&... b) {
+          std::array<bool, sizeof...(Bs)> predictions{process_one(b)...};
+          return branch_prediction_type{predictions.front(), predictions.back()};
+        },
+        intern_);
   }
-  return return_type{};
+  return branch_prediction_type{};
+}
+
+template <typename... Bs>
+champsim::branch_confidence O3_CPU::branch_module_model<Bs...>::impl_prediction_confidence(champsim::address ip)
+{
+  using return_type = std::optional<champsim::branch_confidence>;
+  [[maybe_unused]] auto process_one = [&](auto& b) {
+    using namespace champsim::modules;
+    if constexpr (branch_predictor::has_prediction_confidence<decltype(b), champsim::address>)
+      return return_type{b.prediction_confidence(ip)};
+    if constexpr (branch_predictor::has_prediction_confidence<decltype(b), uint64_t>)
+      return return_type{b.prediction_confidence(ip.to<uint64_t>())};
+    return return_type{};
+  };
+
+  // The last module gives the final prediction, so the last estimate is kept
+  return_type retval{};
+  [[maybe_unused]] auto keep_last = [&](auto& b) {
+    if (auto confidence = process_one(b); confidence.has_value())
+      retval = confidence;
+  };
+  std::apply([&](auto&... b) { (..., keep_last(b)); }, intern_);
+  return retval.value_or(champsim::branch_confidence::high);
 }
 
 template <typename... Ts>
@@ -364,7 +486,54 @@ std::pair<champsim::address, bool> O3_CPU::btb_module_model<Ts...>::impl_btb_pre
   };
 
   if constexpr (sizeof...(Ts) > 0) {
-    return std::apply([&](auto&... t) { return (..., process_one(t)); }, intern_);
+    // Later modules override earlier ones for the branches they predict a target for
+    auto retval = process_one(std::get<0>(intern_));
+    [[maybe_unused]] auto override_one = [&](auto& t) {
+      if (auto prediction = process_one(t); prediction.first != champsim::address{})
+        retval = prediction;
+    };
+    std::apply([&](auto&, auto&... rest) { (..., override_one(rest)); }, intern_);
+    return retval;
+  }
+  return return_type{};
+}
+
+template <typename... Ts>
+std::pair<champsim::address, bool> O3_CPU::btb_module_model<Ts...>::impl_btb_peek(champsim::address ip, uint8_t branch_type) const
+{
+  using return_type = std::pair<champsim::address, bool>;
+  [[maybe_unused]] auto process_one = [&](const auto& t) {
+    using namespace champsim::modules;
+
+    /* Strong addresses, full size */
+    if constexpr (btb::has_btb_peek<decltype(t), champsim::address, uint8_t>)
+      return return_type{t.btb_peek(ip, branch_type)};
+
+    /* Strong addresses, short size */
+    if constexpr (btb::has_btb_peek<decltype(t), champsim::address>)
+      return return_type{t.btb_peek(ip)};
+
+    /* Raw integer addresses, full size */
+    if constexpr (btb::has_btb_peek<decltype(t), uint64_t, uint8_t>)
+      return return_type{t.btb_peek(ip.to<uint64_t>(), branch_type)};
+
+    /* Raw integer addresses, short size */
+    if constexpr (btb::has_btb_peek<decltype(t), uint64_t>)
+      return return_type{t.btb_peek(ip.to<uint64_t>())};
+
+    // A module that cannot look without side effects predicts nothing
+    return return_type{};
+  };
+
+  if constexpr (sizeof...(Ts) > 0) {
+    // Later modules override earlier ones, as in impl_btb_prediction
+    auto retval = process_one(std::get<0>(intern_));
+    [[maybe_unused]] auto override_one = [&](const auto& t) {
+      if (auto prediction = process_one(t); prediction.first != champsim::address{})
+        retval = prediction;
+    };
+    std::apply([&](const auto&, const auto&... rest) { (..., override_one(rest)); }, intern_);
+    return retval;
   }
   return return_type{};
 }
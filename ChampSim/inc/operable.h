@@ -18,6 +18,7 @@
 #define OPERABLE_H
 
 #include "chrono.h"
+#include "host_profile.h"
 
 namespace champsim
 {
@@ -27,6 +28,7 @@ public:
   champsim::chrono::picoseconds clock_period{};
   champsim::chrono::clock::time_point current_time{};
   bool warmup = true;
+  champsim::host_timer operate_timer{};
 
   operable();
   virtual ~operable() = default;
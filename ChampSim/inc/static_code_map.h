@@ -0,0 +1,72 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STATIC_CODE_MAP_H
+#define STATIC_CODE_MAP_H
+
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "address.h"
+
+namespace champsim
+{
+/**
+ * The branches of the program, as learned from the part of the trace that has been seen so far.
+ *
+ * Traces hold only the correct path, so this is what the simulator knows of the static code when it needs instructions that
+ * the trace does not provide, for example when fetching down a mispredicted path or predecoding a cache block.
+ */
+class static_code_map
+{
+public:
+  struct branch_info {
+    uint8_t branch_type;
+    champsim::address target; // the most recent target
+    bool taken;               // the most recent direction
+  };
+
+  using value_type = std::pair<champsim::address, branch_info>;
+
+  /**
+   * Record an execution of the branch at the given instruction pointer
+   */
+  void record(champsim::address ip, uint8_t branch_type, champsim::address target, bool taken);
+
+  /**
+   * Find the first known branch at or after the given address and before the limit
+   */
+  [[nodiscard]] std::optional<value_type> next_branch(champsim::address begin, champsim::address end) const;
+
+  /**
+   * Find all known branches at or after the given address and before the limit
+   */
+  [[nodiscard]] std::vector<value_type> branches_in(champsim::address begin, champsim::address end) const;
+
+  /**
+   * The number of distinct branches recorded
+   */
+  [[nodiscard]] std::size_t size() const { return std::size(branches); }
+
+private:
+  std::map<champsim::address, branch_info> branches;
+};
+} // namespace champsim
+
+#endif
@@ -37,6 +37,7 @@ public:
   static std::vector<std::string> format(O3_CPU::stats_type stats);
   static std::vector<std::string> format(CACHE::stats_type stats);
   static std::vector<std::string> format(DRAM_CHANNEL::stats_type stats);
+  static std::vector<std::string> format(const host_profile& profile);
   static std::vector<std::string> format(phase_stats& stats);
 };
 
@@ -0,0 +1,180 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SYNTHETIC_TRACE_H
+#define SYNTHETIC_TRACE_H
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "trace_instruction.h"
+
+namespace champsim
+{
+/**
+ * The parameters of a synthetic workload.
+ *
+ * The workload is a static program of basic blocks that fills the code footprint. Each block ends in a branch, and its other instructions
+ * are arithmetic, loads, or stores. The dynamic instruction stream is a walk through that program.
+ */
+struct synthetic_trace_parameters {
+  uint64_t seed = 1;
+  uint64_t length = 0; // the number of instructions in the trace, or 0 for a trace that never ends
+
+  // Code
+  uint64_t code_base = 0x400000;
+  uint64_t code_footprint = 64 * 1024; // bytes
+  unsigned instruction_size = 4;       // bytes
+  unsigned min_block_size = 4;         // instructions, including the branch
+  unsigned max_block_size = 12;        // instructions, including the branch
+  bool geometric_block_size = false;   // if false, block sizes are uniform between the minimum and maximum
+
+  // Branch mix. The remainder of the branches are conditional.
+  double jump_fraction = 0.08;
+  double call_fraction = 0.06;
+  double return_fraction = 0.06;
+  double indirect_fraction = 0.02;
+  double indirect_call_fraction = 0.01;
+
+  double branch_bias = 0.9;      // each conditional branch is taken with this probability or its complement
+  unsigned branch_distance = 16; // the farthest, in blocks, that a conditional branch jumps
+  unsigned max_call_depth = 32;
+
+  unsigned indirect_targets = 4; // the number of targets for each indirect branch
+  double indirect_skew = 0.0;    // the exponent of the Zipf distribution over indirect targets, where 0 is uniform (maximum entropy)
+
+  // Data
+  uint64_t data_base = 0x10000000;
+  uint64_t data_footprint = 1024 * 1024; // bytes
+  double load_fraction = 0.25;
+  double store_fraction = 0.1;
+  std::vector<int64_t> strides = {8, 64}; // bytes
+  double stride_fraction = 0.6;           // the fraction of memory instructions that walk with one of the strides
+  double pointer_chase_fraction = 0.1;    // the fraction of memory instructions whose address depends on their previous value
+};
+
+/**
+ * Parse a list of comma-separated key=value pairs, where the keys are the member names of synthetic_trace_parameters.
+ * Sizes may use the suffixes K, M, and G. Strides are separated by colons.
+ *
+ * \throws std::invalid_argument if a key is not known or a value cannot be parsed
+ */
+synthetic_trace_parameters parse_synthetic_trace_parameters(std::string_view spec);
+
+/**
+ * The prefix that names a synthetic trace in place of a trace file, for example "synthetic:code_footprint=1M,branch_bias=0.95"
+ */
+inline constexpr std::string_view synthetic_trace_prefix = "synthetic:";
+
+/**
+ * Determine whether the trace name describes a synthetic trace
+ */
+bool is_synthetic_trace_name(std::string_view name);
+
+/**
+ * A generator of input_instr records for a synthetic workload.
+ * Two generators with the same parameters produce the same instructions.
+ */
+class synthetic_trace_generator
+{
+  enum class instr_kind { ALU, LOAD, STORE };
+  enum class branch_kind { CONDITIONAL, JUMP, CALL, RETURN, INDIRECT, INDIRECT_CALL };
+  enum class address_pattern { STRIDE, POINTER_CHASE, RANDOM };
+
+  struct memory_stream {
+    address_pattern pattern;
+    int64_t stride;
+    uint64_t offset;
+  };
+
+  struct static_instr {
+    instr_kind kind;
+    std::size_t stream; // index into the memory streams, for loads and stores
+    unsigned char dest;
+    unsigned char src;
+  };
+
+  struct basic_block {
+    uint64_t ip;
+    std::vector<static_instr> body;
+    branch_kind branch;
+    std::size_t taken_target;         // for direct branches
+    std::vector<std::size_t> targets; // for indirect branches
+    double taken_probability;         // for conditional branches
+  };
+
+  synthetic_trace_parameters params;
+  std::mt19937_64 rng;
+  std::vector<basic_block> blocks;
+  std::vector<memory_stream> streams;
+  std::discrete_distribution<std::size_t> indirect_dist;
+
+  std::size_t current_block = 0;
+  std::size_t current_pos = 0;
+  std::vector<std::size_t> call_stack;
+  uint64_t generated = 0;
+
+  void build_program();
+  uint64_t next_data_address(memory_stream& stream);
+  input_instr branch_instr(const basic_block& block);
+  void take_branch(const basic_block& block, bool taken);
+
+public:
+  explicit synthetic_trace_generator(synthetic_trace_parameters p);
+
+  /**
+   * Produce the next instruction of the workload
+   */
+  input_instr operator()();
+
+  /**
+   * Whether the configured length of the trace has been produced
+   */
+  [[nodiscard]] bool eof() const;
+
+  [[nodiscard]] const synthetic_trace_parameters& parameters() const { return params; }
+
+  /**
+   * The number of basic blocks in the static program
+   */
+  [[nodiscard]] std::size_t num_blocks() const { return std::size(blocks); }
+};
+
+/**
+ * Write the configured length of the synthetic trace, as input_instr records, to the stream.
+ *
+ * \throws std::invalid_argument if the trace has no length
+ */
+template <typename Stream>
+void write_synthetic_trace(Stream& out, const synthetic_trace_parameters& params)
+{
+  if (params.length == 0) {
+    throw std::invalid_argument{"A synthetic trace must have a length to be written"};
+  }
+
+  synthetic_trace_generator gen{params};
+  while (!gen.eof()) {
+    auto instr = gen();
+    out.write(reinterpret_cast<const char*>(&instr), sizeof(instr)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+}
+} // namespace champsim
+
+#endif
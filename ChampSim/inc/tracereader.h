@@ -21,10 +21,13 @@
 #include <deque>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <string>
 #include <type_traits>
 
+#include "code_layout.h"
 #include "instruction.h"
+#include "synthetic_trace.h"
 #include "util/detect.h"
 
 namespace champsim
@@ -138,6 +141,43 @@ ooo_model_instr bulk_tracereader<T, F>::operator()()
   return retval;
 }
 
+/**
+ * A reader that produces the instructions of a synthetic workload instead of reading them from a file.
+ * The trace name is the synthetic trace prefix followed by the parameters, as accepted by parse_synthetic_trace_parameters().
+ */
+class synthetic_tracereader
+{
+  uint8_t cpu;
+  synthetic_trace_generator generator;
+  std::optional<ooo_model_instr> lookahead{};
+  bool eof_ = false;
+
+public:
+  synthetic_tracereader(uint8_t cpu_idx, synthetic_trace_parameters params);
+  synthetic_tracereader(uint8_t cpu_idx, std::string_view name);
+
+  ooo_model_instr operator()();
+
+  [[nodiscard]] bool eof() const { return eof_; }
+};
+
+/**
+ * A reader that moves the code of another reader to a new layout, to evaluate a code layout optimization without recompiling the traced program.
+ * The instruction pointers and branch targets are remapped, and everything else passes through unchanged.
+ */
+class code_layout_tracereader
+{
+  tracereader inner;
+  code_layout layout;
+
+public:
+  code_layout_tracereader(tracereader reader, code_layout new_layout);
+
+  ooo_model_instr operator()();
+
+  [[nodiscard]] bool eof() const { return inner.eof(); }
+};
+
 std::string get_fptr_cmd(std::string_view fname);
 } // namespace champsim
 
@@ -0,0 +1,85 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UOP_CACHE_H
+#define UOP_CACHE_H
+
+#include <cstdint>
+#include <set>
+#include <vector>
+
+#include "address.h"
+#include "champsim.h"
+
+namespace champsim
+{
+/**
+ * A micro-op cache, which holds the decoded instructions of recently executed code windows.
+ *
+ * Each line holds the micro-ops of a single window, up to a fixed number, and a window may occupy only a limited number of lines of its set.
+ * Unlike the DIB, an instruction hits only if its micro-ops were placed in a line, so a window whose code does not fit is partly or entirely
+ * missing from the cache. Each instruction is assumed to decode into a single micro-op.
+ */
+class uop_cache
+{
+public:
+  /**
+   * :param sets: the number of sets
+   * :param ways: the number of lines in each set
+   * :param window_size: the size in bytes of the aligned code window whose micro-ops share lines
+   * :param uops_per_line: the micro-ops held by each line
+   * :param lines_per_window: the most lines one window may occupy
+   * :param partial_windows: whether a window that needs more lines than it may occupy keeps the micro-ops that fit. If not, all of the lines of the
+   * window are evicted when it overflows, and the window is never filled again.
+   */
+  uop_cache(std::size_t sets, std::size_t ways, std::size_t window_size, std::size_t uops_per_line, std::size_t lines_per_window, bool partial_windows);
+
+  /**
+   * Check whether the micro-op of the instruction at the given address is cached, and update the replacement state if so.
+   */
+  [[nodiscard]] bool check_hit(champsim::address ip);
+
+  /**
+   * Place the micro-op of a decoded instruction in the cache.
+   */
+  void fill(champsim::address ip);
+
+  /**
+   * The micro-ops of the given window that are cached
+   */
+  [[nodiscard]] std::size_t occupancy(champsim::address ip) const;
+
+private:
+  struct line_type {
+    uint64_t window = 0;
+    std::vector<champsim::address> uops{};
+    uint64_t last_used = 0;
+  };
+
+  const std::size_t NUM_SET, NUM_WAY, UOPS_PER_LINE, LINES_PER_WINDOW;
+  const champsim::data::bits WINDOW_BITS;
+  const bool PARTIAL_WINDOWS;
+  std::vector<std::vector<line_type>> sets;
+  std::set<uint64_t> overflowed_windows{}; // windows that do not fit, if partial windows are not kept
+  uint64_t access_count = 0;
+
+  [[nodiscard]] uint64_t window_of(champsim::address ip) const;
+  [[nodiscard]] std::vector<line_type>& set_of(uint64_t window);
+  [[nodiscard]] const std::vector<line_type>& set_of(uint64_t window) const;
+};
+} // namespace champsim
+
+#endif
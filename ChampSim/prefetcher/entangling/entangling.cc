@@ -0,0 +1,158 @@
+#include "entangling.h"
+
+#include <algorithm>
+#include <fmt/core.h>
+
+#include "cache.h"
+
+std::size_t entangling::capacity(unsigned delta_bits) { return std::min<std::size_t>(MAX_DESTINATIONS, PAYLOAD_BITS / std::max(delta_bits, 1u)); }
+
+unsigned entangling::delta_bits(champsim::block_number::difference_type delta)
+{
+  // The magnitude, plus a sign bit
+  auto magnitude = static_cast<uint64_t>(delta < 0 ? -delta : delta);
+  unsigned bits = 1;
+  while (magnitude > 0) {
+    ++bits;
+    magnitude >>= 1;
+  }
+  return bits;
+}
+
+uint32_t entangling::prefetcher_cache_operate(champsim::address addr, champsim::address ip, uint8_t cache_hit, bool useful_prefetch, access_type type,
+                                              uint32_t metadata_in)
+{
+  if (type == access_type::PREFETCH) {
+    return metadata_in;
+  }
+
+  champsim::block_number block{addr};
+
+  if (useful_prefetch) {
+    auto found = prefetched.invalidate({block, {}});
+    if (found.has_value()) {
+      train(found->source, block, true);
+    }
+  }
+
+  if (!cache_hit && inflight_misses.count(block) == 0) {
+    inflight_misses.insert_or_assign(block, history_entry{block, cycle});
+  }
+
+  // Consecutive accesses to one block are a single entry in the history
+  if (std::empty(history) || history.back().block != block) {
+    history.push_back({block, cycle});
+    if (std::size(history) > HISTORY_SIZE) {
+      history.pop_front();
+    }
+  }
+
+  auto found = table.check_hit({block, {}});
+  if (found.has_value()) {
+    for (auto dest : found->destinations) {
+      champsim::block_number pf_block{block + dest.delta};
+      if (dest.confidence > 0 && prefetch_line(champsim::address{pf_block}, true, 0)) {
+        prefetched.fill({pf_block, block});
+        ++stats.prefetches_issued;
+      }
+    }
+  }
+
+  return metadata_in;
+}
+
+uint32_t entangling::prefetcher_cache_fill(champsim::address addr, long set, long way, uint8_t prefetch, champsim::address evicted_addr,
+                                           uint32_t metadata_in)
+{
+  // A prefetched block that leaves the cache before it was used lowers the confidence of its entanglement
+  if (evicted_addr != champsim::address{}) {
+    auto evicted = prefetched.invalidate({champsim::block_number{evicted_addr}, {}});
+    if (evicted.has_value()) {
+      train(evicted->source, evicted->block, false);
+    }
+  }
+
+  champsim::block_number block{addr};
+  auto miss = inflight_misses.find(block);
+  if (miss == std::end(inflight_misses)) {
+    return metadata_in;
+  }
+
+  // The source is the latest access that preceded the miss by at least the miss latency
+  auto latency = cycle - miss->second.cycle;
+  auto is_early_enough = [deadline = miss->second.cycle - std::min(latency, miss->second.cycle)](const history_entry& x) { return x.cycle <= deadline; };
+  auto source = std::find_if(std::rbegin(history), std::rend(history), is_early_enough);
+  if (source == std::rend(history) && !std::empty(history)) {
+    source = std::prev(std::rend(history)); // the oldest access is the best that can be done
+  }
+  if (source != std::rend(history) && source->block != block) {
+    entangle(source->block, block);
+  }
+
+  inflight_misses.erase(miss);
+  return metadata_in;
+}
+
+void entangling::entangle(champsim::block_number source, champsim::block_number destination)
+{
+  auto entry = table.check_hit({source, {}}).value_or(table_entry{source, {}});
+  auto delta = champsim::offset(source, destination);
+
+  auto found = std::find_if(std::begin(entry.destinations), std::end(entry.destinations), [delta](const auto& x) { return x.delta == delta; });
+  if (found != std::end(entry.destinations)) {
+    found->confidence = std::min(found->confidence + 1, MAX_CONFIDENCE);
+  } else {
+    entry.destinations.push_back({delta, MAX_CONFIDENCE});
+    ++stats.entangled;
+  }
+
+  // Wider deltas leave room for fewer destinations, so the least confident are dropped until the rest fit
+  auto widest = [](const auto& dests) {
+    unsigned bits = 0;
+    for (auto dest : dests) {
+      bits = std::max(bits, delta_bits(dest.delta));
+    }
+    return bits;
+  };
+  while (std::size(entry.destinations) > capacity(widest(entry.destinations))) {
+    auto victim = std::min_element(std::begin(entry.destinations), std::end(entry.destinations),
+                                   [](const auto& x, const auto& y) { return x.confidence < y.confidence; });
+    entry.destinations.erase(victim);
+    ++stats.destinations_dropped;
+  }
+
+  table.fill(entry);
+}
+
+void entangling::train(champsim::block_number source, champsim::block_number destination, bool useful)
+{
+  if (useful) {
+    ++stats.useful;
+  } else {
+    ++stats.useless;
+  }
+
+  auto entry = table.check_hit({source, {}});
+  if (!entry.has_value()) {
+    return;
+  }
+
+  auto delta = champsim::offset(source, destination);
+  auto found = std::find_if(std::begin(entry->destinations), std::end(entry->destinations), [delta](const auto& x) { return x.delta == delta; });
+  if (found != std::end(entry->destinations)) {
+    if (useful) {
+      found->confidence = std::min(found->confidence + 1, MAX_CONFIDENCE);
+    } else if (found->confidence > 0) {
+      --found->confidence;
+    }
+    table.fill(entry.value());
+  }
+}
+
+void entangling::prefetcher_cycle_operate() { ++cycle; }
+
+void entangling::prefetcher_final_stats()
+{
+  fmt::print("Entangling pairs: {} dropped: {}\n", stats.entangled, stats.destinations_dropped);
+  fmt::print("Entangling prefetches issued: {} useful: {} useless: {}\n", stats.prefetches_issued, stats.useful, stats.useless);
+}
@@ -0,0 +1,90 @@
+#ifndef PREFETCHER_ENTANGLING_H
+#define PREFETCHER_ENTANGLING_H
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <vector>
+
+#include "address.h"
+#include "champsim.h"
+#include "modules.h"
+#include "msl/lru_table.h"
+
+/*
+ * An entangling instruction prefetcher.
+ *
+ * Each demand miss is timed from its access to its fill. The block that was accessed about that long before the miss (the source) is the
+ * latest point at which a prefetch of the missed block (the destination) would have been timely, so the two are entangled. A later access
+ * to the source prefetches its destinations. Destinations are stored as deltas from the source, so an entry holds more of them when they
+ * are close to it.
+ */
+struct entangling : public champsim::modules::prefetcher {
+  constexpr static std::size_t HISTORY_SIZE = 16;
+  constexpr static std::size_t TABLE_SETS = 256;
+  constexpr static std::size_t TABLE_WAYS = 16;
+  constexpr static unsigned PAYLOAD_BITS = 63; // the bits of an entry available for destinations
+  constexpr static std::size_t MAX_DESTINATIONS = 6;
+  constexpr static unsigned MAX_CONFIDENCE = 3;
+  constexpr static std::size_t TRACKER_SETS = 64;
+  constexpr static std::size_t TRACKER_WAYS = 8;
+
+  struct history_entry {
+    champsim::block_number block{};
+    uint64_t cycle = 0;
+  };
+
+  struct destination_type {
+    champsim::block_number::difference_type delta{};
+    unsigned confidence = 0;
+  };
+
+  struct table_entry {
+    champsim::block_number source{};
+    std::vector<destination_type> destinations{};
+
+    auto index() const { return source; }
+    auto tag() const { return source; }
+  };
+
+  // A prefetched block that has not yet been used, and the source that prefetched it
+  struct prefetched_entry {
+    champsim::block_number block{};
+    champsim::block_number source{};
+
+    auto index() const { return block; }
+    auto tag() const { return block; }
+  };
+
+  std::deque<history_entry> history{};
+  std::map<champsim::block_number, history_entry> inflight_misses{}; // each demand miss, and the head of the history when it missed
+  champsim::msl::lru_table<table_entry> table{TABLE_SETS, TABLE_WAYS};
+  champsim::msl::lru_table<prefetched_entry> prefetched{TRACKER_SETS, TRACKER_WAYS};
+  uint64_t cycle = 0;
+
+  struct stats_type {
+    uint64_t entangled = 0;
+    uint64_t destinations_dropped = 0;
+    uint64_t prefetches_issued = 0;
+    uint64_t useful = 0;
+    uint64_t useless = 0;
+  } stats{};
+
+  using champsim::modules::prefetcher::prefetcher;
+
+  uint32_t prefetcher_cache_operate(champsim::address addr, champsim::address ip, uint8_t cache_hit, bool useful_prefetch, access_type type,
+                                    uint32_t metadata_in);
+  uint32_t prefetcher_cache_fill(champsim::address addr, long set, long way, uint8_t prefetch, champsim::address evicted_addr, uint32_t metadata_in);
+  void prefetcher_cycle_operate();
+  void prefetcher_final_stats();
+
+  // The number of destinations that fit in one entry, if the widest delta needs this many bits
+  static std::size_t capacity(unsigned delta_bits);
+  static unsigned delta_bits(champsim::block_number::difference_type delta);
+
+private:
+  void entangle(champsim::block_number source, champsim::block_number destination);
+  void train(champsim::block_number source, champsim::block_number destination, bool useful);
+};
+
+#endif
@@ -18,7 +18,6 @@ void fdip::prefetcher_initialize()
     miss_tracker[i].miss_counter = 0;
   }
 
-  ftq_head = 0;
   prefetch_scan_ptr = 0;
   cycle_count = 0;
   last_miss_reset = 0;
@@ -30,9 +29,10 @@ uint32_t fdip::prefetcher_cache_operate(champsim::address addr, champsim::addres
 
   champsim::block_number cl_addr{addr};
 
-  // Add to FTQ - this simulates the branch predictor feeding the FTQ
-  // In a real implementation, this would come from the BP unit
-  add_to_ftq(addr, ip, false);
+  // Instruction fetch consumes the FTQ
+  if (type == access_type::IFETCH) {
+    advance_ftq(addr);
+  }
 
   // Track cache misses for filtering
   if (!cache_hit) {
@@ -67,9 +67,18 @@ void fdip::prefetcher_cycle_operate()
 
   // Issue prefetches from the prefetch queue
   issue_prefetches();
+}
 
-  // Advance FTQ head (simulating instruction fetch consuming entries)
-  advance_ftq();
+void fdip::prefetcher_ftq_enqueue(champsim::address fetch_addr, bool wrong_path) { add_to_ftq(fetch_addr, wrong_path); }
+
+void fdip::prefetcher_branch_operate(champsim::address ip, uint8_t, champsim::address, champsim::branch_confidence confidence)
+{
+  // The branch was predicted after its block was enqueued, so mark the newest entry for that block
+  champsim::block_number cl_addr{ip};
+  auto it = std::find_if(ftq.rbegin(), ftq.rend(), [cl_addr](const ftq_entry& e) { return champsim::block_number{e.fetch_addr} == cl_addr; });
+  if (it != ftq.rend()) {
+    it->branch_confidence = std::min(it->branch_confidence, confidence);
+  }
 }
 
 uint32_t fdip::prefetcher_cache_fill(champsim::address addr, long set, long way, uint8_t prefetch, champsim::address evicted_addr, uint32_t metadata_in)
@@ -97,6 +106,8 @@ void fdip::prefetcher_final_stats()
   std::cout << "Total Prefetches: " << total_prefetches << std::endl;
   std::cout << "Useful Prefetches: " << useful_prefetches << std::endl;
   std::cout << "Filtered Prefetches: " << filtered_prefetches << std::endl;
+  std::cout << "Wrong-Path FTQ Entries: " << wrong_path_enqueues << std::endl;
+  std::cout << "Lookahead Capped by Branch Confidence: " << lookahead_caps << " cycles" << std::endl;
   if (total_prefetches > 0) {
     std::cout << "Prefetch Accuracy: " << (100.0 * useful_prefetches / total_prefetches) << "%" << std::endl;
   }
@@ -104,11 +115,18 @@ void fdip::prefetcher_final_stats()
 
 // Private helper functions
 
-void fdip::add_to_ftq(champsim::address addr, champsim::address ip, bool is_branch)
+void fdip::add_to_ftq(champsim::address addr, bool wrong_path)
 {
-  // Check if FTQ is full
+  // The core has squashed the wrong path once it enqueues the correct path again
+  if (!wrong_path) {
+    ftq.erase(std::remove_if(ftq.begin(), ftq.end(), [](const ftq_entry& e) { return e.wrong_path; }), ftq.end());
+  } else {
+    wrong_path_enqueues++;
+  }
+
+  // If the core's FTQ is deeper than ours, forget the oldest entries
   if (ftq.size() >= FTQ_SIZE) {
-    return;
+    ftq.pop_front();
   }
 
   champsim::block_number cl_addr{addr};
@@ -122,11 +140,10 @@ void fdip::add_to_ftq(champsim::address addr, champsim::address ip, bool is_bran
 
   ftq_entry entry;
   entry.fetch_addr = addr;
-  entry.ip = ip;
-  entry.is_branch = is_branch;
   entry.prefetch_candidate = false;
   entry.enqueued = false;
   entry.confidence = 0;
+  entry.wrong_path = wrong_path;
 
   ftq.push_back(entry);
 }
@@ -135,7 +152,10 @@ void fdip::scan_ftq_for_prefetches()
 {
   // Scan FTQ entries from lookahead start to end positions
   size_t scan_start = std::min(static_cast<size_t>(FTQ_LOOKAHEAD_START), ftq.size());
-  size_t scan_end = std::min(static_cast<size_t>(FTQ_LOOKAHEAD_END), ftq.size());
+  size_t scan_end = lookahead_end();
+  if (scan_end < std::min(static_cast<size_t>(FTQ_LOOKAHEAD_END), ftq.size())) {
+    lookahead_caps++;
+  }
 
   for (size_t i = scan_start; i < scan_end; i++) {
     auto& entry = ftq[i];
@@ -154,6 +174,32 @@ void fdip::scan_ftq_for_prefetches()
   }
 }
 
+size_t fdip::lookahead_end() const
+{
+  size_t static_end = std::min(static_cast<size_t>(FTQ_LOOKAHEAD_END), ftq.size());
+
+  // Blocks past several low-confidence branches are likely on the wrong path, so the lookahead ends at the branch that exhausts the budget
+  unsigned uncertainty = 0;
+  for (size_t i = 0; i < static_end; i++) {
+    switch (ftq[i].branch_confidence) {
+    case champsim::branch_confidence::low:
+      uncertainty += 2;
+      break;
+    case champsim::branch_confidence::medium:
+      uncertainty += 1;
+      break;
+    case champsim::branch_confidence::high:
+      break;
+    }
+
+    if (uncertainty > MAX_LOOKAHEAD_UNCERTAINTY) {
+      return i + 1;
+    }
+  }
+
+  return static_end;
+}
+
 bool fdip::should_prefetch(const ftq_entry& entry)
 {
   champsim::address addr = entry.fetch_addr;
@@ -304,11 +350,13 @@ bool fdip::is_marked_evicted(champsim::address addr)
   return false;
 }
 
-void fdip::advance_ftq()
+void fdip::advance_ftq(champsim::address fetched_addr)
 {
-  // Remove oldest entries that have been "consumed" by instruction fetch
-  // In a real implementation, this would be driven by actual fetch
-  if (!ftq.empty() && ftq.size() > FTQ_LOOKAHEAD_END) {
-    ftq.pop_front();
+  // Retire the entries up to the block that instruction fetch has reached
+  champsim::block_number cl_addr{fetched_addr};
+  auto it = std::find_if(ftq.begin(), ftq.end(), [cl_addr](const ftq_entry& e) { return champsim::block_number{e.fetch_addr} == cl_addr; });
+
+  if (it != ftq.end()) {
+    ftq.erase(ftq.begin(), std::next(it));
   }
-}
\ No newline at end of file
+}
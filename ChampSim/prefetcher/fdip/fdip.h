@@ -12,14 +12,14 @@
 
 struct fdip : public champsim::modules::prefetcher {
     
-    // FTQ Entry - stores predicted fetch blocks
+    // FTQ Entry - mirrors a fetch block enqueued by the core's branch prediction unit
     struct ftq_entry {
         champsim::address fetch_addr{};     // Fetch block address
-        champsim::address ip{};             // Instruction pointer that led here
-        bool is_branch{false};              // Is this a branch target?
         bool prefetch_candidate{false};     // Should we prefetch this?
         bool enqueued{false};               // Already in prefetch queue?
         uint64_t confidence{0};             // Confidence counter
+        bool wrong_path{false};             // Enqueued past a mispredicted branch
+        champsim::branch_confidence branch_confidence{champsim::branch_confidence::high}; // Least confident prediction of the block's branches
         
         auto index() const {
             using namespace champsim::data::data_literals;
@@ -75,6 +75,7 @@ struct fdip : public champsim::modules::prefetcher {
     static constexpr int PREFETCH_DEGREE = 3;
     static constexpr int FTQ_LOOKAHEAD_START = 2;  // Start from 2nd entry
     static constexpr int FTQ_LOOKAHEAD_END = 10;   // Up to 10th entry
+    static constexpr unsigned MAX_LOOKAHEAD_UNCERTAINTY = 3; // Stop looking ahead past branches this uncertain (low = 2, medium = 1)
     static constexpr uint64_t MISS_COUNTER_RESET_INTERVAL = 1000000;
     
     // Data structures
@@ -87,13 +88,14 @@ struct fdip : public champsim::modules::prefetcher {
     // Counters and state
     uint64_t cycle_count{0};
     uint64_t last_miss_reset{0};
-    uint32_t ftq_head{0};  // Current FTQ head for instruction fetch
     uint32_t prefetch_scan_ptr{0};  // Pointer for scanning FTQ for prefetches
     
     // Statistics
     uint64_t total_prefetches{0};
     uint64_t useful_prefetches{0};
     uint64_t filtered_prefetches{0};
+    uint64_t wrong_path_enqueues{0};
+    uint64_t lookahead_caps{0};     // Cycles where low-confidence branches shortened the lookahead
     
 public:
     using champsim::modules::prefetcher::prefetcher;
@@ -105,6 +107,11 @@ public:
                                      access_type type, uint32_t metadata_in) ;
     
     void prefetcher_cycle_operate() ;
+
+    void prefetcher_ftq_enqueue(champsim::address fetch_addr, bool wrong_path) ;
+
+    void prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target,
+                                   champsim::branch_confidence confidence) ;
     
     uint32_t prefetcher_cache_fill(champsim::address addr, long set, long way, 
                                    uint8_t prefetch, champsim::address evicted_addr, 
@@ -114,8 +121,9 @@ public:
     
 private:
     // Helper functions
-    void add_to_ftq(champsim::address addr, champsim::address ip, bool is_branch);
+    void add_to_ftq(champsim::address addr, bool wrong_path);
     void scan_ftq_for_prefetches();
+    size_t lookahead_end() const;
     bool should_prefetch(const ftq_entry& entry);
     bool cache_probe_filter(champsim::address addr);
     void enqueue_prefetch(champsim::address addr);
@@ -124,7 +132,7 @@ private:
     bool is_high_miss_set(champsim::address addr);
     void mark_evicted(champsim::address addr);
     bool is_marked_evicted(champsim::address addr);
-    void advance_ftq();
+    void advance_ftq(champsim::address fetched_addr);
 };
 
 #endif // FDIP_H
\ No newline at end of file
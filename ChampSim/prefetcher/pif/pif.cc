@@ -0,0 +1,196 @@
+#include "pif.h"
+
+#include <algorithm>
+#include <fmt/core.h>
+
+#include "cache.h"
+
+namespace
+{
+// The position of a block in the neighbour bit vector of a record, if the record covers it
+std::optional<std::size_t> neighbour_bit(champsim::block_number trigger, champsim::block_number block)
+{
+  auto distance = champsim::offset(trigger, block);
+  if (distance < 0 && static_cast<std::size_t>(-distance) <= pif::PRECEDING_BLOCKS) {
+    return pif::PRECEDING_BLOCKS - static_cast<std::size_t>(-distance);
+  }
+  if (distance > 0 && static_cast<std::size_t>(distance) <= pif::SUCCEEDING_BLOCKS) {
+    return pif::PRECEDING_BLOCKS + static_cast<std::size_t>(distance) - 1;
+  }
+  return std::nullopt;
+}
+} // namespace
+
+bool pif::region_record::contains(champsim::block_number block) const
+{
+  if (block == trigger) {
+    return true;
+  }
+  auto bit = neighbour_bit(trigger, block);
+  return bit.has_value() && neighbours.test(bit.value());
+}
+
+bool pif::region_record::set(champsim::block_number block)
+{
+  if (block == trigger) {
+    return true;
+  }
+  auto bit = neighbour_bit(trigger, block);
+  if (bit.has_value()) {
+    neighbours.set(bit.value());
+  }
+  return bit.has_value();
+}
+
+std::vector<champsim::block_number> pif::region_record::blocks() const
+{
+  std::vector<champsim::block_number> retval{trigger};
+  for (std::size_t bit = 0; bit < std::size(neighbours); ++bit) {
+    if (neighbours.test(bit)) {
+      auto distance = static_cast<champsim::block_number::difference_type>(bit) - static_cast<champsim::block_number::difference_type>(PRECEDING_BLOCKS);
+      retval.push_back(trigger + (distance < 0 ? distance : distance + 1));
+    }
+  }
+  return retval;
+}
+
+void pif::prefetcher_retire(champsim::address ip)
+{
+  champsim::block_number block{ip};
+  if (current_record.has_value() && current_record->set(block)) {
+    return;
+  }
+
+  // The stream has left the region, so the record is complete
+  if (current_record.has_value()) {
+    record(current_record.value());
+  }
+  current_record = region_record{block, {}};
+}
+
+void pif::record(const region_record& rec)
+{
+  // The temporal compactor drops records that repeat one of the last few, such as the iterations of a loop
+  auto repeats = [&rec](const region_record& other) {
+    return other.trigger == rec.trigger && (other.neighbours | rec.neighbours) == other.neighbours;
+  };
+  if (std::any_of(std::begin(compactor), std::end(compactor), repeats)) {
+    ++stats.records_compacted;
+    return;
+  }
+  compactor.push_back(rec);
+  if (std::size(compactor) > COMPACTOR_SIZE) {
+    compactor.pop_front();
+  }
+
+  history.at(history_count % HISTORY_SIZE) = rec;
+  index.fill({rec.trigger, history_count});
+  ++history_count;
+  ++stats.records_written;
+}
+
+auto pif::read_history(uint64_t position) const -> std::optional<region_record>
+{
+  // Positions that have been overwritten, or not yet written, are not available
+  if (position >= history_count || history_count - position > HISTORY_SIZE) {
+    return std::nullopt;
+  }
+  return history.at(position % HISTORY_SIZE);
+}
+
+void pif::advance(stream_type& stream, uint64_t ready_cycle)
+{
+  while (std::size(stream.window) <= LOOKAHEAD) {
+    auto rec = read_history(stream.next_position);
+    if (!rec.has_value()) {
+      return;
+    }
+
+    // Each new block of the virtualized history must be read from the LLC
+    if constexpr (METADATA_IN_LLC) {
+      if (stream.next_position % RECORDS_PER_BLOCK == 0) {
+        ready_cycle += METADATA_LATENCY;
+        ++stats.metadata_reads;
+      }
+    }
+
+    ++stream.next_position;
+    stream.window.push_back(rec.value());
+    enqueue_prefetches(rec.value(), ready_cycle);
+  }
+}
+
+void pif::enqueue_prefetches(const region_record& rec, uint64_t ready_cycle)
+{
+  for (auto block : rec.blocks()) {
+    champsim::address pf_addr{block};
+    auto queued = [pf_addr](const pending_prefetch& pf) { return pf.addr == pf_addr; };
+    if (std::size(prefetch_queue) < PREFETCH_QUEUE_SIZE && std::none_of(std::begin(prefetch_queue), std::end(prefetch_queue), queued)) {
+      prefetch_queue.push_back({pf_addr, ready_cycle});
+    }
+  }
+}
+
+uint32_t pif::prefetcher_cache_operate(champsim::address addr, champsim::address ip, uint8_t cache_hit, bool useful_prefetch, access_type type,
+                                       uint32_t metadata_in)
+{
+  champsim::block_number block{addr};
+
+  // Fetch has reached one of the records of a stream, so the stream moves ahead
+  for (auto& stream : streams) {
+    auto reached = std::find_if(std::begin(stream.window), std::end(stream.window), [block](const auto& rec) { return rec.contains(block); });
+    if (reached != std::end(stream.window)) {
+      // The record that fetch is in stays at the head of the window until fetch leaves it
+      stream.window.erase(std::begin(stream.window), reached);
+      stream.last_used = cycle;
+      ++stats.stream_advances;
+      advance(stream, cycle);
+      return metadata_in;
+    }
+  }
+
+  if (cache_hit) {
+    return metadata_in;
+  }
+
+  // A miss that no stream predicted starts a new stream where the block last appeared in the history
+  auto found = index.check_hit({block, 0});
+  if (!found.has_value() || !read_history(found->position).has_value()) {
+    return metadata_in;
+  }
+
+  uint64_t ready_cycle = cycle;
+  if constexpr (METADATA_IN_LLC) {
+    ready_cycle += METADATA_LATENCY;
+    ++stats.metadata_reads;
+  }
+
+  auto victim = std::min_element(std::begin(streams), std::end(streams), [](const auto& x, const auto& y) { return x.last_used < y.last_used; });
+  *victim = stream_type{found->position, {}, cycle};
+  ++stats.streams_started;
+  advance(*victim, ready_cycle);
+
+  return metadata_in;
+}
+
+void pif::prefetcher_cycle_operate()
+{
+  ++cycle;
+
+  for (int issued = 0; issued < PREFETCH_DEGREE && !std::empty(prefetch_queue) && prefetch_queue.front().ready_cycle <= cycle; ++issued) {
+    if (!prefetch_line(prefetch_queue.front().addr, true, 0)) {
+      return; // try again next cycle
+    }
+    ++stats.prefetches_issued;
+    prefetch_queue.pop_front();
+  }
+}
+
+void pif::prefetcher_final_stats()
+{
+  fmt::print("PIF records written: {} compacted: {}\n", stats.records_written, stats.records_compacted);
+  fmt::print("PIF streams started: {} advanced: {} prefetches issued: {}\n", stats.streams_started, stats.stream_advances, stats.prefetches_issued);
+  if constexpr (METADATA_IN_LLC) {
+    fmt::print("PIF metadata reads from the LLC: {}\n", stats.metadata_reads);
+  }
+}
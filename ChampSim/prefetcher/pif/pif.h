@@ -0,0 +1,103 @@
+#ifndef PREFETCHER_PIF_H
+#define PREFETCHER_PIF_H
+
+#include <bitset>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <vector>
+
+#include "address.h"
+#include "champsim.h"
+#include "modules.h"
+#include "msl/lru_table.h"
+
+/*
+ * Proactive instruction fetch (PIF): a temporal instruction prefetcher.
+ *
+ * The retired instruction stream is compacted into spatial region records, each a trigger block and a bit vector of the neighbouring
+ * blocks that were used before the stream left the region. The records are appended to a circular history buffer, and an index maps each
+ * trigger block to its most recent position in the history. A miss in the L1I that finds its block in the index starts a stream, which
+ * replays the history from that point, a fixed number of records ahead of fetch.
+ */
+struct pif : public champsim::modules::prefetcher {
+  constexpr static std::size_t PRECEDING_BLOCKS = 2;  // blocks before the trigger covered by a record
+  constexpr static std::size_t SUCCEEDING_BLOCKS = 5; // blocks after the trigger covered by a record
+  constexpr static std::size_t HISTORY_SIZE = 32 * 1024;
+  constexpr static std::size_t INDEX_SETS = 2048;
+  constexpr static std::size_t INDEX_WAYS = 4;
+  constexpr static std::size_t NUM_STREAMS = 4;
+  constexpr static std::size_t LOOKAHEAD = 4; // records prefetched ahead of fetch by each stream
+  constexpr static std::size_t COMPACTOR_SIZE = 4;
+  constexpr static std::size_t PREFETCH_QUEUE_SIZE = 64;
+  constexpr static int PREFETCH_DEGREE = 4; // prefetches issued per cycle
+
+  // If true, the history and index are virtualized into the LLC: they are not charged as dedicated storage, but each read of the index,
+  // and of each block of history records, waits for an LLC access before its prefetches can issue.
+  constexpr static bool METADATA_IN_LLC = false;
+  constexpr static uint64_t METADATA_LATENCY = 20;
+  constexpr static std::size_t RECORDS_PER_BLOCK = 8;
+
+  struct region_record {
+    champsim::block_number trigger{};
+    std::bitset<PRECEDING_BLOCKS + SUCCEEDING_BLOCKS> neighbours{};
+
+    [[nodiscard]] bool contains(champsim::block_number block) const;
+    bool set(champsim::block_number block);
+    [[nodiscard]] std::vector<champsim::block_number> blocks() const;
+  };
+
+  struct index_entry {
+    champsim::block_number trigger{};
+    uint64_t position = 0; // the sequence number of the record in the history
+
+    auto index() const { return trigger; }
+    auto tag() const { return trigger; }
+  };
+
+  struct stream_type {
+    uint64_t next_position = 0;          // the next record of the history to be prefetched
+    std::deque<region_record> window{};  // the record that fetch is in, followed by the records prefetched ahead of it
+    uint64_t last_used = 0;
+  };
+
+  struct pending_prefetch {
+    champsim::address addr{};
+    uint64_t ready_cycle = 0;
+  };
+
+  std::vector<region_record> history = std::vector<region_record>(HISTORY_SIZE);
+  uint64_t history_count = 0; // the number of records ever written
+  champsim::msl::lru_table<index_entry> index{INDEX_SETS, INDEX_WAYS};
+  std::deque<region_record> compactor{};
+  std::optional<region_record> current_record{};
+
+  std::vector<stream_type> streams = std::vector<stream_type>(NUM_STREAMS);
+  std::deque<pending_prefetch> prefetch_queue{};
+  uint64_t cycle = 0;
+
+  struct stats_type {
+    uint64_t records_written = 0;
+    uint64_t records_compacted = 0;
+    uint64_t streams_started = 0;
+    uint64_t stream_advances = 0;
+    uint64_t metadata_reads = 0;
+    uint64_t prefetches_issued = 0;
+  } stats{};
+
+  using champsim::modules::prefetcher::prefetcher;
+
+  uint32_t prefetcher_cache_operate(champsim::address addr, champsim::address ip, uint8_t cache_hit, bool useful_prefetch, access_type type,
+                                    uint32_t metadata_in);
+  void prefetcher_cycle_operate();
+  void prefetcher_retire(champsim::address ip);
+  void prefetcher_final_stats();
+
+private:
+  void record(const region_record& rec);
+  [[nodiscard]] std::optional<region_record> read_history(uint64_t position) const;
+  void advance(stream_type& stream, uint64_t ready_cycle);
+  void enqueue_prefetches(const region_record& rec, uint64_t ready_cycle);
+};
+
+#endif
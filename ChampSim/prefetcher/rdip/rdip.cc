@@ -0,0 +1,147 @@
+#include "rdip.h"
+
+#include <algorithm>
+#include <fmt/core.h>
+
+#include "cache.h"
+#include "instruction.h"
+
+bool rdip::miss_record::add(champsim::block_number block)
+{
+  if (block == trigger) {
+    return true;
+  }
+  auto distance = champsim::offset(trigger, block);
+  if (distance > 0 && static_cast<std::size_t>(distance) <= RECORD_BLOCKS) {
+    following.set(static_cast<std::size_t>(distance) - 1);
+    return true;
+  }
+  return false;
+}
+
+std::vector<champsim::block_number> rdip::miss_record::blocks() const
+{
+  std::vector<champsim::block_number> retval{trigger};
+  for (std::size_t bit = 0; bit < RECORD_BLOCKS; ++bit) {
+    if (following.test(bit)) {
+      retval.push_back(trigger + static_cast<champsim::block_number::difference_type>(bit + 1));
+    }
+  }
+  return retval;
+}
+
+uint64_t rdip::current_signature(bool is_return) const
+{
+  // Calls and returns to the same stack are different contexts, since they are followed by different code
+  uint64_t retval = is_return ? 1 : 0;
+  auto depth = std::min(SIGNATURE_DEPTH, std::size(ras));
+  for (std::size_t i = 0; i < depth; ++i) {
+    auto ret_addr = std::next(std::rbegin(ras), static_cast<long>(i))->to<uint64_t>();
+    retval ^= (ret_addr << i) ^ (ret_addr >> (2 * i + 7));
+  }
+  return retval;
+}
+
+void rdip::prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target)
+{
+  if (branch_type == BRANCH_DIRECT_CALL || branch_type == BRANCH_INDIRECT_CALL) {
+    ras.push_back(ip);
+    if (std::size(ras) > RAS_SIZE) {
+      ras.pop_front();
+    }
+    enter_context(current_signature(false));
+  } else if (branch_type == BRANCH_RETURN) {
+    if (!std::empty(ras)) {
+      ras.pop_back();
+    }
+    enter_context(current_signature(true));
+  }
+}
+
+void rdip::enter_context(uint64_t next_signature)
+{
+  ++stats.context_switches;
+  signature = next_signature;
+
+  auto found = table.check_hit({signature, {}});
+  if (found.has_value()) {
+    ++stats.signature_hits;
+    for (const auto& rec : found->records) {
+      for (auto block : rec.blocks()) {
+        if (prefetch_line(champsim::address{block}, true, 0)) {
+          ++stats.prefetches_issued;
+        }
+      }
+    }
+  }
+}
+
+void rdip::leave_fetch_context(const fetch_context& next)
+{
+  // Attach the misses of the context that is being left to its signature, keeping those that were recorded before
+  if (!std::empty(context_records)) {
+    auto entry = table.check_hit({fetched.signature, {}}).value_or(table_entry{fetched.signature, {}});
+    for (const auto& rec : context_records) {
+      auto same_trigger = std::find_if(std::begin(entry.records), std::end(entry.records), [&rec](const auto& x) { return x.trigger == rec.trigger; });
+      if (same_trigger != std::end(entry.records)) {
+        same_trigger->following |= rec.following;
+      } else {
+        entry.records.push_back(rec);
+      }
+    }
+    while (std::size(entry.records) > RECORDS_PER_SIGNATURE) {
+      entry.records.pop_front();
+    }
+    table.fill(entry);
+    context_records.clear();
+  }
+
+  fetched = next;
+}
+
+void rdip::prefetcher_ftq_enqueue(champsim::address fetch_addr, bool wrong_path)
+{
+  fetch_contexts.push_back({champsim::block_number{fetch_addr}, signature, stats.context_switches});
+  if (std::size(fetch_contexts) > FETCH_CONTEXTS) {
+    fetch_contexts.pop_front();
+  }
+}
+
+uint32_t rdip::prefetcher_cache_operate(champsim::address addr, champsim::address ip, uint8_t cache_hit, bool useful_prefetch, access_type type,
+                                        uint32_t metadata_in)
+{
+  if (type == access_type::PREFETCH) {
+    return metadata_in;
+  }
+
+  // Fetch has reached this block, and the blocks ahead of it in the FTQ have already been fetched
+  champsim::block_number block{addr};
+  auto predicted = std::find_if(std::begin(fetch_contexts), std::end(fetch_contexts), [block](const auto& x) { return x.block == block; });
+  if (predicted != std::end(fetch_contexts)) {
+    if (predicted->switches != fetched.switches) {
+      leave_fetch_context(*predicted);
+    }
+    fetch_contexts.erase(std::begin(fetch_contexts), std::next(predicted));
+  }
+
+  if (cache_hit) {
+    return metadata_in;
+  }
+
+  // Misses close after an earlier miss of the context share its record
+  for (auto& rec : context_records) {
+    if (rec.add(block)) {
+      return metadata_in;
+    }
+  }
+  context_records.push_back({block, {}});
+  if (std::size(context_records) > RECORDS_PER_SIGNATURE) {
+    context_records.pop_front();
+  }
+  return metadata_in;
+}
+
+void rdip::prefetcher_final_stats()
+{
+  fmt::print("RDIP context switches: {} signature hits: {} prefetches issued: {}\n", stats.context_switches, stats.signature_hits, stats.prefetches_issued);
+}
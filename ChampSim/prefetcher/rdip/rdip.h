@@ -0,0 +1,83 @@
+#ifndef PREFETCHER_RDIP_H
+#define PREFETCHER_RDIP_H
+
+#include <bitset>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "address.h"
+#include "champsim.h"
+#include "modules.h"
+#include "msl/lru_table.h"
+
+/*
+ * A return-address-stack-directed instruction prefetcher (RDIP).
+ *
+ * The prefetcher keeps its own copy of the return address stack from the calls and returns that the branch prediction unit sees. At each
+ * call or return, the top of the stack is hashed into a signature of the program context. The L1I misses that occur in a context are
+ * associated with its signature, and are prefetched the next time the program enters that context.
+ *
+ * Branch prediction runs ahead of fetch by up to the size of the FTQ, so each block that enters the FTQ is tagged with the signature it was
+ * predicted under. Misses are attributed to the signature of the block that fetch has reached, rather than to the one prediction has reached.
+ */
+struct rdip : public champsim::modules::prefetcher {
+  constexpr static std::size_t RAS_SIZE = 32;
+  constexpr static std::size_t SIGNATURE_DEPTH = 4; // the entries of the stack that are hashed into a signature
+  constexpr static std::size_t TABLE_SETS = 1024;
+  constexpr static std::size_t TABLE_WAYS = 4;
+  constexpr static std::size_t RECORDS_PER_SIGNATURE = 3;
+  constexpr static std::size_t RECORD_BLOCKS = 8;   // blocks after the trigger covered by a miss record
+  constexpr static std::size_t FETCH_CONTEXTS = 64; // the FTQ blocks whose signatures are remembered until they are fetched
+
+  struct miss_record {
+    champsim::block_number trigger{};
+    std::bitset<RECORD_BLOCKS> following{};
+
+    bool add(champsim::block_number block);
+    [[nodiscard]] std::vector<champsim::block_number> blocks() const;
+  };
+
+  struct table_entry {
+    uint64_t signature = 0;
+    std::deque<miss_record> records{};
+
+    auto index() const { return signature; }
+    auto tag() const { return signature; }
+  };
+
+  struct fetch_context {
+    champsim::block_number block{};
+    uint64_t signature = 0;
+    uint64_t switches = 0; // the context switches before the block, so that re-entering the same signature is still a switch
+  };
+
+  std::deque<champsim::address> ras{};
+  uint64_t signature = 0;                     // the context that branch prediction has reached
+  fetch_context fetched{};                    // the context that fetch has reached
+  std::deque<fetch_context> fetch_contexts{}; // the blocks in the FTQ, with the context each was predicted in
+  std::deque<miss_record> context_records{};  // the misses since fetch last changed context
+  champsim::msl::lru_table<table_entry> table{TABLE_SETS, TABLE_WAYS};
+
+  struct stats_type {
+    uint64_t context_switches = 0;
+    uint64_t signature_hits = 0;
+    uint64_t prefetches_issued = 0;
+  } stats{};
+
+  using champsim::modules::prefetcher::prefetcher;
+
+  uint32_t prefetcher_cache_operate(champsim::address addr, champsim::address ip, uint8_t cache_hit, bool useful_prefetch, access_type type,
+                                    uint32_t metadata_in);
+  void prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target);
+  void prefetcher_ftq_enqueue(champsim::address fetch_addr, bool wrong_path);
+  void prefetcher_final_stats();
+
+  [[nodiscard]] uint64_t current_signature(bool is_return) const;
+
+private:
+  void enter_context(uint64_t next_signature);
+  void leave_fetch_context(const fetch_context& next);
+};
+
+#endif
@@ -288,6 +288,21 @@ void spp_dev::SIGNATURE_TABLE::read_and_update_sig(champsim::address addr, uint3
   lru[set][match] = 0; // Promote to the MRU position
 }
 
+void spp_dev::PATTERN_TABLE::increment_counters(uint32_t set, uint32_t way)
+{
+  // Count one more occurrence of the signature, and of the delta in the given way (if any).
+  // When the signature counter would overflow, halve every counter in the set instead.
+  if (c_sig[set].is_max()) {
+    for (uint32_t i = 0; i < PT_WAY; i++)
+      c_delta[set * PT_WAY + i] = (c_delta[set * PT_WAY + i].value() + (i == way ? 1 : 0)) >> 1;
+    c_sig[set] = (C_SIG_MAX + 1) >> 1;
+  } else {
+    if (way < PT_WAY)
+      ++c_delta[set * PT_WAY + way];
+    ++c_sig[set];
+  }
+}
+
 void spp_dev::PATTERN_TABLE::update_pattern(uint32_t last_sig, typename offset_type::difference_type curr_delta)
 {
   // Update (sig, delta) correlation
@@ -296,17 +311,11 @@ void spp_dev::PATTERN_TABLE::update_pattern(uint32_t last_sig, typename offset_t
   // Case 1: Hit
   for (match = 0; match < PT_WAY; match++) {
     if (delta[set][match] == curr_delta) {
-      c_delta[set][match]++;
-      c_sig[set]++;
-      if (c_sig[set] > C_SIG_MAX) {
-        for (uint32_t way = 0; way < PT_WAY; way++)
-          c_delta[set][way] >>= 1;
-        c_sig[set] >>= 1;
-      }
+      increment_counters(set, match);
 
       if constexpr (SPP_DEBUG_PRINT) {
         std::cout << "[PT] " << __func__ << " hit sig: " << std::hex << last_sig << std::dec << " set: " << set << " way: " << match;
-        std::cout << " delta: " << delta[set][match] << " c_delta: " << c_delta[set][match] << " c_sig: " << c_sig[set] << std::endl;
+        std::cout << " delta: " << delta[set][match] << " c_delta: " << c_delta[set * PT_WAY + match].value() << " c_sig: " << c_sig[set].value() << std::endl;
       }
 
       break;
@@ -318,24 +327,20 @@ void spp_dev::PATTERN_TABLE::update_pattern(uint32_t last_sig, typename offset_t
     uint32_t victim_way = PT_WAY, min_counter = C_SIG_MAX;
 
     for (match = 0; match < PT_WAY; match++) {
-      if (c_delta[set][match] < min_counter) { // Select an entry with the minimum c_delta
+      if (c_delta[set * PT_WAY + match] < min_counter) { // Select an entry with the minimum c_delta
         victim_way = match;
-        min_counter = c_delta[set][match];
+        min_counter = static_cast<uint32_t>(c_delta[set * PT_WAY + match].value());
       }
     }
 
     delta[set][victim_way] = curr_delta;
-    c_delta[set][victim_way] = 0;
-    c_sig[set]++;
-    if (c_sig[set] > C_SIG_MAX) {
-      for (uint32_t way = 0; way < PT_WAY; way++)
-        c_delta[set][way] >>= 1;
-      c_sig[set] >>= 1;
-    }
+    c_delta[set * PT_WAY + victim_way] = 0;
+    increment_counters(set, PT_WAY);
 
     if constexpr (SPP_DEBUG_PRINT) {
       std::cout << "[PT] " << __func__ << " miss sig: " << std::hex << last_sig << std::dec << " set: " << set << " way: " << victim_way;
-      std::cout << " delta: " << delta[set][victim_way] << " c_delta: " << c_delta[set][victim_way] << " c_sig: " << c_sig[set] << std::endl;
+      std::cout << " delta: " << delta[set][victim_way] << " c_delta: " << c_delta[set * PT_WAY + victim_way].value() << " c_sig: " << c_sig[set].value()
+                << std::endl;
     }
 
     if constexpr (SPP_SANITY_CHECK) {
@@ -354,10 +359,11 @@ void spp_dev::PATTERN_TABLE::read_pattern(uint32_t curr_sig, std::vector<typenam
   // Update (sig, delta) correlation
   uint32_t set = get_hash(curr_sig) % PT_SET, local_conf = 0, pf_conf = 0, max_conf = 0;
 
-  if (c_sig[set]) {
+  if (auto sig_count = static_cast<uint32_t>(c_sig[set].value()); sig_count != 0) {
     for (uint32_t way = 0; way < PT_WAY; way++) {
-      local_conf = (100 * c_delta[set][way]) / c_sig[set];
-      pf_conf = depth ? (_parent->GHR.global_accuracy * c_delta[set][way] / c_sig[set] * lookahead_conf / 100) : local_conf;
+      auto delta_count = static_cast<uint32_t>(c_delta[set * PT_WAY + way].value());
+      local_conf = (100 * delta_count) / sig_count;
+      pf_conf = depth ? (_parent->GHR.global_accuracy * delta_count / sig_count * lookahead_conf / 100) : local_conf;
 
       if (pf_conf >= PF_THRESHOLD) {
         confidence_q[pf_q_tail] = pf_conf;
@@ -372,13 +378,13 @@ void spp_dev::PATTERN_TABLE::read_pattern(uint32_t curr_sig, std::vector<typenam
 
         if constexpr (SPP_DEBUG_PRINT) {
           std::cout << "[PT] " << __func__ << " HIGH CONF: " << pf_conf << " sig: " << std::hex << curr_sig << std::dec << " set: " << set << " way: " << way;
-          std::cout << " delta: " << delta[set][way] << " c_delta: " << c_delta[set][way] << " c_sig: " << c_sig[set];
+          std::cout << " delta: " << delta[set][way] << " c_delta: " << delta_count << " c_sig: " << sig_count;
           std::cout << " conf: " << local_conf << " depth: " << depth << std::endl;
         }
       } else {
         if constexpr (SPP_DEBUG_PRINT) {
           std::cout << "[PT] " << __func__ << "  LOW CONF: " << pf_conf << " sig: " << std::hex << curr_sig << std::dec << " set: " << set << " way: " << way;
-          std::cout << " delta: " << delta[set][way] << " c_delta: " << c_delta[set][way] << " c_sig: " << c_sig[set];
+          std::cout << " delta: " << delta[set][way] << " c_delta: " << delta_count << " c_sig: " << sig_count;
           std::cout << " conf: " << local_conf << " depth: " << depth << std::endl;
         }
       }
@@ -7,6 +7,7 @@
 #include "cache.h"
 #include "modules.h"
 #include "msl/lru_table.h"
+#include "msl/packed_fwcounter.h"
 
 struct spp_dev : public champsim::modules::prefetcher {
 
@@ -99,19 +100,19 @@ struct spp_dev : public champsim::modules::prefetcher {
   public:
     spp_dev* _parent;
     typename offset_type::difference_type delta[PT_SET][PT_WAY];
-    uint32_t c_delta[PT_SET][PT_WAY], c_sig[PT_SET];
+    champsim::msl::packed_fwcounter_array<champsim::msl::fwcounter<C_DELTA_BIT>, PT_SET * PT_WAY> c_delta; // indexed by set * PT_WAY + way
+    champsim::msl::packed_fwcounter_array<champsim::msl::fwcounter<C_SIG_BIT>, PT_SET> c_sig;
 
     PATTERN_TABLE()
     {
       for (uint32_t set = 0; set < PT_SET; set++) {
         for (uint32_t way = 0; way < PT_WAY; way++) {
           delta[set][way] = 0;
-          c_delta[set][way] = 0;
         }
-        c_sig[set] = 0;
       }
     }
 
+    void increment_counters(uint32_t set, uint32_t way);
     void update_pattern(uint32_t last_sig, typename offset_type::difference_type curr_delta);
     void read_pattern(uint32_t curr_sig, std::vector<typename offset_type::difference_type>& prefetch_delta, std::vector<uint32_t>& confidence_q,
                       uint32_t& lookahead_way, uint32_t& lookahead_conf, uint32_t& pf_q_tail, uint32_t& depth);
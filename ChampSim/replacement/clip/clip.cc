@@ -0,0 +1,57 @@
+#include "clip.h"
+
+#include <algorithm>
+#include <fmt/core.h>
+
+clip::clip(CACHE* cache) : clip(cache, cache->NUM_SET, cache->NUM_WAY) {}
+
+clip::clip(CACHE* cache, long sets, long ways)
+    : replacement(cache), NUM_SET(sets), NUM_WAY(ways), rrpv(static_cast<std::size_t>(sets * ways), maxRRPV), aging_rounds(static_cast<std::size_t>(sets))
+{
+}
+
+auto clip::get_rrpv(long set, long way) -> rrpv_type& { return rrpv.at(static_cast<std::size_t>(set * NUM_WAY + way)); }
+
+long clip::find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const champsim::cache_block* current_set, champsim::address ip,
+                       champsim::address full_addr, access_type type)
+{
+  auto& rounds = aging_rounds.at(static_cast<std::size_t>(set));
+  while (true) {
+    // Evict a distant data line if there is one, and a distant instruction line otherwise
+    for (bool evict_code : {false, true}) {
+      for (long way = 0; way < NUM_WAY; ++way) {
+        if (current_set[way].is_instruction == evict_code && get_rrpv(set, way) == maxRRPV) {
+          ++(evict_code ? stats.code_evictions : stats.data_evictions);
+          return way;
+        }
+      }
+    }
+
+    ++rounds;
+    const bool age_code = (rounds % CODE_AGING_PERIOD) == 0;
+    for (long way = 0; way < NUM_WAY; ++way) {
+      if (age_code || !current_set[way].is_instruction) {
+        get_rrpv(set, way) = std::min(get_rrpv(set, way) + 1, maxRRPV);
+      }
+    }
+  }
+}
+
+// called on every cache hit, and on misses that are filled by replacement_cache_fill()
+void clip::update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
+                                    champsim::address victim_addr, access_type type, bool hit, bool is_instruction)
+{
+  if (hit && type != access_type::WRITE) {
+    get_rrpv(set, way) = 0;
+  }
+}
+
+void clip::replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
+                                  champsim::address victim_addr, access_type type, bool is_instruction)
+{
+  if (way < NUM_WAY) {
+    get_rrpv(set, way) = is_instruction ? CODE_INSERTION_RRPV : DATA_INSERTION_RRPV;
+  }
+}
+
+void clip::replacement_final_stats() { fmt::print("CLIP instruction lines evicted: {} data lines evicted: {}\n", stats.code_evictions, stats.data_evictions); }
@@ -0,0 +1,48 @@
+#ifndef REPLACEMENT_CLIP_H
+#define REPLACEMENT_CLIP_H
+
+#include <cstdint>
+#include <vector>
+
+#include "cache.h"
+#include "modules.h"
+
+/*
+ * Code Line Preservation, after
+ * Aamer Jaleel, Joseph Nuzman, Adrian Moga, Simon C. Steely, and Joel Emer. 2015. High performing cache hierarchies for server workloads: Relaxing inclusion
+ * to capture the latency benefits of exclusive caches. In 2015 IEEE 21st International Symposium on High Performance Computer Architecture (HPCA), 343–353.
+ *
+ * An SRRIP variant for the L2 and LLC that keeps instruction lines ahead of data streams. Lines touched by an instruction fetch are inserted nearer
+ * re-reference, age more slowly than data lines, and are evicted only when no data line in the set is at the distant re-reference interval.
+ */
+struct clip : public champsim::modules::replacement {
+  using rrpv_type = int;
+  static constexpr rrpv_type maxRRPV = 3;
+  static constexpr rrpv_type DATA_INSERTION_RRPV = maxRRPV - 1;
+  static constexpr rrpv_type CODE_INSERTION_RRPV = maxRRPV - 2;
+  static constexpr unsigned CODE_AGING_PERIOD = 2; // instruction lines age once for every this many agings of the data lines
+
+  long NUM_SET, NUM_WAY;
+  std::vector<rrpv_type> rrpv;
+  std::vector<unsigned> aging_rounds;
+
+  struct stats_type {
+    uint64_t code_evictions = 0;
+    uint64_t data_evictions = 0;
+  } stats;
+
+  explicit clip(CACHE* cache);
+  clip(CACHE* cache, long sets, long ways);
+
+  long find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const champsim::cache_block* current_set, champsim::address ip,
+                   champsim::address full_addr, access_type type);
+  void update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr,
+                                access_type type, bool hit, bool is_instruction);
+  void replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip, champsim::address victim_addr,
+                              access_type type, bool is_instruction);
+  void replacement_final_stats();
+
+  rrpv_type& get_rrpv(long set, long way);
+};
+
+#endif
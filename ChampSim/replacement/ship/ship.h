@@ -1,13 +1,13 @@
 #ifndef REPLACEMENT_SHIP_H
 #define REPLACEMENT_SHIP_H
 
-#include <array>
 #include <vector>
 
 #include "cache.h"
 #include "modules.h"
 #include "msl/bits.h"
 #include "msl/fwcounter.h"
+#include "msl/packed_fwcounter.h"
 
 struct ship : public champsim::modules::replacement {
 private:
@@ -40,7 +40,7 @@ public:
   std::vector<int> rrpv_values;
 
   // prediction table structure
-  std::vector<std::array<champsim::msl::fwcounter<champsim::msl::lg2(SHCT_MAX + 1)>, SHCT_SIZE>> SHCT;
+  std::vector<champsim::msl::packed_fwcounter_array<champsim::msl::fwcounter<champsim::msl::lg2(SHCT_MAX + 1)>, SHCT_SIZE>> SHCT;
 
   explicit ship(CACHE* cache);
 
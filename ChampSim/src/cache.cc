@@ -40,7 +40,7 @@ CACHE::CACHE(CACHE&& other)
       cpu(other.cpu), NAME(std::move(other.NAME)), NUM_SET(other.NUM_SET), NUM_WAY(other.NUM_WAY), MSHR_SIZE(other.MSHR_SIZE), PQ_SIZE(other.PQ_SIZE),
       HIT_LATENCY(other.HIT_LATENCY), FILL_LATENCY(other.FILL_LATENCY), OFFSET_BITS(other.OFFSET_BITS), block(std::move(other.block)), MAX_TAG(other.MAX_TAG),
       MAX_FILL(other.MAX_FILL), prefetch_as_load(other.prefetch_as_load), match_offset_bits(other.match_offset_bits), virtual_prefetch(other.virtual_prefetch),
-      pref_activate_mask(std::move(other.pref_activate_mask)),
+      translation_prefetch(other.translation_prefetch), instruction_prefetch(other.instruction_prefetch), pref_activate_mask(std::move(other.pref_activate_mask)), fill_observers(std::move(other.fill_observers)),
 
       sim_stats(std::move(other.sim_stats)), roi_stats(std::move(other.roi_stats)),
 
@@ -78,7 +78,10 @@ auto CACHE::operator=(CACHE&& other) -> CACHE&
   this->prefetch_as_load = other.prefetch_as_load;
   this->match_offset_bits = other.match_offset_bits;
   this->virtual_prefetch = other.virtual_prefetch;
+  this->translation_prefetch = other.translation_prefetch;
+  this->instruction_prefetch = other.instruction_prefetch;
   this->pref_activate_mask = std::move(other.pref_activate_mask);
+  this->fill_observers = std::move(other.fill_observers);
 
   this->sim_stats = std::move(other.sim_stats);
   this->roi_stats = std::move(other.roi_stats);
@@ -94,13 +97,14 @@ auto CACHE::operator=(CACHE&& other) -> CACHE&
 
 CACHE::tag_lookup_type::tag_lookup_type(const request_type& req, bool local_pref, bool skip)
     : address(req.address), v_address(req.v_address), data(req.data), ip(req.ip), instr_id(req.instr_id), pf_metadata(req.pf_metadata), cpu(req.cpu),
-      type(req.type), prefetch_from_this(local_pref), skip_fill(skip), is_translated(req.is_translated), instr_depend_on_me(req.instr_depend_on_me)
+      type(req.type), prefetch_from_this(local_pref), skip_fill(skip), is_translated(req.is_translated), wrong_path(req.wrong_path),
+      is_instruction(req.is_instruction), instr_depend_on_me(req.instr_depend_on_me)
 {
 }
 
 CACHE::mshr_type::mshr_type(const tag_lookup_type& req, champsim::chrono::clock::time_point _time_enqueued)
     : address(req.address), v_address(req.v_address), ip(req.ip), instr_id(req.instr_id), cpu(req.cpu), type(req.type),
-      prefetch_from_this(req.prefetch_from_this), time_enqueued(_time_enqueued), instr_depend_on_me(req.instr_depend_on_me), to_return(req.to_return)
+      prefetch_from_this(req.prefetch_from_this), wrong_path(req.wrong_path), is_instruction(req.is_instruction), time_enqueued(_time_enqueued), instr_depend_on_me(req.instr_depend_on_me), to_return(req.to_return)
 {
 }
 
@@ -123,6 +127,12 @@ CACHE::mshr_type CACHE::mshr_type::merge(mshr_type predecessor, mshr_type succes
   retval.to_return = merged_return;
   retval.data_promise = predecessor.data_promise;
 
+  // a miss started on the wrong path remains one, but it is used if the correct path joins it
+  retval.wrong_path = predecessor.wrong_path;
+  retval.wrong_path_used = predecessor.wrong_path_used || (predecessor.wrong_path && !successor.wrong_path);
+
+  retval.is_instruction = predecessor.is_instruction || successor.is_instruction;
+
   if constexpr (champsim::debug_print) {
     if (successor.type == access_type::PREFETCH) {
       fmt::print("[MSHR] {} address {} type: {} into address {} type: {}\n", __func__, successor.address,
@@ -144,6 +154,8 @@ auto CACHE::fill_block(mshr_type mshr, uint32_t metadata) -> BLOCK
   to_fill.valid = true;
   to_fill.prefetch = mshr.prefetch_from_this;
   to_fill.dirty = (mshr.type == access_type::WRITE);
+  to_fill.wrong_path = mshr.wrong_path && !mshr.wrong_path_used;
+  to_fill.is_instruction = mshr.is_instruction;
   to_fill.address = mshr.address;
   to_fill.v_address = mshr.v_address;
   to_fill.data = mshr.data_promise->data;
@@ -220,7 +232,7 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
   auto metadata_thru = impl_prefetcher_cache_fill(module_address(fill_mshr), get_set_index(fill_mshr.address), way_idx,
                                                   (fill_mshr.type == access_type::PREFETCH), evicting_address, fill_mshr.data_promise->pf_metadata);
   impl_replacement_cache_fill(fill_mshr.cpu, get_set_index(fill_mshr.address), way_idx, module_address(fill_mshr), fill_mshr.ip, evicting_address,
-                              fill_mshr.type);
+                              fill_mshr.type, fill_mshr.is_instruction);
 
   if (way != set_end) {
     if (way->valid && way->prefetch) {
@@ -231,7 +243,15 @@ bool CACHE::handle_fill(const mshr_type& fill_mshr)
       ++sim_stats.pf_fill;
     }
 
+    if (fill_mshr.wrong_path) {
+      ++sim_stats.wrong_path_fill;
+    }
+
     *way = fill_block(fill_mshr, metadata_thru);
+
+    for (const auto& observer : fill_observers) {
+      observer(fill_mshr.v_address);
+    }
   }
 
   // COLLECT STATS
@@ -255,7 +275,7 @@ bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
   auto [set_begin, set_end] = get_set_span(handle_pkt.address);
   auto way = std::find_if(set_begin, set_end, [matcher = matches_address(handle_pkt.address)](const auto& x) { return x.valid && matcher(x); });
   const auto hit = (way != set_end);
-  const auto useful_prefetch = (hit && way->prefetch && !handle_pkt.prefetch_from_this);
+  const auto useful_prefetch = (hit && way->prefetch && !handle_pkt.prefetch_from_this && !handle_pkt.wrong_path);
 
   if constexpr (champsim::debug_print) {
     fmt::print("[{}] {} instr_id: {} address: {} v_address: {} data: {} set: {} way: {} ({}) type: {} cycle: {}\n", NAME, __func__, handle_pkt.instr_id,
@@ -271,7 +291,7 @@ bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
   // update replacement policy
   const auto way_idx = std::distance(set_begin, way);
   impl_update_replacement_state(handle_pkt.cpu, get_set_index(handle_pkt.address), way_idx, module_address(handle_pkt), handle_pkt.ip, {}, handle_pkt.type,
-                                hit);
+                                hit, handle_pkt.is_instruction);
 
   if (hit) {
     sim_stats.hits.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
@@ -282,12 +302,25 @@ bool CACHE::try_hit(const tag_lookup_type& handle_pkt)
     }
 
     way->dirty |= (handle_pkt.type == access_type::WRITE);
+    way->is_instruction |= handle_pkt.is_instruction;
 
     // update prefetch stats and reset prefetch bit
     if (useful_prefetch) {
       ++sim_stats.pf_useful;
       way->prefetch = false;
     }
+
+    // the correct path uses a block brought in by the wrong path
+    if (way->wrong_path && !handle_pkt.wrong_path) {
+      ++sim_stats.wrong_path_useful;
+      way->wrong_path = false;
+    }
+
+    if (handle_pkt.prefetch_from_this) {
+      for (const auto& observer : fill_observers) {
+        observer(way->v_address);
+      }
+    }
   }
 
   return hit;
@@ -313,6 +346,8 @@ auto CACHE::mshr_and_forward_packet(const tag_lookup_type& handle_pkt) -> std::p
 
   fwd_pkt.instr_depend_on_me = handle_pkt.instr_depend_on_me;
   fwd_pkt.response_requested = (!handle_pkt.prefetch_from_this || !handle_pkt.skip_fill);
+  fwd_pkt.wrong_path = handle_pkt.wrong_path;
+  fwd_pkt.is_instruction = handle_pkt.is_instruction;
 
   return std::pair{std::move(to_allocate), std::move(fwd_pkt)};
 }
@@ -337,13 +372,20 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
 
   if (mshr_entry != MSHR.end()) // miss already inflight
   {
-    if (mshr_entry->type == access_type::PREFETCH && handle_pkt.type != access_type::PREFETCH) {
+    if (mshr_entry->type == access_type::PREFETCH && handle_pkt.type != access_type::PREFETCH && !handle_pkt.wrong_path) {
+      // The prefetch was late
+      sim_stats.late_prefetch_hotspots.increment(std::pair{handle_pkt.cpu, champsim::address{champsim::block_number{handle_pkt.v_address}}.to<uint64_t>()});
+
       // Mark the prefetch as useful
       if (mshr_entry->prefetch_from_this) {
         ++sim_stats.pf_useful;
       }
     }
 
+    if (mshr_entry->wrong_path && !mshr_entry->wrong_path_used && !handle_pkt.wrong_path) {
+      ++sim_stats.wrong_path_useful;
+    }
+
     // COLLECT STATS
     sim_stats.mshr_merge.increment(std::pair{to_allocate.type, to_allocate.cpu});
 
@@ -368,6 +410,11 @@ bool CACHE::handle_miss(const tag_lookup_type& handle_pkt)
 
   sim_stats.misses.increment(std::pair{handle_pkt.type, handle_pkt.cpu});
 
+  if (handle_pkt.type != access_type::PREFETCH && !handle_pkt.wrong_path) {
+    sim_stats.miss_block_hotspots.increment(std::pair{handle_pkt.cpu, champsim::address{champsim::block_number{handle_pkt.v_address}}.to<uint64_t>()});
+    sim_stats.miss_ip_hotspots.increment(std::pair{handle_pkt.cpu, handle_pkt.ip.to<uint64_t>()});
+  }
+
   return true;
 }
 
@@ -588,10 +635,15 @@ bool CACHE::prefetch_line(champsim::address pf_addr, bool fill_this_level, uint3
   pf_packet.address = pf_addr;
   pf_packet.v_address = virtual_prefetch ? pf_addr : champsim::address{};
   pf_packet.is_translated = !virtual_prefetch;
+  pf_packet.is_instruction = instruction_prefetch;
 
   internal_PQ.emplace_back(pf_packet, true, !fill_this_level);
   ++sim_stats.pf_issued;
 
+  if (translation_prefetch && virtual_prefetch && lower_translate != nullptr) {
+    issue_translation_prefetch(pf_addr);
+  }
+
   return true;
 }
 
@@ -648,6 +700,13 @@ void CACHE::finish_translation(const response_type& packet)
     }
   };
 
+  last_translated_page = champsim::page_number{packet.v_address};
+  auto prefetched = std::find_if(std::begin(translation_prefetches), std::end(translation_prefetches),
+                                 [page_num = champsim::page_number{packet.v_address}](const auto& x) { return x.v_page == page_num; });
+  if (prefetched != std::end(translation_prefetches)) {
+    prefetched->returned = true;
+  }
+
   // Restart stashed translations
   auto finish_begin = std::find_if_not(std::begin(translation_stash), std::end(translation_stash), [](const auto& x) { return x.is_translated; });
   auto finish_end = std::stable_partition(finish_begin, std::end(translation_stash), matches_vpage);
@@ -661,9 +720,25 @@ void CACHE::finish_translation(const response_type& packet)
   }
 }
 
-void CACHE::issue_translation(tag_lookup_type& q_entry) const
+void CACHE::issue_translation(tag_lookup_type& q_entry)
 {
   if (!q_entry.translate_issued && !q_entry.is_translated) {
+    auto prefetched = std::find_if(std::begin(translation_prefetches), std::end(translation_prefetches),
+                                   [page_num = champsim::page_number{q_entry.v_address}](const auto& x) { return x.v_page == page_num; });
+    if (prefetched != std::end(translation_prefetches)) {
+      // The translation is already in flight, so wait for it rather than asking again
+      q_entry.translate_issued = !prefetched->returned;
+
+      if (!q_entry.prefetch_from_this) {
+        ++sim_stats.translation_pf_useful;
+        translation_prefetches.erase(prefetched);
+      }
+
+      if (q_entry.translate_issued) {
+        return;
+      }
+    }
+
     request_type fwd_pkt;
     fwd_pkt.asid[0] = q_entry.asid[0];
     fwd_pkt.asid[1] = q_entry.asid[1];
@@ -689,6 +764,34 @@ void CACHE::issue_translation(tag_lookup_type& q_entry) const
   }
 }
 
+void CACHE::issue_translation_prefetch(champsim::address v_addr)
+{
+  champsim::page_number v_page{v_addr};
+  auto already_known = std::any_of(std::cbegin(translation_prefetches), std::cend(translation_prefetches), [v_page](const auto& x) { return x.v_page == v_page; });
+  if (already_known || last_translated_page == v_page) {
+    return;
+  }
+
+  request_type fwd_pkt;
+  fwd_pkt.type = access_type::LOAD;
+  fwd_pkt.cpu = cpu;
+  fwd_pkt.address = v_addr;
+  fwd_pkt.v_address = v_addr;
+  fwd_pkt.is_translated = true;
+
+  if (lower_translate->add_rq(fwd_pkt)) {
+    if (std::size(translation_prefetches) >= MSHR_SIZE) {
+      translation_prefetches.pop_front();
+    }
+    translation_prefetches.push_back({v_page});
+    ++sim_stats.translation_pf_issued;
+
+    if constexpr (champsim::debug_print) {
+      fmt::print("[TRANSLATE] {} vaddr: {} cycle: {}\n", __func__, v_addr, current_time.time_since_epoch() / clock_period);
+    }
+  }
+}
+
 std::size_t CACHE::get_mshr_occupancy() const { return std::size(MSHR); }
 
 std::vector<std::size_t> CACHE::get_rq_occupancy() const
@@ -797,22 +900,42 @@ void CACHE::impl_prefetcher_initialize() const { pref_module_pimpl->impl_prefetc
 uint32_t CACHE::impl_prefetcher_cache_operate(champsim::address addr, champsim::address ip, bool cache_hit, bool useful_prefetch, access_type type,
                                               uint32_t metadata_in) const
 {
+  champsim::scoped_host_timer timer{hook_timers.prefetcher_cache_operate};
   return pref_module_pimpl->impl_prefetcher_cache_operate(addr, ip, cache_hit, useful_prefetch, type, metadata_in);
 }
 
 uint32_t CACHE::impl_prefetcher_cache_fill(champsim::address addr, long set, long way, bool prefetch, champsim::address evicted_addr,
                                            uint32_t metadata_in) const
 {
+  champsim::scoped_host_timer timer{hook_timers.prefetcher_cache_fill};
   return pref_module_pimpl->impl_prefetcher_cache_fill(addr, set, way, prefetch, evicted_addr, metadata_in);
 }
 
-void CACHE::impl_prefetcher_cycle_operate() const { pref_module_pimpl->impl_prefetcher_cycle_operate(); }
+void CACHE::impl_prefetcher_cycle_operate() const
+{
+  champsim::scoped_host_timer timer{hook_timers.prefetcher_cycle_operate};
+  pref_module_pimpl->impl_prefetcher_cycle_operate();
+}
 
 void CACHE::impl_prefetcher_final_stats() const { pref_module_pimpl->impl_prefetcher_final_stats(); }
 
-void CACHE::impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target) const
+void CACHE::impl_prefetcher_branch_operate(champsim::address ip, uint8_t branch_type, champsim::address branch_target,
+                                           champsim::branch_confidence confidence) const
+{
+  champsim::scoped_host_timer timer{hook_timers.prefetcher_branch_operate};
+  pref_module_pimpl->impl_prefetcher_branch_operate(ip, branch_type, branch_target, confidence);
+}
+
+void CACHE::impl_prefetcher_ftq_enqueue(champsim::address fetch_addr, bool wrong_path) const
+{
+  champsim::scoped_host_timer timer{hook_timers.prefetcher_ftq_enqueue};
+  pref_module_pimpl->impl_prefetcher_ftq_enqueue(fetch_addr, wrong_path);
+}
+
+void CACHE::impl_prefetcher_retire(champsim::address ip) const
 {
-  pref_module_pimpl->impl_prefetcher_branch_operate(ip, branch_type, branch_target);
+  champsim::scoped_host_timer timer{hook_timers.prefetcher_retire};
+  pref_module_pimpl->impl_prefetcher_retire(ip);
 }
 
 void CACHE::impl_initialize_replacement() const { repl_module_pimpl->impl_initialize_replacement(); }
@@ -820,19 +943,22 @@ void CACHE::impl_initialize_replacement() const { repl_module_pimpl->impl_initia
 long CACHE::impl_find_victim(uint32_t triggering_cpu, uint64_t instr_id, long set, const BLOCK* current_set, champsim::address ip, champsim::address full_addr,
                              access_type type) const
 {
+  champsim::scoped_host_timer timer{hook_timers.find_victim};
   return repl_module_pimpl->impl_find_victim(triggering_cpu, instr_id, set, current_set, ip, full_addr, type);
 }
 
 void CACHE::impl_update_replacement_state(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
-                                          champsim::address victim_addr, access_type type, bool hit) const
+                                          champsim::address victim_addr, access_type type, bool hit, bool is_instruction) const
 {
-  repl_module_pimpl->impl_update_replacement_state(triggering_cpu, set, way, full_addr, ip, victim_addr, type, hit);
+  champsim::scoped_host_timer timer{hook_timers.update_replacement_state};
+  repl_module_pimpl->impl_update_replacement_state(triggering_cpu, set, way, full_addr, ip, victim_addr, type, hit, is_instruction);
 }
 
 void CACHE::impl_replacement_cache_fill(uint32_t triggering_cpu, long set, long way, champsim::address full_addr, champsim::address ip,
-                                        champsim::address victim_addr, access_type type) const
+                                        champsim::address victim_addr, access_type type, bool is_instruction) const
 {
-  repl_module_pimpl->impl_replacement_cache_fill(triggering_cpu, set, way, full_addr, ip, victim_addr, type);
+  champsim::scoped_host_timer timer{hook_timers.replacement_cache_fill};
+  repl_module_pimpl->impl_replacement_cache_fill(triggering_cpu, set, way, full_addr, ip, victim_addr, type, is_instruction);
 }
 
 void CACHE::impl_replacement_final_stats() const { repl_module_pimpl->impl_replacement_final_stats(); }
@@ -871,12 +997,19 @@ void CACHE::end_phase(unsigned finished_cpu)
   roi_stats.misses = sim_stats.misses;
   roi_stats.mshr_merge = sim_stats.mshr_merge;
   roi_stats.mshr_return = sim_stats.mshr_return;
+  roi_stats.miss_block_hotspots = sim_stats.miss_block_hotspots;
+  roi_stats.miss_ip_hotspots = sim_stats.miss_ip_hotspots;
+  roi_stats.late_prefetch_hotspots = sim_stats.late_prefetch_hotspots;
 
   roi_stats.pf_requested = sim_stats.pf_requested;
   roi_stats.pf_issued = sim_stats.pf_issued;
   roi_stats.pf_useful = sim_stats.pf_useful;
   roi_stats.pf_useless = sim_stats.pf_useless;
   roi_stats.pf_fill = sim_stats.pf_fill;
+  roi_stats.translation_pf_issued = sim_stats.translation_pf_issued;
+  roi_stats.translation_pf_useful = sim_stats.translation_pf_useful;
+  roi_stats.wrong_path_fill = sim_stats.wrong_path_fill;
+  roi_stats.wrong_path_useful = sim_stats.wrong_path_useful;
 
   for (auto* ul : upper_levels) {
     ul->roi_stats.RQ_ACCESS = ul->sim_stats.RQ_ACCESS;
@@ -9,6 +9,12 @@ cache_stats operator-(cache_stats lhs, cache_stats rhs)
   result.pf_useless = lhs.pf_useless - rhs.pf_useless;
   result.pf_fill = lhs.pf_fill - rhs.pf_fill;
 
+  result.translation_pf_issued = lhs.translation_pf_issued - rhs.translation_pf_issued;
+  result.translation_pf_useful = lhs.translation_pf_useful - rhs.translation_pf_useful;
+
+  result.wrong_path_fill = lhs.wrong_path_fill - rhs.wrong_path_fill;
+  result.wrong_path_useful = lhs.wrong_path_useful - rhs.wrong_path_useful;
+
   result.hits = lhs.hits - rhs.hits;
   result.misses = lhs.misses - rhs.misses;
 
@@ -18,18 +18,22 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <limits>
 #include <numeric>
 #include <vector>
 #include <fmt/chrono.h>
 #include <fmt/core.h>
 
 #include "environment.h"
+#include "host_profile.h"
 #include "ooo_cpu.h"
 #include "operable.h"
 #include "phase_info.h"
 #include "tracereader.h"
 
 constexpr int DEADLOCK_CYCLE{500};
+constexpr long long PROFILE_PRINTING_PERIOD{10000000};
 
 const auto start_time = std::chrono::steady_clock::now();
 
@@ -37,6 +41,58 @@ std::chrono::seconds elapsed_time() { return std::chrono::duration_cast<std::chr
 
 namespace champsim
 {
+void reset_host_profile(environment& env)
+{
+  for (champsim::operable& op : env.operable_view()) {
+    op.operate_timer = {};
+  }
+  for (O3_CPU& cpu : env.cpu_view()) {
+    cpu.hook_timers = {};
+  }
+  for (CACHE& cache : env.cache_view()) {
+    cache.hook_timers = {};
+  }
+}
+
+host_profile collect_host_profile(environment& env, std::chrono::duration<double> phase_time)
+{
+  host_profile profile{true, phase_time.count()};
+  auto add = [&profile](std::string name, std::string hook, const host_timer& timer) {
+    profile.entries.push_back({std::move(name), std::move(hook), timer.seconds(), timer.calls});
+  };
+
+  for (O3_CPU& cpu : env.cpu_view()) {
+    auto name = fmt::format("cpu{}", cpu.cpu);
+    profile.instructions.push_back(cpu.sim_instr());
+    add(name, "operate", cpu.operate_timer);
+    add(name, "branch_predict", cpu.hook_timers.predict_branch);
+    add(name, "branch_last_result", cpu.hook_timers.last_branch_result);
+    add(name, "btb_prediction", cpu.hook_timers.btb_prediction);
+    add(name, "btb_update", cpu.hook_timers.update_btb);
+  }
+
+  for (CACHE& cache : env.cache_view()) {
+    add(cache.NAME, "operate", cache.operate_timer);
+    add(cache.NAME, "prefetcher_cache_operate", cache.hook_timers.prefetcher_cache_operate);
+    add(cache.NAME, "prefetcher_cache_fill", cache.hook_timers.prefetcher_cache_fill);
+    add(cache.NAME, "prefetcher_cycle_operate", cache.hook_timers.prefetcher_cycle_operate);
+    add(cache.NAME, "prefetcher_branch_operate", cache.hook_timers.prefetcher_branch_operate);
+    add(cache.NAME, "prefetcher_ftq_enqueue", cache.hook_timers.prefetcher_ftq_enqueue);
+    add(cache.NAME, "prefetcher_retire", cache.hook_timers.prefetcher_retire);
+    add(cache.NAME, "replacement_find_victim", cache.hook_timers.find_victim);
+    add(cache.NAME, "replacement_update_state", cache.hook_timers.update_replacement_state);
+    add(cache.NAME, "replacement_cache_fill", cache.hook_timers.replacement_cache_fill);
+  }
+
+  for (PageTableWalker& ptw : env.ptw_view()) {
+    add(ptw.NAME, "operate", ptw.operate_timer);
+  }
+
+  add("DRAM", "operate", env.dram_view().operate_timer);
+
+  return profile;
+}
+
 long do_cycle(environment& env, std::vector<tracereader>& traces, std::vector<std::size_t> trace_index, champsim::chrono::clock& global_clock)
 {
   auto operables = env.operable_view();
@@ -81,6 +137,13 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
   std::vector<double> livelock_threshold{0.01, 0.02, 0.05};
   std::vector<uint64_t> livelock_instr(std::size(env.cpu_view()), 0);
 
+  const auto phase_host_start = std::chrono::steady_clock::now();
+  std::vector<long long> last_profile_instr(std::size(env.cpu_view()), 0);
+  std::vector<std::chrono::steady_clock::time_point> last_profile_time(std::size(env.cpu_view()), phase_host_start);
+  if (host_profiling) {
+    reset_host_profile(env);
+  }
+
   // Perform phase
   int stalled_cycle{0};
   std::vector<bool> phase_complete(std::size(env.cpu_view()), false);
@@ -148,6 +211,29 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
       }
     }
 
+    // Report the simulator's throughput, and estimate the time remaining in the phase
+    if (host_profiling) {
+      for (O3_CPU& cpu : env.cpu_view()) {
+        if (cpu.sim_instr() >= last_profile_instr[cpu.cpu] + PROFILE_PRINTING_PERIOD) {
+          auto now = std::chrono::steady_clock::now();
+          auto phase_kips = champsim::kips(cpu.sim_instr(), now - phase_host_start);
+          auto heartbeat_kips = champsim::kips(cpu.sim_instr() - last_profile_instr[cpu.cpu], now - last_profile_time[cpu.cpu]);
+          // A phase that has not measurably advanced has no rate to extrapolate from
+          if (length < std::numeric_limits<long long>::max() && phase_kips > 0) {
+            auto remaining = static_cast<double>(std::max<long long>(length - cpu.sim_instr(), 0));
+            std::chrono::seconds eta{static_cast<long long>(std::ceil(remaining / (phase_kips * 1000.0)))};
+            fmt::print("Profile CPU {} instructions: {} heartbeat KIPS: {:.4g} phase KIPS: {:.4g} ETA: {:%H hr %M min %S sec}\n", cpu.cpu, cpu.sim_instr(),
+                       heartbeat_kips, phase_kips, eta);
+          } else {
+            fmt::print("Profile CPU {} instructions: {} heartbeat KIPS: {:.4g} phase KIPS: {:.4g} ETA: unknown\n", cpu.cpu, cpu.sim_instr(), heartbeat_kips,
+                       phase_kips);
+          }
+          last_profile_instr[cpu.cpu] = cpu.sim_instr();
+          last_profile_time[cpu.cpu] = now;
+        }
+      }
+    }
+
     phase_complete = next_phase_complete;
   }
 
@@ -159,6 +245,13 @@ phase_stats do_phase(const phase_info& phase, environment& env, std::vector<trac
   phase_stats stats;
   stats.name = phase.name;
 
+  if (host_profiling) {
+    stats.profile = collect_host_profile(env, std::chrono::steady_clock::now() - phase_host_start);
+    for (std::size_t cpu = 0; cpu < std::size(stats.profile.instructions); ++cpu) {
+      fmt::print("{} profile CPU {} host time: {:.3f} s phase KIPS: {:.4g}\n", phase_name, cpu, stats.profile.seconds, stats.profile.kips(cpu));
+    }
+  }
+
   for (std::size_t i = 0; i < std::size(trace_index); ++i) {
     stats.trace_names.push_back(trace_names.at(trace_index.at(i)));
   }
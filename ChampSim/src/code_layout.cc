@@ -0,0 +1,338 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "code_layout.h"
+
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <ios>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+std::string_view trim(std::string_view str)
+{
+  auto first = str.find_first_not_of(" \t\r");
+  auto last = str.find_last_not_of(" \t\r");
+  return first == std::string_view::npos ? std::string_view{} : str.substr(first, last - first + 1);
+}
+
+uint64_t parse_unsigned(std::string_view key, std::string_view value)
+{
+  std::string str{value};
+  std::size_t consumed = 0;
+  uint64_t retval = 0;
+  try {
+    retval = std::stoull(str, &consumed, 0);
+  } catch (const std::logic_error&) {
+    consumed = 0;
+  }
+  if (consumed == 0 || consumed != std::size(str) || str.front() == '-') {
+    throw std::invalid_argument{"Code layout parameter " + std::string{key} + " has an invalid value " + str};
+  }
+  return retval;
+}
+
+double parse_double(std::string_view key, std::string_view value)
+{
+  std::string str{value};
+  std::size_t consumed = 0;
+  double retval = 0;
+  try {
+    retval = std::stod(str, &consumed);
+  } catch (const std::logic_error&) {
+    consumed = 0;
+  }
+  if (consumed == 0 || consumed != std::size(str)) {
+    throw std::invalid_argument{"Code layout parameter " + std::string{key} + " has an invalid value " + str};
+  }
+  return retval;
+}
+
+void validate(const champsim::code_layout_parameters& params)
+{
+  auto fail = [](const std::string& what) {
+    throw std::invalid_argument{"Code layout parameters are invalid: " + what};
+  };
+
+  if (params.alignment == 0 || (params.alignment & (params.alignment - 1)) != 0) {
+    fail("the alignment must be a power of two");
+  }
+  if (params.cold_fraction < 0 || params.cold_fraction > 1) {
+    fail("the cold fraction must be between 0 and 1");
+  }
+}
+
+uint64_t align_up(uint64_t addr, uint64_t alignment) { return (addr + alignment - 1) & ~(alignment - 1); }
+} // namespace
+
+void champsim::code_layout::add(uint64_t begin, uint64_t end, uint64_t new_begin)
+{
+  if (begin >= end) {
+    throw std::invalid_argument{"Code layout ranges must not be empty"};
+  }
+
+  // Each map is keyed by the first address of its ranges, and the end of a range is found by the projection
+  auto overlaps = [](const auto& extents, uint64_t first, uint64_t last, auto end_of) {
+    auto next = extents.lower_bound(first);
+    if (next != std::end(extents) && next->first < last) {
+      return true;
+    }
+    return next != std::begin(extents) && end_of(std::prev(next)->second) > first;
+  };
+
+  auto new_end = new_begin + (end - begin);
+  if (overlaps(ranges, begin, end, [](const range_type& range) { return range.end; })
+      || overlaps(new_extents, new_begin, new_end, [](uint64_t extent_end) { return extent_end; })) {
+    throw std::invalid_argument{"Code layout ranges must not overlap"};
+  }
+
+  ranges.emplace(begin, range_type{begin, end, new_begin});
+  new_extents.emplace(new_begin, new_end);
+}
+
+uint64_t champsim::code_layout::remap(uint64_t addr) const
+{
+  auto next = ranges.upper_bound(addr);
+  if (next == std::begin(ranges)) {
+    return addr;
+  }
+
+  const auto& [begin, end, new_begin] = std::prev(next)->second;
+  return addr < end ? new_begin + (addr - begin) : addr;
+}
+
+auto champsim::code_layout::layout() const -> std::vector<range_type>
+{
+  std::vector<range_type> retval;
+  std::transform(std::begin(ranges), std::end(ranges), std::back_inserter(retval), [](const auto& range) { return range.second; });
+  return retval;
+}
+
+champsim::code_layout champsim::read_code_layout(std::istream& in)
+{
+  code_layout retval{};
+  std::string line;
+  for (long lineno = 1; std::getline(in, line); ++lineno) {
+    auto content = trim(std::string_view{line}.substr(0, line.find('#')));
+    if (std::empty(content)) {
+      continue;
+    }
+
+    std::istringstream fields{std::string{content}};
+    std::array<std::string, 3> addrs{};
+    std::string extra;
+    fields >> addrs[0] >> addrs[1] >> addrs[2] >> extra;
+    std::array<uint64_t, 3> values{};
+    try {
+      if (std::empty(addrs[2]) || !std::empty(extra)) {
+        throw std::invalid_argument{"wrong number of fields"};
+      }
+      for (std::size_t i = 0; i < std::size(addrs); ++i) {
+        std::size_t consumed = 0;
+        values.at(i) = std::stoull(addrs.at(i), &consumed, 16);
+        if (consumed != std::size(addrs.at(i))) {
+          throw std::invalid_argument{"trailing characters"};
+        }
+      }
+    } catch (const std::logic_error&) {
+      throw std::invalid_argument{"Code layout range on line " + std::to_string(lineno) + " is not three addresses: " + std::string{content}};
+    }
+    retval.add(values[0], values[1], values[2]);
+  }
+  return retval;
+}
+
+void champsim::write_code_layout(std::ostream& out, const code_layout& layout)
+{
+  out << "# original begin, original end, new begin\n";
+  auto flags = out.flags();
+  out << std::hex << std::showbase;
+  for (auto [begin, end, new_begin] : layout.layout()) {
+    out << begin << ' ' << end << ' ' << new_begin << '\n';
+  }
+  out.flags(flags);
+}
+
+champsim::code_layout_parameters champsim::parse_code_layout_parameters(std::string_view spec)
+{
+  using P = champsim::code_layout_parameters;
+  using param_setter = std::function<void(P&, std::string_view, std::string_view)>;
+  const std::map<std::string_view, param_setter> setters{
+      {"base", [](auto& params, auto key, auto value) { params.base = parse_unsigned(key, value); }},
+      {"alignment", [](auto& params, auto key, auto value) { params.alignment = parse_unsigned(key, value); }},
+      {"max_cluster_size", [](auto& params, auto key, auto value) { params.max_cluster_size = parse_unsigned(key, value); }},
+      {"cold_fraction", [](auto& params, auto key, auto value) { params.cold_fraction = parse_double(key, value); }}};
+
+  P retval{};
+  while (!std::empty(spec)) {
+    auto comma = spec.find(',');
+    auto pair = trim(spec.substr(0, comma));
+    spec = (comma == std::string_view::npos) ? std::string_view{} : spec.substr(comma + 1);
+    if (std::empty(pair)) {
+      continue;
+    }
+
+    auto eq = pair.find('=');
+    if (eq == std::string_view::npos) {
+      throw std::invalid_argument{"Code layout parameter " + std::string{pair} + " has no value"};
+    }
+
+    auto key = trim(pair.substr(0, eq));
+    auto setter = setters.find(key);
+    if (setter == std::end(setters)) {
+      throw std::invalid_argument{"Unknown code layout parameter " + std::string{key}};
+    }
+    setter->second(retval, key, trim(pair.substr(eq + 1)));
+  }
+
+  validate(retval);
+  return retval;
+}
+
+champsim::code_layout_profiler::code_layout_profiler(code_layout_parameters p) : params(p) { validate(params); }
+
+void champsim::code_layout_profiler::operator()(const ooo_model_instr& instr)
+{
+  auto ip = instr.ip.to<uint64_t>();
+  ++executions[ip];
+  ++num_instructions;
+
+  if (last_transfer.has_value()) {
+    ++transfers[{*last_transfer, ip}];
+  }
+
+  // Returns follow the placement of calls, so they do not pull the caller toward the callee
+  bool is_transfer = instr.is_branch && instr.branch_taken && instr.branch != BRANCH_RETURN;
+  last_transfer = is_transfer ? std::optional{ip} : std::nullopt;
+}
+
+champsim::code_layout champsim::code_layout_profiler::layout() const
+{
+  struct chunk_type {
+    uint64_t begin;
+    uint64_t end;
+    uint64_t instructions;
+  };
+
+  // Code that never executes separates the chunks, so the chunks can move apart without breaking a fall-through path
+  std::vector<chunk_type> chunks;
+  for (auto [ip, count] : executions) {
+    if (std::empty(chunks) || ip >= chunks.back().end) {
+      chunks.push_back(chunk_type{ip, ip, 0});
+    }
+    chunks.back().end = ip + max_instruction_size;
+    chunks.back().instructions += count;
+  }
+
+  if (std::empty(chunks)) {
+    return code_layout{};
+  }
+
+  auto chunk_of = [&chunks](uint64_t ip) {
+    auto found = std::upper_bound(std::begin(chunks), std::end(chunks), ip, [](uint64_t addr, const chunk_type& chunk) { return addr < chunk.begin; });
+    return static_cast<std::size_t>(std::distance(std::begin(chunks), std::prev(found)));
+  };
+
+  std::vector<std::map<std::size_t, uint64_t>> predecessors(std::size(chunks));
+  for (const auto& [edge, count] : transfers) {
+    auto from = chunk_of(edge.first);
+    auto to = chunk_of(edge.second);
+    if (from != to) {
+      predecessors.at(to)[from] += count;
+    }
+  }
+
+  auto is_hot = [this](const chunk_type& chunk) {
+    return static_cast<double>(chunk.instructions) >= params.cold_fraction * static_cast<double>(num_instructions);
+  };
+  auto size_of = [](const chunk_type& chunk) {
+    return chunk.end - chunk.begin;
+  };
+
+  // Call-chain clustering: in order of hotness, each chunk joins the end of the cluster of the chunk that most often transfers to it
+  std::vector<std::size_t> hot_order(std::size(chunks));
+  std::iota(std::begin(hot_order), std::end(hot_order), 0);
+  hot_order.erase(std::remove_if(std::begin(hot_order), std::end(hot_order), [&](auto idx) { return !is_hot(chunks.at(idx)); }), std::end(hot_order));
+  std::stable_sort(std::begin(hot_order), std::end(hot_order), [&](auto lhs, auto rhs) { return chunks.at(lhs).instructions > chunks.at(rhs).instructions; });
+
+  std::vector<std::vector<std::size_t>> clusters(std::size(chunks));
+  std::vector<std::size_t> cluster_of(std::size(chunks));
+  std::vector<uint64_t> cluster_size(std::size(chunks));
+  for (auto idx : hot_order) {
+    clusters.at(idx) = {idx};
+    cluster_of.at(idx) = idx;
+    cluster_size.at(idx) = size_of(chunks.at(idx));
+  }
+
+  for (auto idx : hot_order) {
+    std::optional<std::pair<uint64_t, std::size_t>> hottest{}; // count, chunk
+    for (auto [pred, count] : predecessors.at(idx)) {
+      if (is_hot(chunks.at(pred)) && (!hottest.has_value() || count > hottest->first)) {
+        hottest = std::pair{count, pred};
+      }
+    }
+    if (!hottest.has_value()) {
+      continue;
+    }
+
+    auto into = cluster_of.at(hottest->second);
+    auto from = cluster_of.at(idx);
+    if (into == from || cluster_size.at(into) + cluster_size.at(from) > params.max_cluster_size) {
+      continue;
+    }
+
+    for (auto member : clusters.at(from)) {
+      cluster_of.at(member) = into;
+    }
+    clusters.at(into).insert(std::end(clusters.at(into)), std::begin(clusters.at(from)), std::end(clusters.at(from)));
+    cluster_size.at(into) += cluster_size.at(from);
+    clusters.at(from).clear();
+  }
+
+  // The densest clusters come first, then the cold chunks in their original order
+  std::vector<std::size_t> cluster_order;
+  std::copy_if(std::begin(hot_order), std::end(hot_order), std::back_inserter(cluster_order), [&](auto idx) { return !std::empty(clusters.at(idx)); });
+  auto density = [&](std::size_t cluster) {
+    auto instructions = std::accumulate(std::begin(clusters.at(cluster)), std::end(clusters.at(cluster)), uint64_t{0},
+                                        [&](auto acc, auto member) { return acc + chunks.at(member).instructions; });
+    return static_cast<double>(instructions) / static_cast<double>(cluster_size.at(cluster));
+  };
+  std::stable_sort(std::begin(cluster_order), std::end(cluster_order), [&](auto lhs, auto rhs) { return density(lhs) > density(rhs); });
+
+  std::vector<std::size_t> placement;
+  for (auto cluster : cluster_order) {
+    placement.insert(std::end(placement), std::begin(clusters.at(cluster)), std::end(clusters.at(cluster)));
+  }
+  for (std::size_t idx = 0; idx < std::size(chunks); ++idx) {
+    if (!is_hot(chunks.at(idx))) {
+      placement.push_back(idx);
+    }
+  }
+
+  code_layout retval{};
+  auto cursor = params.base != 0 ? params.base : chunks.front().begin;
+  for (auto idx : placement) {
+    cursor = align_up(cursor, params.alignment);
+    retval.add(chunks.at(idx).begin, chunks.at(idx).end, cursor);
+    cursor += size_of(chunks.at(idx));
+  }
+  return retval;
+}
@@ -0,0 +1,267 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "code_prefetch_hints.h"
+
+#include <algorithm>
+#include <functional>
+#include <ios>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+std::string_view trim(std::string_view str)
+{
+  auto first = str.find_first_not_of(" \t\r");
+  auto last = str.find_last_not_of(" \t\r");
+  return first == std::string_view::npos ? std::string_view{} : str.substr(first, last - first + 1);
+}
+
+uint64_t parse_unsigned(std::string_view key, std::string_view value)
+{
+  std::string str{value};
+  std::size_t consumed = 0;
+  uint64_t retval = 0;
+  try {
+    retval = std::stoull(str, &consumed, 0);
+  } catch (const std::logic_error&) {
+    consumed = 0;
+  }
+  if (consumed == 0 || consumed != std::size(str) || str.front() == '-') {
+    throw std::invalid_argument{"Code prefetch analysis parameter " + std::string{key} + " has an invalid value " + str};
+  }
+  return retval;
+}
+
+double parse_double(std::string_view key, std::string_view value)
+{
+  std::string str{value};
+  std::size_t consumed = 0;
+  double retval = 0;
+  try {
+    retval = std::stod(str, &consumed);
+  } catch (const std::logic_error&) {
+    consumed = 0;
+  }
+  if (consumed == 0 || consumed != std::size(str)) {
+    throw std::invalid_argument{"Code prefetch analysis parameter " + std::string{key} + " has an invalid value " + str};
+  }
+  return retval;
+}
+
+void validate(const champsim::code_prefetch_analysis_parameters& params)
+{
+  auto fail = [](const std::string& what) {
+    throw std::invalid_argument{"Code prefetch analysis parameters are invalid: " + what};
+  };
+
+  if (params.block_size == 0 || (params.block_size & (params.block_size - 1)) != 0) {
+    fail("the block size must be a power of two");
+  }
+  if (params.sets == 0 || params.ways == 0) {
+    fail("the modeled L1I must not be empty");
+  }
+  if (params.distance == 0) {
+    fail("the prefetch distance must not be zero");
+  }
+  if (params.min_accuracy < 0 || params.min_accuracy > 1) {
+    fail("the minimum accuracy must be between 0 and 1");
+  }
+}
+} // namespace
+
+void champsim::code_prefetch_hints::add(uint64_t trigger_ip, uint64_t target)
+{
+  auto& targets = table[trigger_ip];
+  if (std::find(std::begin(targets), std::end(targets), target) == std::end(targets)) {
+    targets.push_back(target);
+    ++num_hints;
+  }
+}
+
+auto champsim::code_prefetch_hints::targets(uint64_t ip) const -> const std::vector<uint64_t>&
+{
+  static const std::vector<uint64_t> none{};
+  auto found = table.find(ip);
+  return found == std::end(table) ? none : found->second;
+}
+
+auto champsim::code_prefetch_hints::hints() const -> std::vector<std::pair<uint64_t, uint64_t>>
+{
+  std::vector<std::pair<uint64_t, uint64_t>> retval;
+  for (const auto& [trigger, targets] : table) {
+    std::transform(std::begin(targets), std::end(targets), std::back_inserter(retval), [trigger = trigger](auto target) { return std::pair{trigger, target}; });
+  }
+  std::sort(std::begin(retval), std::end(retval));
+  return retval;
+}
+
+champsim::code_prefetch_hints champsim::read_code_prefetch_hints(std::istream& in)
+{
+  code_prefetch_hints retval{};
+  std::string line;
+  for (long lineno = 1; std::getline(in, line); ++lineno) {
+    auto content = trim(std::string_view{line}.substr(0, line.find('#')));
+    if (std::empty(content)) {
+      continue;
+    }
+
+    std::istringstream fields{std::string{content}};
+    std::string trigger;
+    std::string target;
+    std::string extra;
+    fields >> trigger >> target >> extra;
+    try {
+      if (std::empty(target) || !std::empty(extra)) {
+        throw std::invalid_argument{"wrong number of fields"};
+      }
+      std::size_t trigger_len = 0;
+      std::size_t target_len = 0;
+      auto trigger_ip = std::stoull(trigger, &trigger_len, 16);
+      auto target_addr = std::stoull(target, &target_len, 16);
+      if (trigger_len != std::size(trigger) || target_len != std::size(target)) {
+        throw std::invalid_argument{"trailing characters"};
+      }
+      retval.add(trigger_ip, target_addr);
+    } catch (const std::logic_error&) {
+      throw std::invalid_argument{"Code prefetch hint on line " + std::to_string(lineno) + " is not a pair of addresses: " + std::string{content}};
+    }
+  }
+  return retval;
+}
+
+void champsim::write_code_prefetch_hints(std::ostream& out, const code_prefetch_hints& hints)
+{
+  out << "# trigger IP, prefetched address\n";
+  auto flags = out.flags();
+  out << std::hex << std::showbase;
+  for (auto [trigger, target] : hints.hints()) {
+    out << trigger << ' ' << target << '\n';
+  }
+  out.flags(flags);
+}
+
+champsim::code_prefetch_analysis_parameters champsim::parse_code_prefetch_analysis_parameters(std::string_view spec)
+{
+  using P = champsim::code_prefetch_analysis_parameters;
+  using param_setter = std::function<void(P&, std::string_view, std::string_view)>;
+  const std::map<std::string_view, param_setter> setters{
+      {"block_size", [](auto& params, auto key, auto value) { params.block_size = parse_unsigned(key, value); }},
+      {"sets", [](auto& params, auto key, auto value) { params.sets = parse_unsigned(key, value); }},
+      {"ways", [](auto& params, auto key, auto value) { params.ways = parse_unsigned(key, value); }},
+      {"distance", [](auto& params, auto key, auto value) { params.distance = parse_unsigned(key, value); }},
+      {"min_misses", [](auto& params, auto key, auto value) { params.min_misses = parse_unsigned(key, value); }},
+      {"min_accuracy", [](auto& params, auto key, auto value) { params.min_accuracy = parse_double(key, value); }}};
+
+  P retval{};
+  while (!std::empty(spec)) {
+    auto comma = spec.find(',');
+    auto pair = trim(spec.substr(0, comma));
+    spec = (comma == std::string_view::npos) ? std::string_view{} : spec.substr(comma + 1);
+    if (std::empty(pair)) {
+      continue;
+    }
+
+    auto eq = pair.find('=');
+    if (eq == std::string_view::npos) {
+      throw std::invalid_argument{"Code prefetch analysis parameter " + std::string{pair} + " has no value"};
+    }
+
+    auto key = trim(pair.substr(0, eq));
+    auto setter = setters.find(key);
+    if (setter == std::end(setters)) {
+      throw std::invalid_argument{"Unknown code prefetch analysis parameter " + std::string{key}};
+    }
+    setter->second(retval, key, trim(pair.substr(eq + 1)));
+  }
+
+  validate(retval);
+  return retval;
+}
+
+champsim::code_prefetch_analyzer::code_prefetch_analyzer(code_prefetch_analysis_parameters p) : params(p), l1i(params.sets) { validate(params); }
+
+bool champsim::code_prefetch_analyzer::access(uint64_t block)
+{
+  auto& set = l1i.at(block % params.sets);
+  auto way = std::find(std::begin(set), std::end(set), block);
+  bool hit = (way != std::end(set));
+  if (!hit) {
+    if (std::size(set) == params.ways) {
+      set.pop_back();
+    }
+    way = set.insert(std::end(set), block);
+  }
+  std::rotate(std::begin(set), way, std::next(way));
+  return hit;
+}
+
+void champsim::code_prefetch_analyzer::operator()(const input_instr& instr) { (*this)(instr.ip); }
+
+void champsim::code_prefetch_analyzer::operator()(uint64_t ip)
+{
+  ++num_instructions;
+  ++executions[ip];
+
+  // Consecutive instructions in one block are a single fetch
+  auto block = ip / params.block_size;
+  if (block != last_block) {
+    last_block = block;
+    if (!access(block)) {
+      ++num_misses;
+
+      // A prefetch in the missing block itself would be too late
+      if (std::size(history) == params.distance && history.front() / params.block_size != block) {
+        ++candidates[{history.front(), block}];
+      }
+    }
+  }
+
+  history.push_back(ip);
+  if (std::size(history) > params.distance) {
+    history.pop_front();
+  }
+}
+
+bool champsim::code_prefetch_analyzer::is_chosen(const decltype(candidates)::value_type& candidate) const
+{
+  auto [key, misses] = candidate;
+  return misses >= params.min_misses && static_cast<double>(misses) >= params.min_accuracy * static_cast<double>(executions.at(key.first));
+}
+
+champsim::code_prefetch_hints champsim::code_prefetch_analyzer::hints() const
+{
+  code_prefetch_hints retval{};
+  for (const auto& candidate : candidates) {
+    if (is_chosen(candidate)) {
+      retval.add(candidate.first.first, candidate.first.second * params.block_size);
+    }
+  }
+  return retval;
+}
+
+auto champsim::code_prefetch_analyzer::stats() const -> stats_type
+{
+  stats_type retval{num_instructions, num_misses, 0};
+  for (const auto& candidate : candidates) {
+    if (is_chosen(candidate)) {
+      retval.covered_misses += candidate.second;
+    }
+  }
+  return retval;
+}
@@ -10,6 +10,19 @@ cpu_stats operator-(cpu_stats lhs, cpu_stats rhs)
 
   lhs.total_branch_types -= rhs.total_branch_types;
   lhs.branch_type_misses -= rhs.branch_type_misses;
+  lhs.btb_level_hits -= rhs.btb_level_hits;
+  lhs.btb_level_misses -= rhs.btb_level_misses;
+  lhs.btb_redirect_bubbles -= rhs.btb_redirect_bubbles;
+  lhs.predictor_overrides -= rhs.predictor_overrides;
+  lhs.predictor_override_bubbles -= rhs.predictor_override_bubbles;
+  lhs.lsd_locks -= rhs.lsd_locks;
+  lhs.lsd_hits -= rhs.lsd_hits;
+  lhs.lsd_l1i_accesses_avoided -= rhs.lsd_l1i_accesses_avoided;
+  lhs.uop_cache_hits -= rhs.uop_cache_hits;
+  lhs.uop_cache_misses -= rhs.uop_cache_misses;
+  lhs.uop_cache_switches -= rhs.uop_cache_switches;
+  lhs.prefetch_hints_issued -= rhs.prefetch_hints_issued;
+  lhs.prefetch_hints_dropped -= rhs.prefetch_hints_dropped;
 
   return lhs;
 }
@@ -275,11 +275,13 @@ long DRAM_CHANNEL::populate_dbus()
           ++sim_stats.WQ_ROW_BUFFER_HIT;
         } else {
           ++sim_stats.RQ_ROW_BUFFER_HIT;
+          sim_stats.RQ_ROW_BUFFER_HIT_BY_TYPE.increment(iter_next_process->pkt->value().type);
         }
       } else if (write_mode) {
         ++sim_stats.WQ_ROW_BUFFER_MISS;
       } else {
         ++sim_stats.RQ_ROW_BUFFER_MISS;
+        sim_stats.RQ_ROW_BUFFER_MISS_BY_TYPE.increment(iter_next_process->pkt->value().type);
       }
 
       ++progress;
@@ -508,7 +510,7 @@ void MEMORY_CONTROLLER::initiate_requests()
 }
 
 DRAM_CHANNEL::request_type::request_type(const typename champsim::channel::request_type& req)
-    : pf_metadata(req.pf_metadata), address(req.address), v_address(req.address), data(req.data), instr_depend_on_me(req.instr_depend_on_me)
+    : type(req.type), pf_metadata(req.pf_metadata), address(req.address), v_address(req.address), data(req.data), instr_depend_on_me(req.instr_depend_on_me)
 {
   asid[0] = req.asid[0];
   asid[1] = req.asid[1];
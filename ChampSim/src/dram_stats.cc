@@ -8,6 +8,8 @@ dram_stats operator-(dram_stats lhs, dram_stats rhs)
   lhs.WQ_ROW_BUFFER_MISS -= rhs.WQ_ROW_BUFFER_MISS;
   lhs.RQ_ROW_BUFFER_HIT -= rhs.RQ_ROW_BUFFER_HIT;
   lhs.RQ_ROW_BUFFER_MISS -= rhs.RQ_ROW_BUFFER_MISS;
+  lhs.RQ_ROW_BUFFER_HIT_BY_TYPE -= rhs.RQ_ROW_BUFFER_HIT_BY_TYPE;
+  lhs.RQ_ROW_BUFFER_MISS_BY_TYPE -= rhs.RQ_ROW_BUFFER_MISS_BY_TYPE;
   lhs.WQ_FULL -= rhs.WQ_FULL;
   return lhs;
 }
@@ -0,0 +1,29 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "host_profile.h"
+
+bool champsim::host_profiling = false; // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+double champsim::kips(long long instructions, std::chrono::duration<double> host_time)
+{
+  if (host_time.count() <= 0) {
+    return 0;
+  }
+  return static_cast<double>(instructions) / host_time.count() / 1000.0;
+}
+
+double champsim::host_profile::kips(std::size_t cpu) const { return champsim::kips(instructions.at(cpu), std::chrono::duration<double>{seconds}); }
@@ -16,10 +16,27 @@
 
 #include <algorithm>
 #include <utility>
+#include <fmt/core.h>
 #include <nlohmann/json.hpp>
 
 #include "stats_printer.h"
 
+namespace
+{
+template <typename Counter, typename F>
+std::vector<nlohmann::json> hotspots_json(const Counter& counter, F&& describe)
+{
+  std::vector<nlohmann::json> retval{};
+  for (const auto& entry : counter.top()) {
+    auto j = describe(entry.key);
+    j.emplace("count", entry.count);
+    j.emplace("error", entry.error);
+    retval.push_back(j);
+  }
+  return retval;
+}
+} // namespace
+
 void to_json(nlohmann::json& j, const O3_CPU::stats_type& stats)
 {
   constexpr std::array types{branch_type::BRANCH_DIRECT_JUMP, branch_type::BRANCH_INDIRECT,      branch_type::BRANCH_CONDITIONAL,
@@ -37,6 +54,40 @@ void to_json(nlohmann::json& j, const O3_CPU::stats_type& stats)
                      {"cycles", stats.cycles()},
                      {"Avg ROB occupancy at mispredict", std::ceil(stats.total_rob_occupancy_at_branch_mispredict) / std::ceil(total_mispredictions)},
                      {"mispredict", mpki}};
+
+  if (stats.btb_levels > 1) {
+    std::vector<nlohmann::json> btb{};
+    for (std::size_t level = 0; level < stats.btb_levels; ++level) {
+      btb.push_back(nlohmann::json{{"hit", stats.btb_level_hits.value_or(level, 0)}, {"miss", stats.btb_level_misses.value_or(level, 0)}});
+    }
+    j.emplace("BTB", btb);
+    j.emplace("BTB redirect bubbles", stats.btb_redirect_bubbles);
+  }
+
+  if (stats.predictor_overrides > 0) {
+    j.emplace("branch predictor overrides", nlohmann::json{{"overrides", stats.predictor_overrides}, {"bubbles", stats.predictor_override_bubbles}});
+  }
+
+  if (stats.lsd_locks > 0) {
+    j.emplace("LSD", nlohmann::json{{"locks", stats.lsd_locks}, {"hits", stats.lsd_hits}, {"L1I accesses avoided", stats.lsd_l1i_accesses_avoided}});
+  }
+
+  if (stats.uop_cache_hits + stats.uop_cache_misses > 0) {
+    j.emplace("uop cache", nlohmann::json{{"hit", stats.uop_cache_hits}, {"miss", stats.uop_cache_misses}, {"switches", stats.uop_cache_switches}});
+  }
+
+  if (stats.prefetch_hints_issued + stats.prefetch_hints_dropped > 0) {
+    j.emplace("code prefetch hints", nlohmann::json{{"issued", stats.prefetch_hints_issued}, {"dropped", stats.prefetch_hints_dropped}});
+  }
+
+  if (!stats.mispredict_hotspots.empty() || !stats.btb_miss_hotspots.empty()) {
+    auto branch_key = [](auto key) {
+      return nlohmann::json{{"ip", fmt::format("{:#x}", key.first)}, {"type", branch_type_names.at(champsim::to_underlying(key.second))}};
+    };
+    auto ip_key = [](auto key) { return nlohmann::json{{"ip", fmt::format("{:#x}", key)}}; };
+    j.emplace("hotspots", nlohmann::json{{"mispredict", ::hotspots_json(stats.mispredict_hotspots, branch_key)},
+                                         {"BTB miss", ::hotspots_json(stats.btb_miss_hotspots, ip_key)}});
+  }
 }
 
 void to_json(nlohmann::json& j, const CACHE::stats_type& stats)
@@ -51,13 +102,17 @@ void to_json(nlohmann::json& j, const CACHE::stats_type& stats)
   statsmap.emplace("prefetch issued", stats.pf_issued);
   statsmap.emplace("useful prefetch", stats.pf_useful);
   statsmap.emplace("useless prefetch", stats.pf_useless);
+  statsmap.emplace("translation prefetch issued", stats.translation_pf_issued);
+  statsmap.emplace("useful translation prefetch", stats.translation_pf_useful);
+  statsmap.emplace("wrong-path fill", stats.wrong_path_fill);
+  statsmap.emplace("useful wrong-path fill", stats.wrong_path_useful);
 
   uint64_t total_downstream_demands = stats.mshr_return.total();
   for (std::size_t cpu = 0; cpu < NUM_CPUS; ++cpu)
     total_downstream_demands -= stats.mshr_return.value_or(std::pair{access_type::PREFETCH, cpu}, mshr_return_value_type{});
 
   statsmap.emplace("miss latency", std::ceil(stats.total_miss_latency_cycles) / std::ceil(total_downstream_demands));
-  for (const auto type : {access_type::LOAD, access_type::RFO, access_type::PREFETCH, access_type::WRITE, access_type::TRANSLATION}) {
+  for (const auto type : {access_type::LOAD, access_type::RFO, access_type::PREFETCH, access_type::WRITE, access_type::TRANSLATION, access_type::IFETCH}) {
     std::vector<hits_value_type> hits;
     std::vector<misses_value_type> misses;
     std::vector<mshr_merge_value_type> mshr_merges;
@@ -71,6 +126,14 @@ void to_json(nlohmann::json& j, const CACHE::stats_type& stats)
     statsmap.emplace(access_type_names.at(champsim::to_underlying(type)), nlohmann::json{{"hit", hits}, {"miss", misses}, {"mshr_merge", mshr_merges}});
   }
 
+  if (!stats.miss_block_hotspots.empty() || !stats.miss_ip_hotspots.empty() || !stats.late_prefetch_hotspots.empty()) {
+    auto block_key = [](auto key) { return nlohmann::json{{"cpu", key.first}, {"block", fmt::format("{:#x}", key.second)}}; };
+    auto ip_key = [](auto key) { return nlohmann::json{{"cpu", key.first}, {"ip", fmt::format("{:#x}", key.second)}}; };
+    statsmap.emplace("hotspots", nlohmann::json{{"demand miss block", ::hotspots_json(stats.miss_block_hotspots, block_key)},
+                                                {"demand miss IP", ::hotspots_json(stats.miss_ip_hotspots, ip_key)},
+                                                {"late prefetch block", ::hotspots_json(stats.late_prefetch_hotspots, block_key)}});
+  }
+
   j = statsmap;
 }
 
@@ -82,10 +145,32 @@ void to_json(nlohmann::json& j, const DRAM_CHANNEL::stats_type stats)
                      {"WQ ROW_BUFFER_MISS", stats.WQ_ROW_BUFFER_MISS},
                      {"AVG DBUS CONGESTED CYCLE", (std::ceil(stats.dbus_cycle_congested) / std::ceil(stats.dbus_count_congested))},
                      {"REFRESHES ISSUED", stats.refresh_cycles}};
+
+  nlohmann::json by_type{};
+  for (const auto type : {access_type::LOAD, access_type::RFO, access_type::PREFETCH, access_type::TRANSLATION, access_type::IFETCH}) {
+    auto hits = stats.RQ_ROW_BUFFER_HIT_BY_TYPE.value_or(type, 0);
+    auto misses = stats.RQ_ROW_BUFFER_MISS_BY_TYPE.value_or(type, 0);
+    by_type.emplace(access_type_names.at(champsim::to_underlying(type)), nlohmann::json{{"ROW_BUFFER_HIT", hits}, {"ROW_BUFFER_MISS", misses}});
+  }
+  j.emplace("RQ BY TYPE", by_type);
 }
 
 namespace champsim
 {
+void to_json(nlohmann::json& j, const champsim::host_profile::entry& entry)
+{
+  j = nlohmann::json{{"name", entry.name}, {"hook", entry.hook}, {"seconds", entry.seconds}, {"calls", entry.calls}};
+}
+
+void to_json(nlohmann::json& j, const champsim::host_profile& profile)
+{
+  std::vector<double> kips;
+  for (std::size_t cpu = 0; cpu < std::size(profile.instructions); ++cpu) {
+    kips.push_back(profile.kips(cpu));
+  }
+  j = nlohmann::json{{"seconds", profile.seconds}, {"instructions", profile.instructions}, {"KIPS", kips}, {"components", profile.entries}};
+}
+
 void to_json(nlohmann::json& j, const champsim::phase_stats stats)
 {
   std::map<std::string, nlohmann::json> roi_stats;
@@ -105,6 +190,9 @@ void to_json(nlohmann::json& j, const champsim::phase_stats stats)
   std::map<std::string, nlohmann::json> statsmap{{"name", stats.name}, {"traces", stats.trace_names}};
   statsmap.emplace("roi", roi_stats);
   statsmap.emplace("sim", sim_stats);
+  if (stats.profile.enabled) {
+    statsmap.emplace("host profile", stats.profile);
+  }
   j = statsmap;
 }
 } // namespace champsim
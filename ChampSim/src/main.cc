@@ -24,11 +24,15 @@
 
 #include "cache.h" // for CACHE
 #include "champsim.h"
+#include "code_layout.h"
+#include "code_prefetch_hints.h"
 #ifndef CHAMPSIM_TEST_BUILD
 #include "core_inst.inc"
 #endif
 #include "defaults.hpp"
 #include "environment.h"
+#include "host_profile.h"
+#include "hotspot_counter.h"
 #include "ooo_cpu.h" // for O3_CPU
 #include "phase_info.h"
 #include "stats_printer.h"
@@ -63,6 +67,9 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   long long simulation_instructions = std::numeric_limits<long long>::max();
   std::string json_file_name;
   std::vector<std::string> trace_names;
+  std::vector<std::string> prefetch_hint_names;
+  std::vector<std::string> code_layout_names;
+  bool prefetch_hints_take_fetch_slots{false};
 
   auto set_heartbeat_callback = [&](auto) {
     for (O3_CPU& cpu : gen_environment.cpu_view()) {
@@ -72,6 +79,9 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
 
   app.add_flag("-c,--cloudsuite", knob_cloudsuite, "Read all traces using the cloudsuite format");
   app.add_flag("--hide-heartbeat", set_heartbeat_callback, "Hide the heartbeat output");
+  app.add_flag("--profile", champsim::host_profiling, "Measure the simulator's throughput and the host time spent in each component and module");
+  app.add_option("--hotspots", champsim::hotspot_report_size,
+                 "Report the N branches, code blocks, and instruction pointers responsible for the most mispredicts and cache misses");
   auto* warmup_instr_option = app.add_option("-w,--warmup-instructions", warmup_instructions, "The number of instructions in the warmup phase");
   auto* deprec_warmup_instr_option =
       app.add_option("--warmup_instructions", warmup_instructions, "[deprecated] use --warmup-instructions instead")->excludes(warmup_instr_option);
@@ -80,10 +90,26 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
   auto* deprec_sim_instr_option =
       app.add_option("--simulation_instructions", simulation_instructions, "[deprecated] use --simulation-instructions instead")->excludes(sim_instr_option);
 
+  app.add_option("--code-prefetch-hints", prefetch_hint_names,
+                 "Files of software code prefetches to insert, one for each CPU in order, as written by tools/prefetch_hints")
+      ->expected(1, NUM_CPUS)
+      ->check(CLI::ExistingFile);
+  app.add_flag("--code-prefetch-hints-take-fetch-slots", prefetch_hints_take_fetch_slots, "Charge a fetch slot for each inserted code prefetch");
+
+  app.add_option("--code-layout", code_layout_names,
+                 "Files of new code layouts to simulate the traces with, one for each CPU in order, as written by tools/code_layout")
+      ->expected(1, NUM_CPUS)
+      ->check(CLI::ExistingFile);
+
   auto* json_option =
       app.add_option("--json", json_file_name, "The name of the file to receive JSON output. If no name is specified, stdout will be used")->expected(0, 1);
 
-  app.add_option("traces", trace_names, "The paths to the traces")->required()->expected(NUM_CPUS)->check(CLI::ExistingFile);
+  CLI::Validator synthetic_trace{[](const std::string& name) { return champsim::is_synthetic_trace_name(name) ? std::string{} : "Not a synthetic trace: " + name; },
+                                 "SYNTHETIC"};
+  app.add_option("traces", trace_names, "The paths to the traces, or synthetic:<parameters> to generate a synthetic workload")
+      ->required()
+      ->expected(NUM_CPUS)
+      ->check(CLI::ExistingFile | synthetic_trace);
 
   CLI11_PARSE(app, argc, argv);
 
@@ -104,11 +130,35 @@ int main(int argc, char** argv) // NOLINT(bugprone-exception-escape)
     warmup_instructions = simulation_instructions / 5;
   }
 
+  auto cpus = gen_environment.cpu_view();
+  for (std::size_t i = 0; i < std::size(prefetch_hint_names); ++i) {
+    std::ifstream hint_file{prefetch_hint_names.at(i)};
+    try {
+      cpus.at(i).get().prefetch_hints = champsim::read_code_prefetch_hints(hint_file);
+    } catch (const std::invalid_argument& err) {
+      fmt::print(stderr, "{}: {}\n", prefetch_hint_names.at(i), err.what());
+      return 1;
+    }
+  }
+  for (O3_CPU& cpu : cpus) {
+    cpu.prefetch_hints_take_fetch_slots = prefetch_hints_take_fetch_slots;
+  }
+
   std::vector<champsim::tracereader> traces;
   std::transform(
       std::begin(trace_names), std::end(trace_names), std::back_inserter(traces),
       [knob_cloudsuite, repeat = simulation_given, i = uint8_t(0)](auto name) mutable { return get_tracereader(name, i++, knob_cloudsuite, repeat); });
 
+  for (std::size_t i = 0; i < std::size(code_layout_names); ++i) {
+    std::ifstream layout_file{code_layout_names.at(i)};
+    try {
+      traces.at(i) = champsim::tracereader{champsim::code_layout_tracereader{std::move(traces.at(i)), champsim::read_code_layout(layout_file)}};
+    } catch (const std::invalid_argument& err) {
+      fmt::print(stderr, "{}: {}\n", code_layout_names.at(i), err.what());
+      return 1;
+    }
+  }
+
   std::vector<champsim::phase_info> phases{
       {champsim::phase_info{"Warmup", true, warmup_instructions, std::vector<std::size_t>(std::size(trace_names), 0), trace_names},
        champsim::phase_info{"Simulation", false, simulation_instructions, std::vector<std::size_t>(std::size(trace_names), 0), trace_names}}};
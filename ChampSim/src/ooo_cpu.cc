@@ -50,7 +50,9 @@ long O3_CPU::operate()
 
   progress += fetch_instruction(); // fetch
   progress += check_dib();
-  initialize_instruction();
+  predict_wrong_path();
+  initialize_instruction(); // branch prediction
+  progress += fetch_from_ftq();
 
   // heartbeat
   if (show_heartbeat && (num_retired >= (last_heartbeat_instr + STAT_PRINTING_PERIOD))) {
@@ -106,22 +108,154 @@ void O3_CPU::end_phase(unsigned finished_cpu)
 }
 
 void O3_CPU::initialize_instruction()
+{
+  // The branch prediction unit walks the instruction stream ahead of fetch, grouping the instructions into fetch blocks in the FTQ
+  champsim::bandwidth instrs_to_predict_this_cycle{FETCH_WIDTH};
+  champsim::bandwidth taken_branches_this_cycle{TAKEN_BRANCHES_PER_CYCLE};
+
+  bool stop_prediction = false;
+  while (current_time >= fetch_resume_time && instrs_to_predict_this_cycle.has_remaining() && !stop_prediction && !std::empty(input_queue)) {
+    auto& arch_instr = input_queue.front();
+    bool joins_last_block =
+        !std::empty(FTQ) && !FTQ.back().redirect && champsim::block_number{FTQ.back().fetch_addr} == champsim::block_number{arch_instr.ip};
+
+    if (!joins_last_block) {
+      // Fetch has already consumed the last block
+      if (!std::empty(FTQ) && std::empty(FTQ.back().instrs)) {
+        FTQ.pop_back();
+      }
+
+      if (std::size(FTQ) >= FTQ_SIZE) {
+        break;
+      }
+
+      FTQ.push_back(ftq_entry{arch_instr.ip});
+      if (!lsd.locked) {
+        l1i->impl_prefetcher_ftq_enqueue(arch_instr.ip, false); // a replayed loop is not fetched
+      }
+    }
+
+    instrs_to_predict_this_cycle.consume();
+    stop_prediction = do_init_instruction(arch_instr);
+    if (LSD_SIZE > 0) {
+      do_loop_stream(arch_instr, std::empty(FTQ.back().instrs));
+    }
+
+    FTQ.back().redirect = stop_prediction;
+
+    // A correctly predicted taken branch ends the block, but prediction may follow it to its target if the BTB has another port
+    if (stop_prediction && !arch_instr.branch_mispredicted) {
+      taken_branches_this_cycle.consume();
+      stop_prediction = !taken_branches_this_cycle.has_remaining();
+    }
+
+    FTQ.back().instrs.push_back(std::move(arch_instr));
+    input_queue.pop_front();
+  }
+}
+
+void O3_CPU::predict_wrong_path()
+{
+  // The misprediction has been resolved, so the wrong path is squashed, even if it had already ended on a branch the BTB could not predict
+  if (fetch_resume_time != champsim::chrono::clock::time_point::max()) {
+    auto wrong_path_begin = std::remove_if(std::begin(FTQ), std::end(FTQ), [](const ftq_entry& x) { return x.wrong_path; });
+    FTQ.erase(wrong_path_begin, std::end(FTQ));
+    wrong_path_addr.reset();
+  }
+
+  if (!wrong_path_addr.has_value() || std::size(FTQ) >= FTQ_SIZE) {
+    return;
+  }
+
+  // The trace does not hold the wrong path, so follow the known branches of the static code, one fetch block per cycle
+  auto fetch_addr = wrong_path_addr.value();
+  champsim::address block_end{champsim::block_number{fetch_addr} + 1};
+  wrong_path_addr = block_end;
+  if (auto branch = code_map.next_branch(fetch_addr, block_end); branch.has_value()) {
+    auto [branch_ip, branch_info] = branch.value();
+    auto [predicted_target, always_taken] = impl_btb_peek(branch_ip, branch_info.branch_type); // the wrong path must not train the BTB
+    if (always_taken || branch_info.taken) {
+      wrong_path_addr = predicted_target;
+    }
+  }
+
+  // A target the BTB cannot predict ends the wrong path
+  if (wrong_path_addr == champsim::address{}) {
+    wrong_path_addr.reset();
+  }
+
+  FTQ.push_back(ftq_entry{fetch_addr, {}, true, true});
+  l1i->impl_prefetcher_ftq_enqueue(fetch_addr, true);
+}
+
+long O3_CPU::fetch_from_ftq()
 {
   champsim::bandwidth instrs_to_read_this_cycle{
       std::min(FETCH_WIDTH, champsim::bandwidth::maximum_type{static_cast<long>(IFETCH_BUFFER_SIZE - std::size(IFETCH_BUFFER))})};
 
-  bool stop_fetch = false;
-  while (current_time >= fetch_resume_time && instrs_to_read_this_cycle.has_remaining() && !stop_fetch && !std::empty(input_queue)) {
-    instrs_to_read_this_cycle.consume();
+  champsim::bandwidth blocks_to_read_this_cycle{FETCH_BLOCKS_PER_CYCLE};
+  champsim::bandwidth taken_branches_this_cycle{TAKEN_BRANCHES_PER_CYCLE};
 
-    stop_fetch = do_init_instruction(input_queue.front());
+  long progress{0};
+  while (instrs_to_read_this_cycle.has_remaining() && blocks_to_read_this_cycle.has_remaining() && taken_branches_this_cycle.has_remaining()
+         && !std::empty(FTQ)) {
+    auto& block = FTQ.front();
+    if (block.wrong_path) {
+      // Wrong-path blocks are fetched only when the correct path is not waiting for the L1I
+      bool correct_path_waiting =
+          std::any_of(std::begin(IFETCH_BUFFER), std::end(IFETCH_BUFFER), [](const ooo_model_instr& x) { return !x.fetch_issued && !x.fetch_completed; });
+      if (!correct_path_waiting && do_fetch_wrong_path(block.fetch_addr)) {
+        FTQ.pop_front();
+        ++progress;
+      }
+      break;
+    }
 
-    // Add to IFETCH_BUFFER
-    IFETCH_BUFFER.push_back(input_queue.front());
-    input_queue.pop_front();
+    blocks_to_read_this_cycle.consume();
+    for (; instrs_to_read_this_cycle.has_remaining() && !std::empty(block.instrs); instrs_to_read_this_cycle.consume()) {
+      IFETCH_BUFFER.push_back(std::move(block.instrs.front()));
+      block.instrs.pop_front();
+
+      IFETCH_BUFFER.back().ready_time = current_time;
+      ++progress;
+
+      auto hints = do_prefetch_hints(IFETCH_BUFFER.back());
+      if (prefetch_hints_take_fetch_slots) {
+        // Each prefetch takes a slot left in this cycle, after the slot of its trigger, which the loop consumes
+        instrs_to_read_this_cycle.consume(std::min(hints, instrs_to_read_this_cycle.amount_remaining() - 1));
+      }
+    }
+
+    // The branch predictor may still be adding to the last block
+    if (!std::empty(block.instrs) || (!block.redirect && std::size(FTQ) == 1)) {
+      break;
+    }
+
+    if (block.redirect) {
+      taken_branches_this_cycle.consume(); // each taken branch in the fetch group needs another port
+    }
+    FTQ.pop_front();
+  }
+
+  return progress;
+}
 
-    IFETCH_BUFFER.back().ready_time = current_time;
+long O3_CPU::do_prefetch_hints(const ooo_model_instr& instr)
+{
+  if (std::empty(prefetch_hints)) {
+    return 0;
   }
+
+  long issued = 0;
+  for (auto target : prefetch_hints.targets(instr.ip.to<uint64_t>())) {
+    if (l1i->prefetch_line(champsim::address{target}, true, 0)) {
+      ++sim_stats.prefetch_hints_issued;
+    } else {
+      ++sim_stats.prefetch_hints_dropped;
+    }
+    ++issued;
+  }
+  return issued;
 }
 
 namespace
@@ -153,8 +287,12 @@ bool O3_CPU::do_predict_branch(ooo_model_instr& arch_instr)
 
   // handle branch prediction for all instructions as at this point we do not know if the instruction is a branch
   sim_stats.total_branch_types.increment(arch_instr.branch);
+  last_btb_lookup = {};
   auto [predicted_branch_target, always_taken] = impl_btb_prediction(arch_instr.ip, arch_instr.branch);
-  arch_instr.branch_prediction = impl_predict_branch(arch_instr.ip, predicted_branch_target, always_taken, arch_instr.branch) || always_taken;
+  auto [fast_prediction, slow_prediction] = impl_predict_branch(arch_instr.ip, predicted_branch_target, always_taken, arch_instr.branch);
+  arch_instr.branch_prediction = slow_prediction || always_taken;
+  bool overridden = SLOW_PREDICTOR_LATENCY > 0 && !always_taken && fast_prediction != slow_prediction;
+  auto btb_target = predicted_branch_target;
   if (!arch_instr.branch_prediction) {
     predicted_branch_target = champsim::address{};
   }
@@ -164,30 +302,113 @@ bool O3_CPU::do_predict_branch(ooo_model_instr& arch_instr)
       fmt::print("[BRANCH] instr_id: {} ip: {} taken: {}\n", arch_instr.instr_id, arch_instr.ip, arch_instr.branch_taken);
     }
 
-    // call code prefetcher every time the branch predictor is used
-    l1i->impl_prefetcher_branch_operate(arch_instr.ip, arch_instr.branch, predicted_branch_target);
+    // call code prefetcher every time the branch predictor is used, with the confidence of the direction predictor unless the BTB knows the
+    // branch is always taken
+    auto confidence = always_taken ? champsim::branch_confidence::high : impl_prediction_confidence(arch_instr.ip);
+    l1i->impl_prefetcher_branch_operate(arch_instr.ip, arch_instr.branch, predicted_branch_target, confidence);
+
+    sim_stats.btb_levels = std::max(sim_stats.btb_levels, last_btb_lookup.levels);
+    auto btb_levels_missed = last_btb_lookup.hit_level.value_or(last_btb_lookup.levels);
+    for (std::size_t level = 0; level < btb_levels_missed; ++level) {
+      sim_stats.btb_level_misses.increment(level);
+    }
+    if (last_btb_lookup.hit_level.has_value()) {
+      sim_stats.btb_level_hits.increment(last_btb_lookup.hit_level.value());
+    }
+    if (arch_instr.branch_taken && btb_target != arch_instr.branch_target) {
+      sim_stats.btb_miss_hotspots.increment(arch_instr.ip.to<uint64_t>());
+    }
 
     if (predicted_branch_target != arch_instr.branch_target
         || (((arch_instr.branch == BRANCH_CONDITIONAL) || (arch_instr.branch == BRANCH_OTHER))
             && arch_instr.branch_taken != arch_instr.branch_prediction)) { // conditional branches are re-evaluated at decode when the target is computed
       sim_stats.total_rob_occupancy_at_branch_mispredict += std::size(ROB);
       sim_stats.branch_type_misses.increment(arch_instr.branch);
+      sim_stats.mispredict_hotspots.increment(std::pair{arch_instr.ip.to<uint64_t>(), arch_instr.branch});
       if (!warmup) {
         fetch_resume_time = champsim::chrono::clock::time_point::max();
         stop_fetch = true;
         arch_instr.branch_mispredicted = true;
+
+        if (WRONG_PATH_FETCH) {
+          // The wrong path begins at the predicted target, or at the next block if the branch was predicted not taken, since the trace does not
+          // give the size of the branch and the rest of its block has already been fetched
+          wrong_path_addr = arch_instr.branch_prediction ? predicted_branch_target : champsim::address{champsim::block_number{arch_instr.ip} + 1};
+          if (wrong_path_addr == champsim::address{}) {
+            wrong_path_addr.reset();
+          }
+        }
       }
     } else {
       stop_fetch = arch_instr.branch_taken; // if correctly predicted taken, then we can't fetch anymore instructions this cycle
+
+      // a slower level of the BTB delays the redirect to the target, which would otherwise be predicted from in the next cycle
+      if (arch_instr.branch_taken && last_btb_lookup.redirect_latency > 0 && !warmup) {
+        fetch_resume_time = std::max(fetch_resume_time, current_time + (last_btb_lookup.redirect_latency + 1) * clock_period);
+        sim_stats.btb_redirect_bubbles += last_btb_lookup.redirect_latency;
+      }
+
+      // the slow predictor disagreed with the fast one, so it redirects the branch prediction unit once its prediction is ready
+      if (overridden && !warmup) {
+        fetch_resume_time = std::max(fetch_resume_time, current_time + (SLOW_PREDICTOR_LATENCY + 1) * clock_period);
+        ++sim_stats.predictor_overrides;
+        sim_stats.predictor_override_bubbles += SLOW_PREDICTOR_LATENCY;
+      }
     }
 
     impl_update_btb(arch_instr.ip, arch_instr.branch_target, arch_instr.branch_taken, arch_instr.branch);
     impl_last_branch_result(arch_instr.ip, arch_instr.branch_target, arch_instr.branch_taken, arch_instr.branch);
+
+    if (WRONG_PATH_FETCH || record_code_map) {
+      code_map.record(arch_instr.ip, arch_instr.branch, arch_instr.branch_target, arch_instr.branch_taken);
+    }
   }
 
   return stop_fetch;
 }
 
+void O3_CPU::do_loop_stream(ooo_model_instr& arch_instr, bool starts_block)
+{
+  // A locked loop is replayed from the LSD, already fetched and decoded
+  if (lsd.locked) {
+    arch_instr.dib_checked = true;
+    arch_instr.fetch_issued = true;
+    arch_instr.fetch_completed = true;
+    arch_instr.decoded = true;
+    ++sim_stats.lsd_hits;
+    if (starts_block) {
+      ++sim_stats.lsd_l1i_accesses_avoided;
+    }
+  }
+
+  bool in_loop = lsd.branch_ip.has_value() && lsd.head <= arch_instr.ip && arch_instr.ip <= lsd.branch_ip.value();
+  bool closes_loop = lsd.branch_ip == arch_instr.ip && arch_instr.branch_taken;
+  if (lsd.locked && (!in_loop || arch_instr.branch_mispredicted || (lsd.branch_ip == arch_instr.ip && !arch_instr.branch_taken))) {
+    lsd = {}; // the loop has exited
+    return;
+  }
+  if (lsd.locked) {
+    return;
+  }
+
+  ++lsd.body_size;
+  if (!in_loop || arch_instr.branch_mispredicted) {
+    lsd.iterations = 0;
+  }
+
+  bool backward_taken = arch_instr.is_branch && arch_instr.branch_taken && arch_instr.branch_target <= arch_instr.ip;
+  if (closes_loop && lsd.body_size <= LSD_SIZE) {
+    ++lsd.iterations;
+    lsd.body_size = 0;
+    if (lsd.iterations >= LSD_LOCK_ITERATIONS) {
+      lsd.locked = true;
+      ++sim_stats.lsd_locks;
+    }
+  } else if (backward_taken) {
+    lsd = {arch_instr.ip, arch_instr.branch_target, 0, 0, false}; // a new candidate loop
+  }
+}
+
 bool O3_CPU::do_init_instruction(ooo_model_instr& arch_instr)
 {
   // fast warmup eliminates register dependencies between instructions branch predictor, cache contents, and prefetchers are still warmed up
@@ -205,15 +426,21 @@ long O3_CPU::check_dib()
   // scan through IFETCH_BUFFER to find instructions that hit in the decoded instruction buffer
   auto begin = std::find_if(std::begin(IFETCH_BUFFER), std::end(IFETCH_BUFFER), [](const ooo_model_instr& x) { return !x.dib_checked; });
   auto [window_begin, window_end] = champsim::get_span(begin, std::end(IFETCH_BUFFER), champsim::bandwidth{FETCH_WIDTH});
-  std::for_each(window_begin, window_end, [this](auto& ifetch_entry) { this->do_check_dib(ifetch_entry); });
-  return std::distance(window_begin, window_end);
+
+  // A switch between the micro-op cache and the decoders stalls the lookups that follow it
+  auto checked_end = window_begin;
+  while (checked_end != window_end && uop_cache_resume_time <= current_time) {
+    do_check_dib(*checked_end);
+    ++checked_end;
+  }
+  return std::distance(window_begin, checked_end);
 }
 
 void O3_CPU::do_check_dib(ooo_model_instr& instr)
 {
   // Check DIB to see if we recently fetched this line
-  auto dib_result = DIB.check_hit(instr.ip);
-  if (dib_result) {
+  bool hit = UOP_CACHE.has_value() ? UOP_CACHE->check_hit(instr.ip) : DIB.check_hit(instr.ip).has_value();
+  if (hit) {
     // The cache line is in the L0, so we can mark this as complete
     instr.fetch_completed = true;
 
@@ -226,8 +453,25 @@ void O3_CPU::do_check_dib(ooo_model_instr& instr)
 
   instr.dib_checked = true;
 
+  if (UOP_CACHE.has_value()) {
+    if (hit) {
+      ++sim_stats.uop_cache_hits;
+    } else {
+      ++sim_stats.uop_cache_misses;
+    }
+
+    if (last_uop_cache_hit.has_value() && last_uop_cache_hit.value() != hit) {
+      ++sim_stats.uop_cache_switches;
+      uop_cache_resume_time = current_time + UOP_CACHE_SWITCH_PENALTY;
+      if (hit) {
+        instr.ready_time = uop_cache_resume_time;
+      }
+    }
+    last_uop_cache_hit = hit;
+  }
+
   if constexpr (champsim::debug_print) {
-    fmt::print("[DIB] {} instr_id: {} ip: {} hit: {} cycle: {}\n", __func__, instr.instr_id, instr.ip, dib_result.has_value(),
+    fmt::print("[DIB] {} instr_id: {} ip: {} hit: {} cycle: {}\n", __func__, instr.instr_id, instr.ip, hit,
                current_time.time_since_epoch() / clock_period);
   }
 }
@@ -252,6 +496,7 @@ long O3_CPU::fetch_instruction()
     if (l1i_req_end != std::end(IFETCH_BUFFER)) {
       l1i_req_end = std::next(l1i_req_end); // adjacent_find returns the first of the non-equal elements
     }
+    l1i_req_end = std::find_if(l1i_req_begin, l1i_req_end, [](const auto& x) { return x.fetch_issued; }); // stop at instructions replayed by the LSD
 
     // Issue to L1I
     auto success = do_fetch_instruction(l1i_req_begin, l1i_req_end);
@@ -280,7 +525,22 @@ bool O3_CPU::do_fetch_instruction(std::deque<ooo_model_instr>::iterator begin, s
                std::size(fetch_packet.instr_depend_on_me), begin->ready_time.time_since_epoch() / clock_period);
   }
 
-  return L1I_bus.issue_read(fetch_packet);
+  return L1I_bus.issue_fetch(fetch_packet);
+}
+
+bool O3_CPU::do_fetch_wrong_path(champsim::address fetch_addr)
+{
+  CacheBus::request_type fetch_packet;
+  fetch_packet.v_address = fetch_addr;
+  fetch_packet.ip = fetch_addr;
+  fetch_packet.response_requested = false; // nothing waits for these instructions
+  fetch_packet.wrong_path = true;
+
+  if constexpr (champsim::debug_print) {
+    fmt::print("[IFETCH] {} wrong path ip: {} cycle: {}\n", __func__, fetch_addr, current_time.time_since_epoch() / clock_period);
+  }
+
+  return L1I_bus.issue_fetch(fetch_packet);
 }
 
 long O3_CPU::promote_to_decode()
@@ -402,7 +662,14 @@ long O3_CPU::decode_instruction()
   return progress;
 }
 
-void O3_CPU::do_dib_update(const ooo_model_instr& instr) { DIB.fill(instr.ip); }
+void O3_CPU::do_dib_update(const ooo_model_instr& instr)
+{
+  if (UOP_CACHE.has_value()) {
+    UOP_CACHE->fill(instr.ip);
+  } else {
+    DIB.fill(instr.ip);
+  }
+}
 
 long O3_CPU::dispatch_instruction()
 {
@@ -723,6 +990,11 @@ long O3_CPU::retire_rob()
     }
   }
 
+  // the instruction prefetcher sees the committed instruction stream in order
+  if (l1i != nullptr) {
+    std::for_each(retire_begin, retire_end, [this](const auto& x) { l1i->impl_prefetcher_retire(x.ip); });
+  }
+
   auto retire_count = std::distance(retire_begin, retire_end);
   num_retired += retire_count;
   ROB.erase(retire_begin, retire_end);
@@ -734,26 +1006,43 @@ void O3_CPU::impl_initialize_branch_predictor() const { branch_module_pimpl->imp
 
 void O3_CPU::impl_last_branch_result(champsim::address ip, champsim::address target, bool taken, uint8_t branch_type) const
 {
+  champsim::scoped_host_timer timer{hook_timers.last_branch_result};
   branch_module_pimpl->impl_last_branch_result(ip, target, taken, branch_type);
 }
 
-bool O3_CPU::impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) const
+auto O3_CPU::impl_predict_branch(champsim::address ip, champsim::address predicted_target, bool always_taken, uint8_t branch_type) const
+    -> branch_prediction_type
 {
+  champsim::scoped_host_timer timer{hook_timers.predict_branch};
   return branch_module_pimpl->impl_predict_branch(ip, predicted_target, always_taken, branch_type);
 }
 
+champsim::branch_confidence O3_CPU::impl_prediction_confidence(champsim::address ip) const
+{
+  champsim::scoped_host_timer timer{hook_timers.predict_branch};
+  return branch_module_pimpl->impl_prediction_confidence(ip);
+}
+
 void O3_CPU::impl_initialize_btb() const { btb_module_pimpl->impl_initialize_btb(); }
 
 void O3_CPU::impl_update_btb(champsim::address ip, champsim::address predicted_target, bool taken, uint8_t branch_type) const
 {
+  champsim::scoped_host_timer timer{hook_timers.update_btb};
   btb_module_pimpl->impl_update_btb(ip, predicted_target, taken, branch_type);
 }
 
 std::pair<champsim::address, bool> O3_CPU::impl_btb_prediction(champsim::address ip, uint8_t branch_type) const
 {
+  champsim::scoped_host_timer timer{hook_timers.btb_prediction};
   return btb_module_pimpl->impl_btb_prediction(ip, branch_type);
 }
 
+std::pair<champsim::address, bool> O3_CPU::impl_btb_peek(champsim::address ip, uint8_t branch_type) const
+{
+  champsim::scoped_host_timer timer{hook_timers.btb_prediction};
+  return btb_module_pimpl->impl_btb_peek(ip, branch_type);
+}
+
 // LCOV_EXCL_START Exclude the following function from LCOV
 void O3_CPU::print_deadlock()
 {
@@ -772,6 +1061,12 @@ void O3_CPU::print_deadlock()
   };
   std::string_view instr_fmt{
       "instr_id: {} fetch_issued: {} fetch_completed: {} scheduled: {} executed: {} completed: {} num_reg_dependent: {} num_mem_ops: {} event: {}"};
+  auto ftq_pack = [](const auto& entry) {
+    std::vector<uint64_t> instr_ids;
+    std::transform(std::begin(entry.instrs), std::end(entry.instrs), std::back_inserter(instr_ids), [](const auto& instr) { return instr.instr_id; });
+    return std::tuple{entry.fetch_addr, entry.redirect, instr_ids};
+  };
+  champsim::range_print_deadlock(FTQ, "cpu" + std::to_string(cpu) + "_FTQ", "fetch_addr: {} redirect: {} instr_ids: {}", ftq_pack);
   champsim::range_print_deadlock(IFETCH_BUFFER, "cpu" + std::to_string(cpu) + "_IFETCH", instr_fmt, instr_pack);
   champsim::range_print_deadlock(DECODE_BUFFER, "cpu" + std::to_string(cpu) + "_DECODE", instr_fmt, instr_pack);
   champsim::range_print_deadlock(DISPATCH_BUFFER, "cpu" + std::to_string(cpu) + "_DISPATCH", instr_fmt, instr_pack);
@@ -837,6 +1132,17 @@ bool CacheBus::issue_read(request_type data_packet)
   return lower_level->add_rq(data_packet);
 }
 
+bool CacheBus::issue_fetch(request_type fetch_packet)
+{
+  fetch_packet.address = fetch_packet.v_address;
+  fetch_packet.is_translated = false;
+  fetch_packet.cpu = cpu;
+  fetch_packet.type = access_type::IFETCH;
+  fetch_packet.is_instruction = true;
+
+  return lower_level->add_rq(fetch_packet);
+}
+
 bool CacheBus::issue_write(request_type data_packet)
 {
   data_packet.address = data_packet.v_address;
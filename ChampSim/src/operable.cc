@@ -33,6 +33,7 @@ long champsim::operable::operate_on(const champsim::chrono::clock& clock)
 long champsim::operable::_operate()
 {
   current_time += clock_period;
+  champsim::scoped_host_timer timer{operate_timer};
   return operate();
 }
 
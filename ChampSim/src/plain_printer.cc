@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 #include <ratio>
@@ -36,6 +37,19 @@ auto print_ratio(N num, D denom)
   }
   return std::string{"-"};
 }
+
+template <typename Counter, typename F>
+void format_hotspots(std::vector<std::string>& lines, std::string_view title, const Counter& counter, F&& describe)
+{
+  if (counter.empty()) {
+    return;
+  }
+
+  lines.emplace_back(title);
+  for (const auto& entry : counter.top()) {
+    lines.push_back(fmt::format("  {} COUNT: {:10} ERROR: {:10}", describe(entry.key), entry.count, entry.error));
+  }
+}
 } // namespace
 
 std::vector<std::string> champsim::plain_printer::format(O3_CPU::stats_type stats)
@@ -56,12 +70,45 @@ std::vector<std::string> champsim::plain_printer::format(O3_CPU::stats_type stat
                               ::print_ratio(std::kilo::num * total_mispredictions, stats.instrs()),
                               ::print_ratio(stats.total_rob_occupancy_at_branch_mispredict, total_mispredictions)));
 
+  if (stats.btb_levels > 1) {
+    for (std::size_t level = 0; level < stats.btb_levels; ++level) {
+      lines.push_back(fmt::format("{} BTB level {} HIT: {:10} MISS: {:10}", stats.name, level + 1, stats.btb_level_hits.value_or(level, 0),
+                                  stats.btb_level_misses.value_or(level, 0)));
+    }
+    lines.push_back(fmt::format("{} BTB redirect bubbles: {} cycles", stats.name, stats.btb_redirect_bubbles));
+  }
+
+  if (stats.predictor_overrides > 0) {
+    lines.push_back(fmt::format("{} Branch predictor overrides: {} bubbles: {} cycles", stats.name, stats.predictor_overrides,
+                                stats.predictor_override_bubbles));
+  }
+
+  if (stats.lsd_locks > 0) {
+    lines.push_back(fmt::format("{} LSD locks: {} hits: {} L1I accesses avoided: {}", stats.name, stats.lsd_locks, stats.lsd_hits,
+                                stats.lsd_l1i_accesses_avoided));
+  }
+
+  if (auto uop_cache_accesses = stats.uop_cache_hits + stats.uop_cache_misses; uop_cache_accesses > 0) {
+    lines.push_back(fmt::format("{} uop cache hit rate: {}% switches: {}", stats.name, ::print_ratio(100 * stats.uop_cache_hits, uop_cache_accesses),
+                                stats.uop_cache_switches));
+  }
+
+  if (stats.prefetch_hints_issued + stats.prefetch_hints_dropped > 0) {
+    lines.push_back(fmt::format("{} code prefetch hints issued: {} dropped: {}", stats.name, stats.prefetch_hints_issued, stats.prefetch_hints_dropped));
+  }
+
   lines.emplace_back("Branch type MPKI");
   for (auto idx : types) {
     lines.push_back(fmt::format("{}: {}", branch_type_names.at(champsim::to_underlying(idx)),
                                 ::print_ratio(std::kilo::num * stats.branch_type_misses.value_or(idx, 0), stats.instrs())));
   }
 
+  ::format_hotspots(lines, fmt::format("{} branch mispredict hotspots", stats.name), stats.mispredict_hotspots, [](auto key) {
+    return fmt::format("IP: {:#018x} {:<20}", key.first, branch_type_names.at(champsim::to_underlying(key.second)));
+  });
+  ::format_hotspots(lines, fmt::format("{} BTB miss hotspots", stats.name), stats.btb_miss_hotspots,
+                    [](auto key) { return fmt::format("IP: {:#018x}", key); });
+
   return lines;
 }
 
@@ -83,7 +130,7 @@ std::vector<std::string> champsim::plain_printer::format(CACHE::stats_type stats
   auto uniq_end = std::unique(std::begin(cpus), std::end(cpus));
   cpus.erase(uniq_end, std::end(cpus));
 
-  for (const auto type : {access_type::LOAD, access_type::RFO, access_type::PREFETCH, access_type::WRITE, access_type::TRANSLATION}) {
+  for (const auto type : {access_type::LOAD, access_type::RFO, access_type::PREFETCH, access_type::WRITE, access_type::TRANSLATION, access_type::IFETCH}) {
     for (auto cpu : cpus) {
       stats.hits.allocate(std::pair{type, cpu});
       stats.misses.allocate(std::pair{type, cpu});
@@ -98,7 +145,7 @@ std::vector<std::string> champsim::plain_printer::format(CACHE::stats_type stats
     misses_value_type total_misses = 0;
     mshr_merge_value_type total_mshr_merge = 0;
     mshr_return_value_type total_mshr_return = 0;
-    for (const auto type : {access_type::LOAD, access_type::RFO, access_type::PREFETCH, access_type::WRITE, access_type::TRANSLATION}) {
+    for (const auto type : {access_type::LOAD, access_type::RFO, access_type::PREFETCH, access_type::WRITE, access_type::TRANSLATION, access_type::IFETCH}) {
       total_hits += stats.hits.value_or(std::pair{type, cpu}, hits_value_type{});
       total_misses += stats.misses.value_or(std::pair{type, cpu}, misses_value_type{});
       total_mshr_merge += stats.mshr_merge.value_or(std::pair{type, cpu}, mshr_merge_value_type{});
@@ -108,7 +155,7 @@ std::vector<std::string> champsim::plain_printer::format(CACHE::stats_type stats
     fmt::format_string<std::string_view, std::string_view, int, int, int> hitmiss_fmtstr{
         "cpu{}->{} {:<12s} ACCESS: {:10d} HIT: {:10d} MISS: {:10d} MSHR_MERGE: {:10d}"};
     lines.push_back(fmt::format(hitmiss_fmtstr, cpu, stats.name, "TOTAL", total_hits + total_misses, total_hits, total_misses, total_mshr_merge));
-    for (const auto type : {access_type::LOAD, access_type::RFO, access_type::PREFETCH, access_type::WRITE, access_type::TRANSLATION}) {
+    for (const auto type : {access_type::LOAD, access_type::RFO, access_type::PREFETCH, access_type::WRITE, access_type::TRANSLATION, access_type::IFETCH}) {
       lines.push_back(
           fmt::format(hitmiss_fmtstr, cpu, stats.name, access_type_names.at(champsim::to_underlying(type)),
                       stats.hits.value_or(std::pair{type, cpu}, hits_value_type{}) + stats.misses.value_or(std::pair{type, cpu}, misses_value_type{}),
@@ -116,14 +163,38 @@ std::vector<std::string> champsim::plain_printer::format(CACHE::stats_type stats
                       stats.mshr_merge.value_or(std::pair{type, cpu}, mshr_merge_value_type{})));
     }
 
+    auto instruction_hits = stats.hits.value_or(std::pair{access_type::IFETCH, cpu}, hits_value_type{});
+    auto instruction_misses = stats.misses.value_or(std::pair{access_type::IFETCH, cpu}, misses_value_type{});
+    if (instruction_hits + instruction_misses > 0) {
+      lines.push_back(fmt::format("cpu{}->{} INSTRUCTION HIT RATE: {} DATA HIT RATE: {}", cpu, stats.name,
+                                  ::print_ratio(instruction_hits, instruction_hits + instruction_misses),
+                                  ::print_ratio(total_hits - instruction_hits, total_hits + total_misses - instruction_hits - instruction_misses)));
+    }
+
     lines.push_back(fmt::format("cpu{}->{} PREFETCH REQUESTED: {:10} ISSUED: {:10} USEFUL: {:10} USELESS: {:10}", cpu, stats.name, stats.pf_requested,
                                 stats.pf_issued, stats.pf_useful, stats.pf_useless));
 
+    if (stats.translation_pf_issued > 0) {
+      lines.push_back(fmt::format("cpu{}->{} TRANSLATION PREFETCH ISSUED: {:10} USEFUL: {:10}", cpu, stats.name, stats.translation_pf_issued,
+                                  stats.translation_pf_useful));
+    }
+
+    if (stats.wrong_path_fill > 0) {
+      lines.push_back(fmt::format("cpu{}->{} WRONG-PATH FILL: {:10} USEFUL: {:10}", cpu, stats.name, stats.wrong_path_fill, stats.wrong_path_useful));
+    }
+
     uint64_t total_downstream_demands = total_mshr_return - stats.mshr_return.value_or(std::pair{access_type::PREFETCH, cpu}, mshr_return_value_type{});
     lines.push_back(
         fmt::format("cpu{}->{} AVERAGE MISS LATENCY: {} cycles", cpu, stats.name, ::print_ratio(stats.total_miss_latency_cycles, total_downstream_demands)));
   }
 
+  ::format_hotspots(lines, fmt::format("{} demand miss hotspots by block", stats.name), stats.miss_block_hotspots,
+                    [](auto key) { return fmt::format("cpu{} BLOCK: {:#018x}", key.first, key.second); });
+  ::format_hotspots(lines, fmt::format("{} demand miss hotspots by IP", stats.name), stats.miss_ip_hotspots,
+                    [](auto key) { return fmt::format("cpu{} IP: {:#018x}", key.first, key.second); });
+  ::format_hotspots(lines, fmt::format("{} late prefetch hotspots by block", stats.name), stats.late_prefetch_hotspots,
+                    [](auto key) { return fmt::format("cpu{} BLOCK: {:#018x}", key.first, key.second); });
+
   return lines;
 }
 
@@ -132,6 +203,13 @@ std::vector<std::string> champsim::plain_printer::format(DRAM_CHANNEL::stats_typ
   std::vector<std::string> lines{};
   lines.push_back(fmt::format("{} RQ ROW_BUFFER_HIT: {:10}", stats.name, stats.RQ_ROW_BUFFER_HIT));
   lines.push_back(fmt::format("  ROW_BUFFER_MISS: {:10}", stats.RQ_ROW_BUFFER_MISS));
+  for (const auto type : {access_type::LOAD, access_type::RFO, access_type::PREFETCH, access_type::TRANSLATION, access_type::IFETCH}) {
+    auto hits = stats.RQ_ROW_BUFFER_HIT_BY_TYPE.value_or(type, 0);
+    auto misses = stats.RQ_ROW_BUFFER_MISS_BY_TYPE.value_or(type, 0);
+    if (hits + misses > 0) {
+      lines.push_back(fmt::format("  {:<12s} ROW_BUFFER_HIT: {:10} ROW_BUFFER_MISS: {:10}", access_type_names.at(champsim::to_underlying(type)), hits, misses));
+    }
+  }
   lines.push_back(fmt::format("  AVG DBUS CONGESTED CYCLE: {}", ::print_ratio(stats.dbus_cycle_congested, stats.dbus_count_congested)));
   lines.push_back(fmt::format("{} WQ ROW_BUFFER_HIT: {:10}", stats.name, stats.WQ_ROW_BUFFER_HIT));
   lines.push_back(fmt::format("  ROW_BUFFER_MISS: {:10}", stats.WQ_ROW_BUFFER_MISS));
@@ -145,6 +223,25 @@ std::vector<std::string> champsim::plain_printer::format(DRAM_CHANNEL::stats_typ
   return lines;
 }
 
+std::vector<std::string> champsim::plain_printer::format(const champsim::host_profile& profile)
+{
+  std::vector<std::string> lines{};
+  lines.push_back(fmt::format("Host time: {:.3f} s", profile.seconds));
+  for (std::size_t cpu = 0; cpu < std::size(profile.instructions); ++cpu) {
+    lines.push_back(fmt::format("CPU {} instructions: {} KIPS: {:.4g}", cpu, profile.instructions.at(cpu), profile.kips(cpu)));
+  }
+
+  for (const auto& entry : profile.entries) {
+    if (entry.calls > 0) {
+      lines.push_back(fmt::format("{:<8} {:<26} HOST TIME: {:10.3f} s ({:5.1f}%) CALLS: {:12} PER CALL: {:8.1f} ns", entry.name, entry.hook, entry.seconds,
+                                  (profile.seconds > 0 ? 100.0 * entry.seconds / profile.seconds : 0.0), entry.calls,
+                                  1e9 * entry.seconds / static_cast<double>(entry.calls)));
+    }
+  }
+
+  return lines;
+}
+
 void champsim::plain_printer::print(champsim::phase_stats& stats)
 {
   auto lines = format(stats);
@@ -201,6 +298,13 @@ std::vector<std::string> champsim::plain_printer::format(champsim::phase_stats&
     std::move(std::begin(sublines), std::end(sublines), std::back_inserter(lines));
   }
 
+  if (stats.profile.enabled) {
+    lines.emplace_back("");
+    lines.emplace_back("Host Profile (module hooks are included in the operate time of their owner)");
+    auto sublines = format(stats.profile);
+    std::move(std::begin(sublines), std::end(sublines), std::back_inserter(lines));
+  }
+
   return lines;
 }
 
@@ -0,0 +1,49 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "static_code_map.h"
+
+#include <algorithm>
+#include <iterator>
+
+void champsim::static_code_map::record(champsim::address ip, uint8_t branch_type, champsim::address target, bool taken)
+{
+  auto& entry = branches[ip];
+  entry.branch_type = branch_type;
+  entry.taken = taken;
+  if (taken) {
+    entry.target = target;
+  }
+}
+
+auto champsim::static_code_map::next_branch(champsim::address begin, champsim::address end) const -> std::optional<value_type>
+{
+  auto found = branches.lower_bound(begin);
+  if (found == std::end(branches) || found->first >= end) {
+    return std::nullopt;
+  }
+  return *found;
+}
+
+auto champsim::static_code_map::branches_in(champsim::address begin, champsim::address end) const -> std::vector<value_type>
+{
+  std::vector<value_type> retval;
+  if (end <= begin) {
+    return retval;
+  }
+  std::copy(branches.lower_bound(begin), branches.lower_bound(end), std::back_inserter(retval));
+  return retval;
+}
@@ -0,0 +1,483 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "synthetic_trace.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+// General-purpose registers, avoiding the stack pointer, flags, and instruction pointer that mark branches
+constexpr std::array<unsigned char, 20> general_registers{1, 2, 3, 4, 5, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21};
+
+// Pointer-chasing loads each hold their pointer in a register that no other instruction writes
+constexpr unsigned char first_chase_register = 32;
+constexpr unsigned char num_chase_registers = 64;
+
+constexpr uint64_t word_size = 8;
+
+uint64_t mix(uint64_t x)
+{
+  // splitmix64 finalizer
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+std::string_view trim(std::string_view str)
+{
+  auto first = str.find_first_not_of(" \t");
+  auto last = str.find_last_not_of(" \t");
+  return first == std::string_view::npos ? std::string_view{} : str.substr(first, last - first + 1);
+}
+
+std::vector<std::string_view> split(std::string_view str, char delim)
+{
+  std::vector<std::string_view> retval;
+  while (!std::empty(str)) {
+    auto pos = str.find(delim);
+    retval.push_back(trim(str.substr(0, pos)));
+    str = (pos == std::string_view::npos) ? std::string_view{} : str.substr(pos + 1);
+  }
+  return retval;
+}
+
+int64_t parse_size(std::string_view key, std::string_view value)
+{
+  std::string str{value};
+  std::size_t consumed = 0;
+  int64_t retval = 0;
+  try {
+    retval = std::stoll(str, &consumed, 0);
+  } catch (const std::logic_error&) {
+    throw std::invalid_argument{"Synthetic trace parameter " + std::string{key} + " has an invalid value " + str};
+  }
+
+  if (consumed + 1 == std::size(str)) {
+    switch (std::toupper(str.back())) {
+    case 'G':
+      retval *= 1024;
+      [[fallthrough]];
+    case 'M':
+      retval *= 1024;
+      [[fallthrough]];
+    case 'K':
+      retval *= 1024;
+      ++consumed;
+      break;
+    default:
+      break;
+    }
+  }
+
+  if (consumed != std::size(str)) {
+    throw std::invalid_argument{"Synthetic trace parameter " + std::string{key} + " has an invalid value " + str};
+  }
+  return retval;
+}
+
+uint64_t parse_unsigned(std::string_view key, std::string_view value)
+{
+  auto retval = parse_size(key, value);
+  if (retval < 0) {
+    throw std::invalid_argument{"Synthetic trace parameter " + std::string{key} + " must not be negative"};
+  }
+  return static_cast<uint64_t>(retval);
+}
+
+double parse_double(std::string_view key, std::string_view value)
+{
+  std::string str{value};
+  std::size_t consumed = 0;
+  double retval = 0;
+  try {
+    retval = std::stod(str, &consumed);
+  } catch (const std::logic_error&) {
+    consumed = 0;
+  }
+  if (consumed == 0 || consumed != std::size(str)) {
+    throw std::invalid_argument{"Synthetic trace parameter " + std::string{key} + " has an invalid value " + str};
+  }
+  return retval;
+}
+
+bool parse_bool(std::string_view key, std::string_view value)
+{
+  if (value == "true" || value == "1") {
+    return true;
+  }
+  if (value == "false" || value == "0") {
+    return false;
+  }
+  throw std::invalid_argument{"Synthetic trace parameter " + std::string{key} + " has an invalid value " + std::string{value}};
+}
+
+using param_setter = std::function<void(champsim::synthetic_trace_parameters&, std::string_view, std::string_view)>;
+
+template <typename T>
+param_setter set_unsigned(T champsim::synthetic_trace_parameters::*member)
+{
+  return [member](auto& params, auto key, auto value) {
+    params.*member = static_cast<T>(parse_unsigned(key, value));
+  };
+}
+
+param_setter set_double(double champsim::synthetic_trace_parameters::*member)
+{
+  return [member](auto& params, auto key, auto value) {
+    params.*member = parse_double(key, value);
+  };
+}
+
+void validate(const champsim::synthetic_trace_parameters& params)
+{
+  auto fail = [](const std::string& what) {
+    throw std::invalid_argument{"Synthetic trace parameters are invalid: " + what};
+  };
+
+  if (params.code_footprint == 0 || params.data_footprint < word_size) {
+    fail("the code and data footprints must not be empty");
+  }
+  if (params.data_base == 0) {
+    fail("the data base address must not be zero");
+  }
+  if (params.instruction_size == 0 || params.min_block_size == 0 || params.min_block_size > params.max_block_size) {
+    fail("the block sizes must satisfy 0 < min_block_size <= max_block_size");
+  }
+  if (params.indirect_targets == 0) {
+    fail("indirect branches must have at least one target");
+  }
+
+  std::array fractions{params.jump_fraction,          params.call_fraction,    params.return_fraction, params.indirect_fraction,
+                       params.indirect_call_fraction, params.branch_bias,      params.load_fraction,   params.store_fraction,
+                       params.stride_fraction,        params.pointer_chase_fraction};
+  if (std::any_of(std::begin(fractions), std::end(fractions), [](auto x) { return x < 0 || x > 1; })) {
+    fail("fractions and biases must be between 0 and 1");
+  }
+  if (params.jump_fraction + params.call_fraction + params.return_fraction + params.indirect_fraction + params.indirect_call_fraction > 1) {
+    fail("the unconditional branch fractions sum to more than 1");
+  }
+  if (params.load_fraction + params.store_fraction > 1) {
+    fail("the load and store fractions sum to more than 1");
+  }
+  if (params.stride_fraction + params.pointer_chase_fraction > 1) {
+    fail("the stride and pointer chase fractions sum to more than 1");
+  }
+}
+} // namespace
+
+champsim::synthetic_trace_parameters champsim::parse_synthetic_trace_parameters(std::string_view spec)
+{
+  using P = champsim::synthetic_trace_parameters;
+  const std::map<std::string_view, param_setter> setters{
+      {"seed", set_unsigned(&P::seed)},
+      {"length", set_unsigned(&P::length)},
+      {"code_base", set_unsigned(&P::code_base)},
+      {"code_footprint", set_unsigned(&P::code_footprint)},
+      {"instruction_size", set_unsigned(&P::instruction_size)},
+      {"min_block_size", set_unsigned(&P::min_block_size)},
+      {"max_block_size", set_unsigned(&P::max_block_size)},
+      {"geometric_block_size", [](auto& params, auto key, auto value) { params.geometric_block_size = parse_bool(key, value); }},
+      {"jump_fraction", set_double(&P::jump_fraction)},
+      {"call_fraction", set_double(&P::call_fraction)},
+      {"return_fraction", set_double(&P::return_fraction)},
+      {"indirect_fraction", set_double(&P::indirect_fraction)},
+      {"indirect_call_fraction", set_double(&P::indirect_call_fraction)},
+      {"branch_bias", set_double(&P::branch_bias)},
+      {"branch_distance", set_unsigned(&P::branch_distance)},
+      {"max_call_depth", set_unsigned(&P::max_call_depth)},
+      {"indirect_targets", set_unsigned(&P::indirect_targets)},
+      {"indirect_skew", set_double(&P::indirect_skew)},
+      {"data_base", set_unsigned(&P::data_base)},
+      {"data_footprint", set_unsigned(&P::data_footprint)},
+      {"load_fraction", set_double(&P::load_fraction)},
+      {"store_fraction", set_double(&P::store_fraction)},
+      {"strides",
+       [](auto& params, auto key, auto value) {
+         params.strides.clear();
+         for (auto stride : split(value, ':')) {
+           params.strides.push_back(parse_size(key, stride));
+         }
+       }},
+      {"stride_fraction", set_double(&P::stride_fraction)},
+      {"pointer_chase_fraction", set_double(&P::pointer_chase_fraction)}};
+
+  synthetic_trace_parameters retval{};
+  for (auto pair : split(spec, ',')) {
+    if (std::empty(pair)) {
+      continue;
+    }
+
+    auto eq = pair.find('=');
+    if (eq == std::string_view::npos) {
+      throw std::invalid_argument{"Synthetic trace parameter " + std::string{pair} + " has no value"};
+    }
+
+    auto key = trim(pair.substr(0, eq));
+    auto setter = setters.find(key);
+    if (setter == std::end(setters)) {
+      throw std::invalid_argument{"Unknown synthetic trace parameter " + std::string{key}};
+    }
+    setter->second(retval, key, trim(pair.substr(eq + 1)));
+  }
+
+  validate(retval);
+  return retval;
+}
+
+bool champsim::is_synthetic_trace_name(std::string_view name)
+{
+  return name == synthetic_trace_prefix.substr(0, std::size(synthetic_trace_prefix) - 1) || name.substr(0, std::size(synthetic_trace_prefix)) == synthetic_trace_prefix;
+}
+
+champsim::synthetic_trace_generator::synthetic_trace_generator(synthetic_trace_parameters p) : params(std::move(p)), rng(params.seed)
+{
+  validate(params);
+
+  std::vector<double> weights;
+  for (unsigned i = 0; i < params.indirect_targets; ++i) {
+    weights.push_back(std::pow(static_cast<double>(i + 1), -params.indirect_skew));
+  }
+  indirect_dist = std::discrete_distribution<std::size_t>{std::begin(weights), std::end(weights)};
+
+  build_program();
+}
+
+void champsim::synthetic_trace_generator::build_program()
+{
+  std::uniform_int_distribution<unsigned> uniform_size{params.min_block_size, params.max_block_size};
+  const double mean_extra_size = (params.max_block_size - params.min_block_size) / 2.0;
+  std::geometric_distribution<unsigned> geometric_size{1.0 / (mean_extra_size + 1.0)};
+  std::uniform_real_distribution<double> unit{};
+  std::uniform_int_distribution<std::size_t> any_register{0, std::size(general_registers) - 1};
+  std::uniform_int_distribution<uint64_t> any_word{0, params.data_footprint / word_size - 1};
+
+  auto make_stream = [&, this](bool is_load) {
+    auto pattern_draw = unit(rng);
+    memory_stream stream{address_pattern::RANDOM, 0, any_word(rng) * word_size};
+    if (pattern_draw < params.stride_fraction && !std::empty(params.strides)) {
+      stream.pattern = address_pattern::STRIDE;
+      stream.stride = params.strides.at(std::uniform_int_distribution<std::size_t>{0, std::size(params.strides) - 1}(rng));
+    } else if (pattern_draw < params.stride_fraction + params.pointer_chase_fraction && is_load) {
+      stream.pattern = address_pattern::POINTER_CHASE;
+    }
+    streams.push_back(stream);
+    return std::size(streams) - 1;
+  };
+
+  auto make_body_instr = [&, this]() {
+    static_instr instr{instr_kind::ALU, 0, general_registers.at(any_register(rng)), general_registers.at(any_register(rng))};
+    auto kind_draw = unit(rng);
+    if (kind_draw < params.load_fraction) {
+      instr.kind = instr_kind::LOAD;
+      instr.stream = make_stream(true);
+      if (streams.at(instr.stream).pattern == address_pattern::POINTER_CHASE) {
+        instr.dest = static_cast<unsigned char>(first_chase_register + instr.stream % num_chase_registers);
+        instr.src = instr.dest;
+      }
+    } else if (kind_draw < params.load_fraction + params.store_fraction) {
+      instr.kind = instr_kind::STORE;
+      instr.stream = make_stream(false);
+    }
+    return instr;
+  };
+
+  auto make_branch_kind = [&, this]() {
+    auto draw = unit(rng);
+    for (auto [fraction, kind] : {std::pair{params.jump_fraction, branch_kind::JUMP}, std::pair{params.call_fraction, branch_kind::CALL},
+                                  std::pair{params.return_fraction, branch_kind::RETURN}, std::pair{params.indirect_fraction, branch_kind::INDIRECT},
+                                  std::pair{params.indirect_call_fraction, branch_kind::INDIRECT_CALL}}) {
+      if (draw < fraction) {
+        return kind;
+      }
+      draw -= fraction;
+    }
+    return branch_kind::CONDITIONAL;
+  };
+
+  // Lay out the blocks
+  for (uint64_t ip = params.code_base; ip < params.code_base + params.code_footprint || std::empty(blocks);) {
+    auto size = params.geometric_block_size ? std::min(params.min_block_size + geometric_size(rng), params.max_block_size) : uniform_size(rng);
+
+    basic_block block{ip, {}, make_branch_kind(), 0, {}, 0};
+    std::generate_n(std::back_inserter(block.body), size - 1, make_body_instr);
+    blocks.push_back(std::move(block));
+
+    ip += uint64_t{size} * params.instruction_size;
+  }
+
+  // The last block cannot fall through, so it returns to the start of the program
+  blocks.back().branch = branch_kind::JUMP;
+
+  // Choose the branch targets
+  std::uniform_int_distribution<std::size_t> any_block{0, std::size(blocks) - 1};
+  std::uniform_int_distribution<std::size_t> distance{1, std::max<std::size_t>(params.branch_distance, 1)};
+  for (std::size_t i = 0; i < std::size(blocks); ++i) {
+    auto& block = blocks[i];
+    switch (block.branch) {
+    case branch_kind::CONDITIONAL: {
+      auto offset = distance(rng) % std::size(blocks);
+      block.taken_target = (unit(rng) < 0.5) ? (i + offset) % std::size(blocks) : (i + std::size(blocks) - offset) % std::size(blocks);
+      block.taken_probability = (unit(rng) < 0.5) ? params.branch_bias : 1 - params.branch_bias;
+      break;
+    }
+    case branch_kind::JUMP:
+    case branch_kind::CALL:
+      block.taken_target = any_block(rng);
+      break;
+    case branch_kind::INDIRECT:
+    case branch_kind::INDIRECT_CALL:
+      std::generate_n(std::back_inserter(block.targets), params.indirect_targets, [&] { return any_block(rng); });
+      break;
+    case branch_kind::RETURN:
+      break;
+    }
+  }
+  blocks.back().taken_target = 0;
+}
+
+uint64_t champsim::synthetic_trace_generator::next_data_address(memory_stream& stream)
+{
+  const auto footprint = static_cast<int64_t>(params.data_footprint - params.data_footprint % word_size);
+  switch (stream.pattern) {
+  case address_pattern::STRIDE:
+    stream.offset = static_cast<uint64_t>(((static_cast<int64_t>(stream.offset) + stream.stride) % footprint + footprint) % footprint);
+    break;
+  case address_pattern::POINTER_CHASE:
+    // Each pointer-chasing load walks a fixed pseudo-random list
+    stream.offset = (mix(stream.offset ^ params.seed) % (params.data_footprint / word_size)) * word_size;
+    break;
+  case address_pattern::RANDOM:
+    stream.offset = std::uniform_int_distribution<uint64_t>{0, params.data_footprint / word_size - 1}(rng) * word_size;
+    break;
+  }
+  return params.data_base + stream.offset;
+}
+
+input_instr champsim::synthetic_trace_generator::branch_instr(const basic_block& block)
+{
+  input_instr retval{};
+  retval.ip = block.ip + std::size(block.body) * params.instruction_size;
+  retval.is_branch = 1;
+  retval.branch_taken = 1;
+
+  const auto indirect_register = general_registers.at(current_block % std::size(general_registers));
+  auto push_return = [this] {
+    if (std::size(call_stack) >= params.max_call_depth && !std::empty(call_stack)) {
+      call_stack.erase(std::begin(call_stack));
+    }
+    if (params.max_call_depth > 0) {
+      call_stack.push_back((current_block + 1) % std::size(blocks));
+    }
+  };
+
+  auto next_block = current_block;
+  switch (block.branch) {
+  case branch_kind::CONDITIONAL:
+    retval.branch_taken = std::bernoulli_distribution{block.taken_probability}(rng) ? 1 : 0;
+    retval.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    retval.source_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    retval.source_registers[1] = champsim::REG_FLAGS;
+    next_block = retval.branch_taken ? block.taken_target : current_block + 1;
+    break;
+  case branch_kind::JUMP:
+    retval.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    next_block = block.taken_target;
+    break;
+  case branch_kind::INDIRECT:
+    retval.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    retval.source_registers[0] = indirect_register;
+    next_block = block.targets.at(indirect_dist(rng));
+    break;
+  case branch_kind::CALL:
+    retval.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    retval.destination_registers[1] = champsim::REG_STACK_POINTER;
+    retval.source_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    retval.source_registers[1] = champsim::REG_STACK_POINTER;
+    push_return();
+    next_block = block.taken_target;
+    break;
+  case branch_kind::INDIRECT_CALL:
+    retval.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    retval.destination_registers[1] = champsim::REG_STACK_POINTER;
+    retval.source_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    retval.source_registers[1] = champsim::REG_STACK_POINTER;
+    retval.source_registers[2] = indirect_register;
+    push_return();
+    next_block = block.targets.at(indirect_dist(rng));
+    break;
+  case branch_kind::RETURN:
+    retval.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+    retval.destination_registers[1] = champsim::REG_STACK_POINTER;
+    retval.source_registers[0] = champsim::REG_STACK_POINTER;
+    if (std::empty(call_stack)) {
+      // An unmatched return leaves for an arbitrary block
+      next_block = std::uniform_int_distribution<std::size_t>{0, std::size(blocks) - 1}(rng);
+    } else {
+      next_block = call_stack.back();
+      call_stack.pop_back();
+    }
+    break;
+  }
+
+  current_block = next_block;
+  current_pos = 0;
+  return retval;
+}
+
+input_instr champsim::synthetic_trace_generator::operator()()
+{
+  ++generated;
+
+  auto& block = blocks.at(current_block);
+  if (current_pos == std::size(block.body)) {
+    return branch_instr(block);
+  }
+
+  const auto& instr = block.body.at(current_pos);
+  input_instr retval{};
+  retval.ip = block.ip + current_pos * params.instruction_size;
+  ++current_pos;
+
+  switch (instr.kind) {
+  case instr_kind::ALU:
+    retval.destination_registers[0] = instr.dest;
+    retval.source_registers[0] = instr.src;
+    break;
+  case instr_kind::LOAD:
+    retval.destination_registers[0] = instr.dest;
+    retval.source_registers[0] = instr.src;
+    retval.source_memory[0] = next_data_address(streams.at(instr.stream));
+    break;
+  case instr_kind::STORE:
+    retval.source_registers[0] = instr.dest;
+    retval.source_registers[1] = instr.src;
+    retval.destination_memory[0] = next_data_address(streams.at(instr.stream));
+    break;
+  }
+
+  return retval;
+}
+
+bool champsim::synthetic_trace_generator::eof() const { return params.length > 0 && generated >= params.length; }
@@ -16,6 +16,7 @@
 
 #include "tracereader.h"
 
+#include <algorithm>
 #include <fstream>
 #include <string>
 
@@ -32,6 +33,43 @@ ooo_model_instr apply_branch_target(ooo_model_instr branch, const ooo_model_inst
   return branch;
 }
 
+synthetic_tracereader::synthetic_tracereader(uint8_t cpu_idx, synthetic_trace_parameters params) : cpu(cpu_idx), generator(std::move(params)) {}
+
+synthetic_tracereader::synthetic_tracereader(uint8_t cpu_idx, std::string_view name)
+    : synthetic_tracereader(cpu_idx, parse_synthetic_trace_parameters(name.substr(std::min(std::size(name), std::size(synthetic_trace_prefix)))))
+{
+}
+
+ooo_model_instr synthetic_tracereader::operator()()
+{
+  // Hold one instruction back, so that branches can learn their targets
+  if (!lookahead.has_value()) {
+    lookahead = ooo_model_instr{cpu, generator()};
+  }
+
+  auto retval = *lookahead;
+  if (generator.eof()) {
+    lookahead.reset();
+    eof_ = true;
+    return retval;
+  }
+
+  lookahead = ooo_model_instr{cpu, generator()};
+  return apply_branch_target(retval, *lookahead);
+}
+
+code_layout_tracereader::code_layout_tracereader(tracereader reader, code_layout new_layout) : inner(std::move(reader)), layout(std::move(new_layout)) {}
+
+ooo_model_instr code_layout_tracereader::operator()()
+{
+  auto retval = inner();
+  retval.ip = champsim::address{layout.remap(retval.ip.to<uint64_t>())};
+  if (retval.branch_target != champsim::address{}) {
+    retval.branch_target = champsim::address{layout.remap(retval.branch_target.to<uint64_t>())};
+  }
+  return retval;
+}
+
 template <template <class, class> typename R, typename T>
 champsim::tracereader get_tracereader_for_type(std::string fname, uint8_t cpu)
 {
@@ -51,11 +89,21 @@ champsim::tracereader get_tracereader_for_type(std::string fname, uint8_t cpu)
 }
 } // namespace champsim
 
+using repeatable_synthetic_reader_t = champsim::repeatable<champsim::synthetic_tracereader, uint8_t, std::string>;
+
 template <typename T, typename S>
 using repeatable_reader_t = champsim::repeatable<champsim::bulk_tracereader<T, S>, uint8_t, std::string>;
 
 champsim::tracereader get_tracereader(const std::string& fname, uint8_t cpu, bool is_cloudsuite, bool repeat)
 {
+  if (champsim::is_synthetic_trace_name(fname) && repeat) {
+    return champsim::tracereader{repeatable_synthetic_reader_t(cpu, fname)};
+  }
+
+  if (champsim::is_synthetic_trace_name(fname)) {
+    return champsim::tracereader{champsim::synthetic_tracereader(cpu, fname)};
+  }
+
   if (is_cloudsuite && repeat) {
     return champsim::get_tracereader_for_type<repeatable_reader_t, cloudsuite_instr>(fname, cpu);
   }
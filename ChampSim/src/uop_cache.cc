@@ -0,0 +1,108 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "uop_cache.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "util/bits.h"
+
+champsim::uop_cache::uop_cache(std::size_t sets_, std::size_t ways, std::size_t window_size, std::size_t uops_per_line, std::size_t lines_per_window,
+                               bool partial_windows)
+    : NUM_SET(sets_), NUM_WAY(ways), UOPS_PER_LINE(uops_per_line), LINES_PER_WINDOW(lines_per_window),
+      WINDOW_BITS(champsim::data::bits{champsim::lg2(window_size)}), PARTIAL_WINDOWS(partial_windows), sets(sets_)
+{
+  if (NUM_SET == 0 || NUM_WAY == 0 || UOPS_PER_LINE == 0 || LINES_PER_WINDOW == 0) {
+    throw std::invalid_argument{"The micro-op cache must have at least one set, way, micro-op per line, and line per window"};
+  }
+}
+
+uint64_t champsim::uop_cache::window_of(champsim::address ip) const { return ip.slice_upper(WINDOW_BITS).to<uint64_t>(); }
+
+auto champsim::uop_cache::set_of(uint64_t window) -> std::vector<line_type>& { return sets.at(window % NUM_SET); }
+
+auto champsim::uop_cache::set_of(uint64_t window) const -> const std::vector<line_type>& { return sets.at(window % NUM_SET); }
+
+bool champsim::uop_cache::check_hit(champsim::address ip)
+{
+  auto window = window_of(ip);
+  auto& set = set_of(window);
+  auto found = std::find_if(std::begin(set), std::end(set), [window, ip](const auto& line) {
+    return line.window == window && std::find(std::begin(line.uops), std::end(line.uops), ip) != std::end(line.uops);
+  });
+  if (found == std::end(set)) {
+    return false;
+  }
+
+  found->last_used = ++access_count;
+  return true;
+}
+
+void champsim::uop_cache::fill(champsim::address ip)
+{
+  if (check_hit(ip)) {
+    return;
+  }
+
+  auto window = window_of(ip);
+  if (overflowed_windows.count(window) > 0) {
+    return;
+  }
+
+  auto& set = set_of(window);
+  auto same_window = [window](const auto& line) {
+    return line.window == window;
+  };
+
+  // Pack the micro-op into a line of its window that has room
+  auto with_room = std::find_if(std::begin(set), std::end(set),
+                                [same_window, max_uops = UOPS_PER_LINE](const auto& line) { return same_window(line) && std::size(line.uops) < max_uops; });
+  if (with_room != std::end(set)) {
+    with_room->uops.push_back(ip);
+    with_room->last_used = ++access_count;
+    return;
+  }
+
+  // The window needs another line, which it may not have
+  if (static_cast<std::size_t>(std::count_if(std::begin(set), std::end(set), same_window)) >= LINES_PER_WINDOW) {
+    if (!PARTIAL_WINDOWS) {
+      set.erase(std::remove_if(std::begin(set), std::end(set), same_window), std::end(set));
+      overflowed_windows.insert(window);
+    }
+    return;
+  }
+
+  line_type new_line{window, {ip}, ++access_count};
+  if (std::size(set) < NUM_WAY) {
+    set.push_back(new_line);
+  } else {
+    *std::min_element(std::begin(set), std::end(set), [](const auto& lhs, const auto& rhs) { return lhs.last_used < rhs.last_used; }) = new_line;
+  }
+}
+
+std::size_t champsim::uop_cache::occupancy(champsim::address ip) const
+{
+  auto window = window_of(ip);
+  const auto& set = set_of(window);
+  std::size_t retval = 0;
+  for (const auto& line : set) {
+    if (line.window == window) {
+      retval += std::size(line.uops);
+    }
+  }
+  return retval;
+}
@@ -0,0 +1,182 @@
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#include <fmt/core.h>
+#include <nlohmann/json.hpp>
+
+#include "bench.h"
+#include "champsim.h"
+
+const std::size_t NUM_CPUS = 1;
+
+const unsigned BLOCK_SIZE = 64;
+const unsigned PAGE_SIZE = 4096;
+
+namespace champsim::bench
+{
+std::vector<std::pair<std::string, function_type>>& registry()
+{
+  static std::vector<std::pair<std::string, function_type>> benchmarks;
+  return benchmarks;
+}
+
+double result::median_seconds() const
+{
+  if (std::empty(sample_seconds)) {
+    return 0;
+  }
+  auto sorted = sample_seconds;
+  auto mid = std::next(std::begin(sorted), static_cast<long>(std::size(sorted) / 2));
+  std::nth_element(std::begin(sorted), mid, std::end(sorted));
+  return *mid;
+}
+
+double result::ns_per_item() const
+{
+  auto items = static_cast<double>(iterations * items_per_iteration);
+  return items > 0 ? 1e9 * median_seconds() / items : 0;
+}
+
+double result::items_per_second() const
+{
+  auto seconds = median_seconds();
+  return seconds > 0 ? static_cast<double>(iterations * items_per_iteration) / seconds : 0;
+}
+
+void state::run(const std::function<void(uint64_t)>& body)
+{
+  using clock = std::chrono::steady_clock;
+  auto time_one = [&body](uint64_t n) {
+    auto start = clock::now();
+    body(n);
+    return std::chrono::duration<double>{clock::now() - start};
+  };
+
+  // Grow the iteration count until one sample takes at least the minimum time
+  uint64_t iterations = 1;
+  for (auto elapsed = time_one(iterations); elapsed < opts.min_time; elapsed = time_one(iterations)) {
+    auto scale = elapsed.count() > 0 ? 1.4 * opts.min_time / elapsed : 10.0;
+    iterations = static_cast<uint64_t>(static_cast<double>(iterations) * std::clamp(scale, 2.0, 10.0));
+  }
+
+  res.iterations = iterations;
+  res.sample_seconds.clear();
+  for (unsigned i = 0; i < std::max(opts.repetitions, 1u); ++i) {
+    res.sample_seconds.push_back(time_one(iterations).count());
+  }
+}
+
+void to_json(nlohmann::json& j, const result& res)
+{
+  j = nlohmann::json{{"name", res.name},
+                     {"iterations", res.iterations},
+                     {"items_per_iteration", res.items_per_iteration},
+                     {"median_seconds", res.median_seconds()},
+                     {"ns_per_item", res.ns_per_item()},
+                     {"items_per_second", res.items_per_second()},
+                     {"samples", res.sample_seconds}};
+  if (!std::empty(res.counters)) {
+    j["counters"] = res.counters;
+  }
+}
+} // namespace champsim::bench
+
+namespace
+{
+void print_usage(std::string_view prog)
+{
+  fmt::print("Usage: {} [--list] [--json FILE] [--min-time SECONDS] [--repetitions N] [FILTER...]\n", prog);
+  fmt::print("  Runs every benchmark whose name contains any FILTER (all if none are given).\n");
+  fmt::print("  With --json, writes the results to FILE, or to standard output if FILE is '-'.\n");
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+  champsim::bench::options opts;
+  std::vector<std::string> filters;
+  std::string json_file;
+  bool list_only = false;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string_view arg{argv[i]};
+    auto next_arg = [&]() -> std::string {
+      if (i + 1 >= argc) {
+        fmt::print(stderr, "Missing value for {}\n", arg);
+        std::exit(EXIT_FAILURE);
+      }
+      return argv[++i];
+    };
+
+    if (arg == "--help" || arg == "-h") {
+      print_usage(argv[0]);
+      return EXIT_SUCCESS;
+    } else if (arg == "--list") {
+      list_only = true;
+    } else if (arg == "--json") {
+      json_file = next_arg();
+    } else if (arg == "--min-time") {
+      opts.min_time = std::chrono::duration<double>{std::stod(next_arg())};
+    } else if (arg == "--repetitions") {
+      opts.repetitions = static_cast<unsigned>(std::stoul(next_arg()));
+    } else {
+      filters.emplace_back(arg);
+    }
+  }
+
+  auto selected = [&filters](const std::string& name) {
+    return std::empty(filters) || std::any_of(std::cbegin(filters), std::cend(filters), [&name](const auto& f) { return name.find(f) != std::string::npos; });
+  };
+
+  auto& benchmarks = champsim::bench::registry();
+  std::sort(std::begin(benchmarks), std::end(benchmarks), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+  if (list_only) {
+    for (const auto& [name, func] : benchmarks) {
+      if (selected(name)) {
+        fmt::print("{}\n", name);
+      }
+    }
+    return EXIT_SUCCESS;
+  }
+
+  // When the JSON is written to standard output, keep the table off of it
+  const bool print_table = (json_file != "-");
+  if (print_table) {
+    fmt::print("{:<48} {:>14} {:>12} {:>16}\n", "Benchmark", "Iterations", "ns/item", "items/s");
+  }
+
+  std::vector<champsim::bench::result> results;
+  for (const auto& [name, func] : benchmarks) {
+    if (!selected(name)) {
+      continue;
+    }
+
+    champsim::bench::state st{name, opts};
+    func(st);
+    results.push_back(st.get_result());
+
+    if (print_table) {
+      const auto& res = results.back();
+      fmt::print("{:<48} {:>14} {:>12.2f} {:>16.4g}\n", res.name, res.iterations, res.ns_per_item(), res.items_per_second());
+      for (const auto& [counter_name, value] : res.counters) {
+        fmt::print("    {}: {:.6g}\n", counter_name, value);
+      }
+      std::fflush(stdout);
+    }
+  }
+
+  if (!std::empty(json_file)) {
+    nlohmann::json output{{"context", {{"min_time", opts.min_time.count()}, {"repetitions", opts.repetitions}}}, {"benchmarks", results}};
+    if (json_file == "-") {
+      std::cout << output.dump(2) << std::endl;
+    } else {
+      std::ofstream json_stream{json_file};
+      json_stream << output.dump(2) << std::endl;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,59 @@
+#include <random>
+
+#include "bench.h"
+#include "channel.h"
+#include "champsim.h"
+#include "util/bits.h"
+
+namespace
+{
+/*
+ * Each iteration fills the queues of a channel with a burst of requests, some of which share a block, and then checks them for collisions.
+ * Filling the queues is part of the measured time, since the check consumes the packets that it merges.
+ */
+void channel_collision(champsim::bench::state& st, std::size_t queue_size, double duplicate_fraction)
+{
+  std::mt19937_64 rng{0xbeef};
+  std::bernoulli_distribution choose_duplicate{duplicate_fraction};
+  std::vector<champsim::channel::request_type> reads;
+  std::vector<champsim::channel::request_type> writes;
+
+  uint64_t block = 0;
+  for (std::size_t i = 0; i < queue_size; ++i) {
+    champsim::channel::request_type pkt;
+    pkt.address = champsim::address{champsim::block_number{(i > 0 && choose_duplicate(rng)) ? block - 1 : block++}};
+    pkt.v_address = pkt.address;
+    pkt.instr_id = i;
+    reads.push_back(pkt);
+
+    if (i % 4 == 0) {
+      pkt.type = access_type::WRITE;
+      pkt.address = champsim::address{champsim::block_number{block + (uint64_t{1} << 20)}};
+      writes.push_back(pkt);
+    }
+  }
+
+  champsim::channel uut{queue_size, queue_size, queue_size, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+  st.set_items_per_iteration(std::size(reads) + std::size(writes));
+
+  st.run([&](uint64_t n) {
+    for (uint64_t i = 0; i < n; ++i) {
+      for (const auto& pkt : writes) {
+        uut.add_wq(pkt);
+      }
+      for (const auto& pkt : reads) {
+        uut.add_rq(pkt);
+      }
+      uut.check_collision();
+      champsim::bench::do_not_optimize(uut.RQ);
+      uut.RQ.clear();
+      uut.WQ.clear();
+      uut.returned.clear();
+    }
+  });
+}
+
+champsim::bench::registration small_unique{"channel/check_collision/q16", [](auto& st) { channel_collision(st, 16, 0.0); }};
+champsim::bench::registration large_unique{"channel/check_collision/q64", [](auto& st) { channel_collision(st, 64, 0.0); }};
+champsim::bench::registration large_duplicates{"channel/check_collision/q64-dup25", [](auto& st) { channel_collision(st, 64, 0.25); }};
+} // namespace
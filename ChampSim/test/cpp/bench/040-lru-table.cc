@@ -0,0 +1,51 @@
+#include <random>
+
+#include "bench.h"
+#include "msl/lru_table.h"
+
+namespace
+{
+struct table_entry {
+  uint64_t key;
+  uint64_t payload;
+
+  auto index() const { return key; }
+  auto tag() const { return key; }
+};
+
+/*
+ * Look up keys drawn uniformly from a footprint, filling on a miss. The ratio of the footprint to the capacity sets the hit rate.
+ */
+void lru_table_lookup(champsim::bench::state& st, std::size_t sets, std::size_t ways, uint64_t footprint)
+{
+  std::mt19937_64 rng{0xf00d};
+  std::uniform_int_distribution<uint64_t> key_dist{0, footprint - 1};
+  std::vector<uint64_t> keys(1 << 16);
+  std::generate(std::begin(keys), std::end(keys), [&] { return key_dist(rng); });
+
+  champsim::msl::lru_table<table_entry> uut{sets, ways};
+  uint64_t hits = 0;
+  uint64_t lookups = 0;
+  std::size_t pos = 0;
+
+  st.run([&](uint64_t n) {
+    for (uint64_t i = 0; i < n; ++i) {
+      table_entry elem{keys[pos], pos};
+      pos = (pos + 1) % std::size(keys);
+      if (auto found = uut.check_hit(elem); found.has_value()) {
+        ++hits;
+        champsim::bench::do_not_optimize(found->payload);
+      } else {
+        uut.fill(elem);
+      }
+    }
+    lookups += n;
+  });
+
+  st.set_counter("hit_rate", static_cast<double>(hits) / static_cast<double>(lookups));
+}
+
+champsim::bench::registration fits{"msl/lru_table/256x8-fits", [](auto& st) { lru_table_lookup(st, 256, 8, 1024); }};
+champsim::bench::registration thrash{"msl/lru_table/256x8-thrash", [](auto& st) { lru_table_lookup(st, 256, 8, 16384); }};
+champsim::bench::registration wide{"msl/lru_table/64x32-fits", [](auto& st) { lru_table_lookup(st, 64, 32, 1024); }};
+} // namespace
@@ -0,0 +1,92 @@
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "bench.h"
+#include "inf_stream.h"
+#include "instr_stream.h"
+#include "tracereader.h"
+
+namespace
+{
+std::string serialize(const std::vector<input_instr>& instrs)
+{
+  std::string retval(std::size(instrs) * sizeof(input_instr), '\0');
+  std::memcpy(std::data(retval), std::data(instrs), std::size(retval));
+  return retval;
+}
+
+std::string compress(champsim::decomp_tags::gzip_tag_t<> /*tag*/, const std::string& plain)
+{
+  z_stream strm{};
+  ::deflateInit2(&strm, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+  std::string retval(::deflateBound(&strm, std::size(plain)), '\0');
+  strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(std::data(plain)));
+  strm.avail_in = static_cast<uInt>(std::size(plain));
+  strm.next_out = reinterpret_cast<Bytef*>(std::data(retval));
+  strm.avail_out = static_cast<uInt>(std::size(retval));
+  ::deflate(&strm, Z_FINISH);
+  retval.resize(strm.total_out);
+  ::deflateEnd(&strm);
+  return retval;
+}
+
+std::string compress(champsim::decomp_tags::lzma_tag_t<> /*tag*/, const std::string& plain)
+{
+  std::string retval(::lzma_stream_buffer_bound(std::size(plain)), '\0');
+  std::size_t out_pos = 0;
+  ::lzma_easy_buffer_encode(LZMA_PRESET_DEFAULT, LZMA_CHECK_CRC64, nullptr, reinterpret_cast<const uint8_t*>(std::data(plain)), std::size(plain),
+                            reinterpret_cast<uint8_t*>(std::data(retval)), &out_pos, std::size(retval));
+  retval.resize(out_pos);
+  return retval;
+}
+
+std::string compress(champsim::decomp_tags::bzip2_tag_t /*tag*/, const std::string& plain)
+{
+  std::string retval(std::size(plain) + std::size(plain) / 100 + 600, '\0');
+  auto out_len = static_cast<unsigned>(std::size(retval));
+  ::BZ2_bzBuffToBuffCompress(std::data(retval), &out_len, const_cast<char*>(std::data(plain)), static_cast<unsigned>(std::size(plain)), 9, 0, 0);
+  retval.resize(out_len);
+  return retval;
+}
+
+template <typename Stream, typename Make>
+void read_trace(champsim::bench::state& st, std::size_t trace_bytes, Make&& make_stream)
+{
+  using reader_type = champsim::bulk_tracereader<input_instr, Stream>;
+  auto reader = std::make_unique<reader_type>(0, make_stream());
+
+  st.run([&](uint64_t n) {
+    for (uint64_t i = 0; i < n; ++i) {
+      // Start again from the beginning of the trace when it is exhausted
+      if (reader->eof()) {
+        reader = std::make_unique<reader_type>(0, make_stream());
+      }
+      auto instr = (*reader)();
+      champsim::bench::do_not_optimize(instr.ip);
+    }
+  });
+
+  st.set_counter("trace_bytes", static_cast<double>(trace_bytes));
+}
+
+template <typename Tag>
+void read_compressed_trace(champsim::bench::state& st)
+{
+  const auto compressed = compress(Tag{}, serialize(champsim::bench::synthetic_instructions(1 << 16)));
+  using stream_type = champsim::inf_istream<Tag, std::istringstream>;
+  read_trace<stream_type>(st, std::size(compressed), [&compressed] { return stream_type{std::istringstream{compressed}}; });
+}
+
+void read_plain_trace(champsim::bench::state& st)
+{
+  const auto plain = serialize(champsim::bench::synthetic_instructions(1 << 16));
+  read_trace<std::istringstream>(st, std::size(plain), [&plain] { return std::istringstream{plain}; });
+}
+
+champsim::bench::registration plain{"tracereader/bulk/uncompressed", read_plain_trace};
+champsim::bench::registration gzip{"tracereader/bulk/gzip", read_compressed_trace<champsim::decomp_tags::gzip_tag_t<>>};
+champsim::bench::registration xz{"tracereader/bulk/xz", read_compressed_trace<champsim::decomp_tags::lzma_tag_t<>>};
+champsim::bench::registration bzip2{"tracereader/bulk/bzip2", read_compressed_trace<champsim::decomp_tags::bzip2_tag_t>};
+} // namespace
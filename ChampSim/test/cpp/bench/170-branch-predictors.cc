@@ -0,0 +1,147 @@
+#include <memory>
+#include <random>
+
+#include "../../../branch/bimodal/bimodal.h"
+#include "../../../branch/bipt/bipt.h"
+#include "../../../branch/fdip/fdip.h"
+#include "../../../branch/gshare/gshare.h"
+#include "../../../branch/hashed_perceptron/hashed_perceptron.h"
+#include "../../../branch/perceptron/perceptron.h"
+#include "../../../branch/tage_sc_l/tage_sc_l.h"
+#include "../../../btb/basic_btb/basic_btb.h"
+#include "../../../btb/ittage/ittage.h"
+#include "bench.h"
+#include "instr_stream.h"
+#include "instruction.h"
+#include "modules.h"
+#include "ooo_cpu.h"
+
+namespace
+{
+struct branch_record {
+  champsim::address ip;
+  champsim::address target;
+  bool taken;
+  uint8_t type;
+};
+
+/*
+ * The conditional branches of the synthetic stream, interleaved with calls and their returns, and with indirect jumps to one of a few targets
+ */
+std::vector<branch_record> branch_stream()
+{
+  const auto instrs = champsim::bench::synthetic_instructions(1 << 18);
+  std::mt19937_64 rng{0xb4a2c4};
+  std::uniform_int_distribution<uint64_t> indirect_target{0, 3};
+
+  std::vector<branch_record> retval;
+  for (auto it = std::begin(instrs); it != std::end(instrs); ++it) {
+    if (!it->is_branch) {
+      continue;
+    }
+
+    auto next = std::next(it);
+    auto target = (it->branch_taken && next != std::end(instrs)) ? champsim::address{next->ip} : champsim::address{};
+    retval.push_back({champsim::address{it->ip}, target, it->branch_taken != 0, BRANCH_CONDITIONAL});
+
+    if (std::size(retval) % 32 == 0) {
+      champsim::address call_ip{it->ip + 2};
+      champsim::address callee{0x800000 + 0x100 * (it->ip % 16)};
+      retval.push_back({call_ip, callee, true, BRANCH_DIRECT_CALL});
+      retval.push_back({callee + 0x40, call_ip + 4, true, BRANCH_RETURN});
+    }
+    if (std::size(retval) % 64 == 1) {
+      champsim::address jump_ip{it->ip + 3};
+      retval.push_back({jump_ip, champsim::address{0x900000 + 0x1000 * indirect_target(rng)}, true, BRANCH_INDIRECT});
+    }
+  }
+  return retval;
+}
+
+/*
+ * Each iteration predicts one branch and then trains the predictor with its outcome.
+ * The predictor is bound to a default core, from which predictors such as tage_sc_l take their storage budget.
+ */
+template <typename P>
+void predictor_bench(champsim::bench::state& st)
+{
+  const auto branches = branch_stream();
+  O3_CPU cpu{champsim::core_builder{}};
+  auto uut = std::make_unique<P>(&cpu);
+  if constexpr (champsim::modules::branch_predictor::has_initialize<P>) {
+    uut->initialize_branch_predictor();
+  }
+  uint64_t correct = 0;
+  uint64_t predicted = 0;
+  std::size_t pos = 0;
+
+  st.run([&](uint64_t n) {
+    for (uint64_t i = 0; i < n; ++i) {
+      const auto& br = branches[pos];
+      pos = (pos + 1) % std::size(branches);
+
+      auto prediction = uut->predict_branch(br.ip);
+      correct += (prediction == br.taken) ? 1 : 0;
+      uut->last_branch_result(br.ip, br.target, br.taken, br.type);
+    }
+    predicted += n;
+  });
+
+  st.set_counter("accuracy", static_cast<double>(correct) / static_cast<double>(predicted));
+}
+
+/*
+ * Look up a branch in a BTB, passing its type to BTBs that take one
+ */
+template <typename B>
+std::pair<champsim::address, bool> predict(B& uut, const branch_record& br)
+{
+  if constexpr (champsim::modules::btb::has_btb_prediction<B, champsim::address, uint8_t>) {
+    return uut.btb_prediction(br.ip, br.type);
+  } else {
+    return uut.btb_prediction(br.ip);
+  }
+}
+
+/*
+ * Each iteration looks up one branch in the BTB and then updates it with the resolved target
+ */
+template <typename B>
+void btb_bench(champsim::bench::state& st)
+{
+  const auto branches = branch_stream();
+  O3_CPU cpu{champsim::core_builder{}};
+  auto uut = std::make_unique<B>(&cpu);
+  if constexpr (champsim::modules::btb::has_initialize<B>) {
+    uut->initialize_btb();
+  }
+  uint64_t correct = 0;
+  uint64_t predicted = 0;
+  std::size_t pos = 0;
+
+  st.run([&](uint64_t n) {
+    for (uint64_t i = 0; i < n; ++i) {
+      const auto& br = branches[pos];
+      pos = (pos + 1) % std::size(branches);
+
+      auto [target, always_taken] = predict(*uut, br);
+      correct += (!br.taken || target == br.target) ? 1 : 0;
+      champsim::bench::do_not_optimize(always_taken);
+      uut->update_btb(br.ip, br.target, br.taken, br.type);
+    }
+    predicted += n;
+  });
+
+  st.set_counter("target_accuracy", static_cast<double>(correct) / static_cast<double>(predicted));
+}
+
+champsim::bench::registration bimodal_bench{"branch/bimodal", predictor_bench<bimodal>};
+champsim::bench::registration bipt_bench{"branch/bipt", predictor_bench<bipt>};
+champsim::bench::registration fdip_bench{"branch/fdip", predictor_bench<fdip>};
+champsim::bench::registration gshare_bench{"branch/gshare", predictor_bench<gshare>};
+champsim::bench::registration hashed_perceptron_bench{"branch/hashed_perceptron", predictor_bench<hashed_perceptron>};
+champsim::bench::registration perceptron_bench{"branch/perceptron", predictor_bench<perceptron>};
+champsim::bench::registration tage_sc_l_bench{"branch/tage_sc_l", predictor_bench<tage_sc_l>};
+champsim::bench::registration basic_btb_bench{"btb/basic_btb", btb_bench<basic_btb>};
+champsim::bench::registration ittage_bench{"btb/ittage", btb_bench<ittage>};
+} // namespace
@@ -0,0 +1,68 @@
+#include <stdexcept>
+
+#include "bench.h"
+#include "cache.h"
+#include "defaults.hpp"
+#include "instr_stream.h"
+#include "ooo_cpu.h"
+#include "operables.h"
+#include "tracereader.h"
+#include "util/bits.h"
+
+namespace
+{
+/*
+ * Run a default core, with a real L1I and an ideal data memory and ITLB, on the synthetic instruction stream.
+ * Each iteration is one retired instruction, so the throughput is the simulated instructions per host second.
+ */
+void core_operate(champsim::bench::state& st, long data_latency)
+{
+  std::vector<ooo_model_instr> instrs;
+  for (const auto& instr : champsim::bench::synthetic_instructions(1 << 16)) {
+    instrs.emplace_back(0, instr);
+  }
+  champsim::set_branch_targets(std::begin(instrs), std::end(instrs));
+
+  champsim::bench::fixed_latency_memory l1i_lower{20};
+  champsim::bench::fixed_latency_memory itlb{1};
+  champsim::bench::fixed_latency_memory l1d{data_latency};
+  champsim::channel fetch_queues{64, 32, 64, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+  CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("bench-L1I").upper_levels({&fetch_queues})
+                   .lower_level(&l1i_lower.queues)
+                   .lower_translate(&itlb.queues)};
+  O3_CPU uut{champsim::core_builder{champsim::defaults::default_core}.fetch_queues(&fetch_queues).data_queues(&l1d.queues).l1i(&l1i)};
+  uut.show_heartbeat = false;
+
+  std::vector<champsim::operable*> elements{&uut, &l1i, &l1i_lower, &itlb, &l1d};
+  champsim::bench::begin_simulation(elements);
+
+  std::size_t pos = 0;
+  uint64_t next_id = 1;
+  auto step = [&]() {
+    champsim::bench::run_cycles(elements, 1);
+    while (static_cast<long>(std::size(uut.input_queue)) < uut.IN_QUEUE_SIZE) {
+      uut.input_queue.push_back(instrs[pos]);
+      uut.input_queue.back().instr_id = next_id++;
+      pos = (pos + 1) % std::size(instrs);
+    }
+  };
+
+  uint64_t cycles = 0;
+  st.run([&](uint64_t n) {
+    const auto target = uut.num_retired + static_cast<long long>(n);
+    for (uint64_t stalled = 0; uut.num_retired < target; ++cycles) {
+      auto before = uut.num_retired;
+      step();
+      stalled = (uut.num_retired == before) ? stalled + 1 : 0;
+      if (stalled > 100000) {
+        throw std::runtime_error{"The core under benchmark stopped retiring instructions"};
+      }
+    }
+  });
+
+  st.set_counter("ipc", static_cast<double>(uut.num_retired) / static_cast<double>(cycles));
+}
+
+champsim::bench::registration ideal_data{"core/operate/l1d-latency-1", [](auto& st) { core_operate(st, 1); }};
+champsim::bench::registration slow_data{"core/operate/l1d-latency-20", [](auto& st) { core_operate(st, 20); }};
+} // namespace
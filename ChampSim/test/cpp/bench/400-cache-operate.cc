@@ -0,0 +1,55 @@
+#include <random>
+
+#include "bench.h"
+#include "cache.h"
+#include "defaults.hpp"
+#include "operables.h"
+
+namespace
+{
+/*
+ * Drive an L1D-sized cache with one request per cycle. A fraction of the requests go to a small hot set that stays resident, and the rest
+ * stream through addresses that are never reused, so the hit rate is set by the mix.
+ */
+void cache_operate(champsim::bench::state& st, double hot_fraction, double write_fraction)
+{
+  constexpr uint64_t hot_blocks = 256;
+  std::mt19937_64 rng{0xcafe};
+  std::bernoulli_distribution choose_hot{hot_fraction};
+  std::bernoulli_distribution choose_write{write_fraction};
+  std::uniform_int_distribution<uint64_t> hot_block{0, hot_blocks - 1};
+  uint64_t cold_block = uint64_t{1} << 24;
+  uint64_t id = 0;
+
+  champsim::bench::generated_requester ul{[&]() {
+    champsim::bench::generated_requester::request_type pkt;
+    auto block = choose_hot(rng) ? hot_block(rng) : cold_block++;
+    pkt.address = champsim::address{champsim::block_number{block}};
+    pkt.v_address = pkt.address;
+    pkt.ip = champsim::address{0x400000 + 4 * (block % 64)};
+    pkt.type = choose_write(rng) ? access_type::WRITE : access_type::LOAD;
+    pkt.response_requested = (pkt.type != access_type::WRITE);
+    pkt.instr_id = id++;
+    pkt.cpu = 0;
+    return pkt;
+  }};
+  champsim::bench::fixed_latency_memory ll{20};
+  CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}.name("bench-L1D").upper_levels({&ul.queues}).lower_level(&ll.queues)};
+
+  std::vector<champsim::operable*> elements{&ul, &uut, &ll};
+  champsim::bench::begin_simulation(elements);
+
+  st.run([&](uint64_t n) { champsim::bench::run_cycles(elements, n); });
+
+  auto hits = uut.sim_stats.hits.total();
+  auto misses = uut.sim_stats.misses.total();
+  st.set_counter("hit_rate", (hits + misses) > 0 ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0);
+  st.set_counter("accesses_per_cycle", static_cast<double>(ul.issued) / static_cast<double>(uut.current_time.time_since_epoch() / uut.clock_period));
+}
+
+champsim::bench::registration hit_100{"cache/operate/hot100", [](auto& st) { cache_operate(st, 1.0, 0.0); }};
+champsim::bench::registration hit_90{"cache/operate/hot90", [](auto& st) { cache_operate(st, 0.9, 0.0); }};
+champsim::bench::registration hit_50{"cache/operate/hot50", [](auto& st) { cache_operate(st, 0.5, 0.0); }};
+champsim::bench::registration hit_0{"cache/operate/hot0", [](auto& st) { cache_operate(st, 0.0, 0.0); }};
+champsim::bench::registration hit_90_writes{"cache/operate/hot90-writes25", [](auto& st) { cache_operate(st, 0.9, 0.25); }};
+} // namespace
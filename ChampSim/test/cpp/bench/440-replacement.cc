@@ -0,0 +1,74 @@
+#include <random>
+
+#include "../../../replacement/clip/clip.h"
+#include "../../../replacement/drrip/drrip.h"
+#include "../../../replacement/lru/lru.h"
+#include "../../../replacement/random/random.h"
+#include "../../../replacement/ship/ship.h"
+#include "../../../replacement/srrip/srrip.h"
+#include "bench.h"
+#include "cache.h"
+#include "defaults.hpp"
+#include "operables.h"
+
+namespace
+{
+/*
+ * Each iteration is one cycle of an L2C-sized cache that uses the replacement policy under test. A third of the requests are instruction
+ * fetches drawn from a code footprint of half the cache, and the rest stream through data that is never reused, so the instruction hit rate
+ * shows how well the policy keeps the code resident.
+ */
+template <typename R>
+void replacement_bench(champsim::bench::state& st)
+{
+  constexpr uint64_t code_blocks = 2048;
+  std::mt19937_64 rng{0x7e91ace};
+  std::bernoulli_distribution choose_code{1.0 / 3.0};
+  std::uniform_int_distribution<uint64_t> code_block{0, code_blocks - 1};
+  uint64_t data_block = uint64_t{1} << 24;
+  uint64_t id = 0;
+
+  champsim::bench::generated_requester ul{[&]() {
+    champsim::bench::generated_requester::request_type pkt;
+    if (choose_code(rng)) {
+      pkt.address = champsim::address{champsim::block_number{code_block(rng)}};
+      pkt.type = access_type::IFETCH;
+      pkt.is_instruction = true;
+    } else {
+      pkt.address = champsim::address{champsim::block_number{data_block++}};
+      pkt.type = access_type::LOAD;
+    }
+    pkt.v_address = pkt.address;
+    pkt.ip = pkt.address;
+    pkt.instr_id = id++;
+    pkt.cpu = 0;
+    return pkt;
+  }};
+  champsim::bench::fixed_latency_memory ll{20};
+  CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}
+                .name("bench-L2C")
+                .upper_levels({&ul.queues})
+                .lower_level(&ll.queues)
+                .template replacement<R>()};
+
+  std::vector<champsim::operable*> elements{&ul, &uut, &ll};
+  champsim::bench::begin_simulation(elements);
+
+  st.run([&](uint64_t n) { champsim::bench::run_cycles(elements, n); });
+
+  auto hits = uut.sim_stats.hits.total();
+  auto misses = uut.sim_stats.misses.total();
+  auto code_hits = uut.sim_stats.hits.value_or(std::pair{access_type::IFETCH, 0u}, 0);
+  auto code_misses = uut.sim_stats.misses.value_or(std::pair{access_type::IFETCH, 0u}, 0);
+  st.set_counter("hit_rate", (hits + misses) > 0 ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0);
+  st.set_counter("instruction_hit_rate",
+                 (code_hits + code_misses) > 0 ? static_cast<double>(code_hits) / static_cast<double>(code_hits + code_misses) : 0.0);
+}
+
+champsim::bench::registration lru_bench{"replacement/lru", replacement_bench<lru>};
+champsim::bench::registration random_bench{"replacement/random", replacement_bench<struct random>};
+champsim::bench::registration srrip_bench{"replacement/srrip", replacement_bench<srrip>};
+champsim::bench::registration drrip_bench{"replacement/drrip", replacement_bench<drrip>};
+champsim::bench::registration ship_bench{"replacement/ship", replacement_bench<ship>};
+champsim::bench::registration clip_bench{"replacement/clip", replacement_bench<clip>};
+} // namespace
@@ -0,0 +1,159 @@
+#include <random>
+
+#include "../../../prefetcher/btip/btip.h"
+#include "../../../prefetcher/entangling/entangling.h"
+#include "../../../prefetcher/fdip/fdip.h"
+#include "../../../prefetcher/ip_stride/ip_stride.h"
+#include "../../../prefetcher/next_line/next_line.h"
+#include "../../../prefetcher/no/no.h"
+#include "../../../prefetcher/pif/pif.h"
+#include "../../../prefetcher/rdip/rdip.h"
+#include "../../../prefetcher/spp_dev/spp_dev.h"
+#include "../../../prefetcher/va_ampm_lite/va_ampm_lite.h"
+#include "bench.h"
+#include "cache.h"
+#include "defaults.hpp"
+#include "instr_stream.h"
+#include "instruction.h"
+#include "operables.h"
+
+namespace
+{
+using request_type = champsim::bench::generated_requester::request_type;
+
+/*
+ * Sixteen load instructions, each walking its own region with a constant stride, with a fraction of unrelated accesses mixed in
+ */
+auto strided_data_stream()
+{
+  return [rng = std::mt19937_64{0x9e7c}, positions = std::array<uint64_t, 16>{}, id = uint64_t{0}]() mutable {
+    request_type pkt;
+    auto which = std::uniform_int_distribution<std::size_t>{0, std::size(positions) - 1}(rng);
+    uint64_t block = 0;
+    if (std::bernoulli_distribution{0.2}(rng)) {
+      block = std::uniform_int_distribution<uint64_t>{uint64_t{1} << 30, uint64_t{1} << 31}(rng);
+    } else {
+      block = (uint64_t{which + 1} << 20) + positions[which];
+      positions[which] += (which % 4) + 1;
+    }
+    pkt.address = champsim::address{champsim::block_number{block}};
+    pkt.v_address = pkt.address;
+    pkt.ip = champsim::address{0x400000 + 0x10 * which};
+    pkt.instr_id = id++;
+    pkt.cpu = 0;
+    return pkt;
+  };
+}
+
+/*
+ * The instruction fetches of the synthetic stream, one per fetched block
+ */
+auto instruction_fetch_stream()
+{
+  auto instrs = champsim::bench::synthetic_instructions(1 << 18);
+  std::vector<uint64_t> blocks;
+  for (const auto& instr : instrs) {
+    auto block = champsim::block_number{champsim::address{instr.ip}}.to<uint64_t>();
+    if (std::empty(blocks) || blocks.back() != block) {
+      blocks.push_back(block);
+    }
+  }
+
+  return [blocks = std::move(blocks), pos = std::size_t{0}, id = uint64_t{0}]() mutable {
+    request_type pkt;
+    pkt.address = champsim::address{champsim::block_number{blocks[pos]}};
+    pkt.v_address = pkt.address;
+    pkt.ip = pkt.address;
+    pkt.instr_id = id++;
+    pkt.cpu = 0;
+    pos = (pos + 1) % std::size(blocks);
+    return pkt;
+  };
+}
+
+/*
+ * Stands in for the core in front of the L1I, in step with the instruction fetch stream. Just before each fetch is issued, it reports the
+ * fetched block to the prefetcher: the block enters the FTQ, its branches are predicted, and its instructions retire. Every 32 blocks, the
+ * stream also calls a function and returns from it, so that prefetchers keyed on the call stack see their context change.
+ */
+auto instruction_core_hooks()
+{
+  return [instrs = champsim::bench::synthetic_instructions(1 << 18), pos = std::size_t{0}, blocks = uint64_t{0}](CACHE& cache) mutable {
+    champsim::block_number block{champsim::address{instrs[pos].ip}};
+    cache.impl_prefetcher_ftq_enqueue(champsim::address{block}, false);
+    do {
+      const auto& instr = instrs[pos];
+      pos = (pos + 1) % std::size(instrs);
+      if (instr.is_branch) {
+        auto target = instr.branch_taken ? champsim::address{instrs[pos].ip} : champsim::address{};
+        cache.impl_prefetcher_branch_operate(champsim::address{instr.ip}, BRANCH_CONDITIONAL, target);
+      }
+      cache.impl_prefetcher_retire(champsim::address{instr.ip});
+    } while (pos != 0 && champsim::block_number{champsim::address{instrs[pos].ip}} == block);
+
+    if (++blocks % 32 == 0) {
+      champsim::address call_ip{block};
+      champsim::address callee{0x800000 + 0x100 * ((blocks / 32) % 16)};
+      cache.impl_prefetcher_branch_operate(call_ip, BRANCH_DIRECT_CALL, callee);
+      cache.impl_prefetcher_branch_operate(callee + 0x40, BRANCH_RETURN, call_ip + 4);
+    }
+  };
+}
+
+/*
+ * Each iteration is one cycle of a cache that uses the prefetcher under test. The core hooks are called as each demand access is generated.
+ * Virtually-addressed prefetches are translated by an ideal TLB. Demand accesses arrive every other cycle,
+ * since a cache that is saturated by demand accesses never has tag bandwidth left over for its prefetches.
+ */
+template <typename P, typename Builder, typename Stream, typename Hooks>
+void prefetcher_bench(champsim::bench::state& st, Builder builder, Stream stream, Hooks hooks)
+{
+  CACHE* hooked = nullptr; // the cache does not exist yet when the requester is built
+  champsim::bench::generated_requester ul{[&]() {
+                                            auto pkt = stream();
+                                            if (hooked != nullptr) {
+                                              hooks(*hooked);
+                                            }
+                                            return pkt;
+                                          },
+                                          2};
+  champsim::bench::fixed_latency_memory ll{20};
+  champsim::bench::fixed_latency_memory tlb{1};
+  CACHE uut{builder.name("bench-uut").upper_levels({&ul.queues}).lower_level(&ll.queues).lower_translate(&tlb.queues).template prefetcher<P>()};
+  hooked = &uut;
+
+  std::vector<champsim::operable*> elements{&ul, &uut, &ll, &tlb};
+  champsim::bench::begin_simulation(elements);
+
+  st.run([&](uint64_t n) { champsim::bench::run_cycles(elements, n); });
+
+  auto hits = uut.sim_stats.hits.total();
+  auto misses = uut.sim_stats.misses.total();
+  st.set_counter("hit_rate", (hits + misses) > 0 ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0);
+  st.set_counter("pf_issued", static_cast<double>(uut.sim_stats.pf_issued));
+  st.set_counter("pf_useful", static_cast<double>(uut.sim_stats.pf_useful));
+}
+
+template <typename P>
+void data_prefetcher_bench(champsim::bench::state& st)
+{
+  prefetcher_bench<P>(st, champsim::defaults::default_l2c, strided_data_stream(), [](CACHE&) {});
+}
+
+template <typename P>
+void instruction_prefetcher_bench(champsim::bench::state& st)
+{
+  prefetcher_bench<P>(st, champsim::defaults::default_l1i, instruction_fetch_stream(), instruction_core_hooks());
+}
+
+champsim::bench::registration no_bench{"prefetcher/no", data_prefetcher_bench<no>};
+champsim::bench::registration next_line_bench{"prefetcher/next_line", data_prefetcher_bench<next_line>};
+champsim::bench::registration ip_stride_bench{"prefetcher/ip_stride", data_prefetcher_bench<ip_stride>};
+champsim::bench::registration spp_dev_bench{"prefetcher/spp_dev", data_prefetcher_bench<spp_dev>};
+champsim::bench::registration va_ampm_lite_bench{"prefetcher/va_ampm_lite", data_prefetcher_bench<va_ampm_lite>};
+champsim::bench::registration btip_bench{"prefetcher/btip", instruction_prefetcher_bench<btip>};
+champsim::bench::registration fdip_bench{"prefetcher/fdip", instruction_prefetcher_bench<fdip>};
+champsim::bench::registration pif_bench{"prefetcher/pif", instruction_prefetcher_bench<pif>};
+champsim::bench::registration entangling_bench{"prefetcher/entangling", instruction_prefetcher_bench<entangling>};
+champsim::bench::registration rdip_bench{"prefetcher/rdip", instruction_prefetcher_bench<rdip>};
+} // namespace
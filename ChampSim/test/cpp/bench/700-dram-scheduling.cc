@@ -0,0 +1,66 @@
+#include <random>
+
+#include "bench.h"
+#include "dram_controller.h"
+#include "operables.h"
+
+namespace
+{
+using request_type = champsim::bench::generated_requester::request_type;
+
+/*
+ * Each iteration is one cycle of a single-channel memory controller that is offered one read per cycle.
+ * A sequential stream mostly hits in the open rows, while a random stream mostly conflicts.
+ */
+void dram_scheduling(champsim::bench::state& st, bool sequential)
+{
+  std::mt19937_64 rng{0xd7a3};
+  uint64_t next_block = 0;
+  uint64_t id = 0;
+  champsim::bench::generated_requester ul{[&]() {
+    request_type pkt;
+    auto block = sequential ? next_block++ : std::uniform_int_distribution<uint64_t>{0, uint64_t{1} << 26}(rng);
+    pkt.address = champsim::address{champsim::block_number{block}};
+    pkt.v_address = pkt.address;
+    pkt.instr_id = id++;
+    pkt.cpu = 0;
+    return pkt;
+  }};
+
+  const auto clock_period = champsim::chrono::picoseconds{3200};
+  MEMORY_CONTROLLER uut{clock_period,
+                        clock_period * 2,
+                        24,
+                        24,
+                        24,
+                        52,
+                        champsim::chrono::microseconds{64000},
+                        {&ul.queues},
+                        64,
+                        64,
+                        1,
+                        champsim::data::bytes{8},
+                        65536,
+                        128,
+                        1,
+                        8,
+                        4,
+                        8192};
+
+  std::vector<champsim::operable*> elements{&ul, &uut};
+  for (auto* elem : elements) {
+    elem->warmup = false;
+    elem->begin_phase();
+  }
+
+  st.run([&](uint64_t n) { champsim::bench::run_cycles(elements, n); });
+
+  const auto& stats = uut.channels.front().sim_stats;
+  auto row_accesses = stats.RQ_ROW_BUFFER_HIT + stats.RQ_ROW_BUFFER_MISS;
+  st.set_counter("row_buffer_hit_rate", row_accesses > 0 ? static_cast<double>(stats.RQ_ROW_BUFFER_HIT) / static_cast<double>(row_accesses) : 0.0);
+  st.set_counter("reads_accepted", static_cast<double>(ul.issued));
+}
+
+champsim::bench::registration sequential_reads{"dram/scheduling/sequential", [](auto& st) { dram_scheduling(st, true); }};
+champsim::bench::registration random_reads{"dram/scheduling/random", [](auto& st) { dram_scheduling(st, false); }};
+} // namespace
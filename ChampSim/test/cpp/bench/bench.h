@@ -0,0 +1,81 @@
+#ifndef BENCH_BENCH_H
+#define BENCH_BENCH_H
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace champsim::bench
+{
+struct options {
+  std::chrono::duration<double> min_time{0.1};
+  unsigned repetitions = 5;
+};
+
+struct result {
+  std::string name;
+  uint64_t iterations = 0;
+  uint64_t items_per_iteration = 1;
+  std::vector<double> sample_seconds{};
+  std::map<std::string, double> counters{};
+
+  [[nodiscard]] double median_seconds() const;
+  [[nodiscard]] double ns_per_item() const;
+  [[nodiscard]] double items_per_second() const;
+};
+
+/**
+ * The handle passed to each benchmark.
+ *
+ * A benchmark performs its setup, then calls run() with a callable that performs the given number of iterations of the measured operation.
+ * Only the time spent in that callable is measured. The iteration count is chosen so that each sample runs for at least the minimum time.
+ */
+class state
+{
+  options opts;
+  result res;
+
+public:
+  state(std::string name, options o) : opts(o) { res.name = std::move(name); }
+
+  void run(const std::function<void(uint64_t)>& body);
+
+  /**
+   * Report throughput in units of items (accesses, instructions, cycles) rather than iterations.
+   */
+  void set_items_per_iteration(uint64_t items) { res.items_per_iteration = items; }
+
+  /**
+   * Attach a named value, such as a hit rate, to the result.
+   */
+  void set_counter(const std::string& counter_name, double value) { res.counters[counter_name] = value; }
+
+  [[nodiscard]] const result& get_result() const { return res; }
+};
+
+using function_type = std::function<void(state&)>;
+
+std::vector<std::pair<std::string, function_type>>& registry();
+
+/**
+ * Benchmarks are registered by constructing a static instance of this type.
+ */
+struct registration {
+  registration(std::string name, function_type func) { registry().emplace_back(std::move(name), std::move(func)); }
+};
+
+/**
+ * Prevent the compiler from discarding a computed value.
+ */
+template <typename T>
+void do_not_optimize(const T& val)
+{
+  asm volatile("" : : "g"(&val) : "memory");
+}
+} // namespace champsim::bench
+
+#endif
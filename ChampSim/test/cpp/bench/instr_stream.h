@@ -0,0 +1,68 @@
+#ifndef BENCH_INSTR_STREAM_H
+#define BENCH_INSTR_STREAM_H
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "trace_instruction.h"
+
+namespace champsim::bench
+{
+/*
+ * A deterministic instruction stream that resembles a loop-heavy program: the code is a set of 8-instruction basic blocks, each ending in a
+ * conditional branch with a per-block bias. One instruction in four loads from a strided array, and one in sixteen stores to it.
+ */
+inline std::vector<input_instr> synthetic_instructions(std::size_t count)
+{
+  constexpr uint64_t code_base = 0x400000;
+  constexpr uint64_t data_base = 0x10000000;
+  constexpr uint64_t num_blocks = 512;
+  constexpr uint64_t block_len = 8;
+  constexpr uint64_t data_footprint = 1 << 20;
+  constexpr uint64_t stride = 72;
+
+  std::mt19937_64 rng{0x5eed};
+  std::vector<double> bias(num_blocks);
+  std::generate(std::begin(bias), std::end(bias), [&rng] { return std::bernoulli_distribution{0.5}(rng) ? 0.9 : 0.1; });
+
+  std::vector<input_instr> retval;
+  retval.reserve(count);
+
+  uint64_t block = 0;
+  uint64_t data_offset = 0;
+  while (std::size(retval) < count) {
+    for (uint64_t i = 0; i < block_len && std::size(retval) < count; ++i) {
+      input_instr instr{};
+      instr.ip = code_base + 4 * (block * block_len + i);
+      const auto seq = std::size(retval);
+
+      if (i == block_len - 1) {
+        instr.is_branch = 1;
+        instr.branch_taken = std::bernoulli_distribution{bias[block]}(rng) ? 1 : 0;
+        instr.destination_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+        instr.source_registers[0] = champsim::REG_INSTRUCTION_POINTER;
+        instr.source_registers[1] = champsim::REG_FLAGS;
+      } else {
+        instr.destination_registers[0] = static_cast<unsigned char>(1 + (seq % 12));
+        instr.source_registers[0] = static_cast<unsigned char>(1 + ((seq + 5) % 12));
+        if (seq % 4 == 0) {
+          instr.source_memory[0] = data_base + data_offset;
+          data_offset = (data_offset + stride) % data_footprint;
+        } else if (seq % 16 == 2) {
+          instr.destination_memory[0] = data_base + data_offset;
+        }
+      }
+
+      retval.push_back(instr);
+    }
+
+    auto taken = retval.back().is_branch && retval.back().branch_taken;
+    block = taken ? (block * 37 + 11) % num_blocks : (block + 1) % num_blocks;
+  }
+
+  return retval;
+}
+} // namespace champsim::bench
+
+#endif
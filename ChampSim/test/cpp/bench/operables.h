@@ -0,0 +1,147 @@
+#ifndef BENCH_OPERABLES_H
+#define BENCH_OPERABLES_H
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <vector>
+
+#include "champsim.h"
+#include "channel.h"
+#include "operable.h"
+#include "util/bits.h"
+
+namespace champsim::bench
+{
+/*
+ * A memory that answers every request after a fixed number of cycles.
+ * The data returned is the requested address, so that it can also serve as an identity-mapped translation level.
+ */
+class fixed_latency_memory : public champsim::operable
+{
+  struct packet {
+    long ready_cycle;
+    champsim::channel::response_type response;
+  };
+  std::deque<packet> inflight;
+  long cycle_count = 0;
+  long latency = 0;
+
+public:
+  champsim::channel queues{};
+
+  explicit fixed_latency_memory(long lat) : latency(lat) {}
+  fixed_latency_memory() : fixed_latency_memory(0) {}
+
+  long operate() override
+  {
+    ++cycle_count;
+    auto accept = [&](const champsim::channel::request_type& pkt) {
+      if (pkt.response_requested) {
+        champsim::channel::response_type response{pkt};
+        response.data = pkt.address;
+        inflight.push_back({cycle_count + latency, std::move(response)});
+      }
+    };
+    std::for_each(std::begin(queues.RQ), std::end(queues.RQ), accept);
+    std::for_each(std::begin(queues.PQ), std::end(queues.PQ), accept);
+    std::for_each(std::begin(queues.WQ), std::end(queues.WQ), accept);
+    queues.RQ.clear();
+    queues.PQ.clear();
+    queues.WQ.clear();
+
+    while (!std::empty(inflight) && inflight.front().ready_cycle <= cycle_count) {
+      queues.returned.push_back(std::move(inflight.front().response));
+      inflight.pop_front();
+    }
+
+    return 1; // never deadlock
+  }
+};
+
+/*
+ * A requester that offers one packet every few cycles from a generator, retrying packets that are refused, and discards the responses.
+ * Its queues are bounded like those of a configured cache, so that a stalled consumer applies back-pressure.
+ */
+class generated_requester : public champsim::operable
+{
+public:
+  using request_type = champsim::channel::request_type;
+
+private:
+  std::function<request_type()> generator;
+  std::optional<request_type> pending{};
+  long interval = 1;
+  long cycle_count = 0;
+
+public:
+  champsim::channel queues;
+  uint64_t issued = 0;
+
+  generated_requester(std::function<request_type()> gen, long issue_interval, std::size_t queue_size)
+      : generator(std::move(gen)), interval(issue_interval),
+        queues{queue_size, queue_size, queue_size, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false}
+  {
+  }
+  generated_requester(std::function<request_type()> gen, long issue_interval) : generated_requester(std::move(gen), issue_interval, 32) {}
+  explicit generated_requester(std::function<request_type()> gen) : generated_requester(std::move(gen), 1) {}
+
+  long operate() override
+  {
+    queues.returned.clear();
+    if (cycle_count++ % interval != 0) {
+      return 1;
+    }
+
+    if (!pending.has_value()) {
+      pending = generator();
+    }
+
+    bool accepted = false;
+    switch (pending->type) {
+    case access_type::WRITE:
+      accepted = queues.add_wq(*pending);
+      break;
+    case access_type::PREFETCH:
+      accepted = queues.add_pq(*pending);
+      break;
+    default:
+      accepted = queues.add_rq(*pending);
+    }
+
+    if (accepted) {
+      pending.reset();
+      ++issued;
+    }
+
+    return 1; // never deadlock
+  }
+};
+
+/*
+ * Initialize each element, end warmup, and start a phase
+ */
+inline void begin_simulation(const std::vector<champsim::operable*>& elements)
+{
+  for (auto* elem : elements) {
+    elem->initialize();
+    elem->warmup = false;
+    elem->begin_phase();
+  }
+}
+
+/*
+ * Operate each element for the given number of cycles
+ */
+inline void run_cycles(const std::vector<champsim::operable*>& elements, uint64_t cycles)
+{
+  for (uint64_t i = 0; i < cycles; ++i) {
+    for (auto* elem : elements) {
+      elem->_operate();
+    }
+  }
+}
+} // namespace champsim::bench
+
+#endif
@@ -0,0 +1,77 @@
+#include <catch.hpp>
+
+#include "host_profile.h"
+#include "operable.h"
+#include "stats_printer.h"
+
+namespace
+{
+struct mock_operable : champsim::operable {
+  using operable::operable;
+  long operate() { return 1; }
+};
+
+struct profiling_enabled {
+  bool previous = champsim::host_profiling;
+  profiling_enabled() { champsim::host_profiling = true; }
+  ~profiling_enabled() { champsim::host_profiling = previous; }
+};
+} // namespace
+
+TEST_CASE("A scoped host timer does nothing unless host profiling is enabled")
+{
+  champsim::host_profiling = false;
+  champsim::host_timer uut{};
+  {
+    champsim::scoped_host_timer timer{uut};
+  }
+  REQUIRE(uut.calls == 0);
+  REQUIRE(uut.elapsed == champsim::host_timer::clock_type::duration::zero());
+}
+
+TEST_CASE("A scoped host timer accumulates calls when host profiling is enabled")
+{
+  profiling_enabled guard{};
+  champsim::host_timer uut{};
+  for (int i = 0; i < 3; ++i) {
+    champsim::scoped_host_timer timer{uut};
+  }
+  REQUIRE(uut.calls == 3);
+  REQUIRE(uut.seconds() >= 0);
+}
+
+TEST_CASE("An operable counts the host time of each operate() when host profiling is enabled")
+{
+  profiling_enabled guard{};
+  champsim::chrono::clock global_clock{};
+  champsim::chrono::clock::duration period{100};
+  constexpr int num_cycles = 50;
+  mock_operable uut{period};
+
+  for (int i = 0; i < num_cycles; ++i) {
+    global_clock.tick(period);
+    uut.operate_on(global_clock);
+  }
+
+  REQUIRE(uut.operate_timer.calls == num_cycles);
+}
+
+TEST_CASE("KIPS is thousands of instructions per host second")
+{
+  REQUIRE(champsim::kips(2000000, std::chrono::duration<double>{2.0}) == Approx(1000));
+  REQUIRE(champsim::kips(2000000, std::chrono::duration<double>{0}) == 0);
+
+  champsim::host_profile profile{true, 4.0, {8000000}, {}};
+  REQUIRE(profile.kips(0) == Approx(2000));
+}
+
+TEST_CASE("The plain printer lists the host profile of components that were called")
+{
+  champsim::host_profile profile{true, 2.0, {1000000}, {{"cpu0", "operate", 1.0, 100}, {"LLC", "prefetcher_cache_fill", 0.0, 0}}};
+
+  auto lines = champsim::plain_printer::format(profile);
+  REQUIRE(std::size(lines) == 3);
+  REQUIRE(lines.at(0) == "Host time: 2.000 s");
+  REQUIRE(lines.at(1) == "CPU 0 instructions: 1000000 KIPS: 500");
+  REQUIRE_THAT(lines.at(2), Catch::Matchers::StartsWith("cpu0") && Catch::Matchers::Contains("operate") && Catch::Matchers::Contains("50.0%"));
+}
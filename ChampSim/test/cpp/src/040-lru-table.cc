@@ -1,5 +1,6 @@
 #include <catch.hpp>
 #include <type_traits>
+#include <utility>
 
 #include "address.h"
 #include "champsim.h"
@@ -290,3 +291,33 @@ TEMPLATE_TEST_CASE("A lru_table returns the evicted block on invalidation", "",
     }
   }
 }
+
+TEMPLATE_TEST_CASE("A lru_table peek does not change the LRU order", "",
+                   (champsim::lru_table<::strong_type<unsigned int>, ::strong_type_getter, ::strong_type_getter>), champsim::lru_table<::type_with_getters>)
+{
+  GIVEN("A lru_table with two elements")
+  {
+    constexpr unsigned int data = 0xcafebabe;
+    TestType uut{1, 2};
+    uut.fill({data});
+    uut.fill({data + 1});
+
+    WHEN("We peek at the first-added element and add a new element")
+    {
+      auto peeked = uut.peek({data});
+      uut.fill({data + 2});
+
+      THEN("The peek hits")
+      {
+        REQUIRE(peeked.has_value());
+        REQUIRE(peeked.value().value == data);
+      }
+
+      THEN("The first-added element is still replaced")
+      {
+        REQUIRE_FALSE(std::as_const(uut).peek({data}).has_value());
+        REQUIRE(uut.peek({data + 1}).has_value());
+      }
+    }
+  }
+}
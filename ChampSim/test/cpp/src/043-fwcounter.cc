@@ -194,3 +194,12 @@ TEMPLATE_TEST_CASE("A fixed-width counter is assignable with an out-of-bounds in
   lhs = 100;
   REQUIRE(lhs.value() == lhs.maximum);
 }
+
+TEMPLATE_TEST_CASE("A fixed-width counter saturates with decrement", "", champsim::msl::fwcounter<2>, champsim::msl::sfwcounter<2>)
+{
+  TestType lhs{0};
+  for (int i = 0; i < 5; ++i) {
+    --lhs;
+  }
+  REQUIRE(lhs.value() == lhs.minimum);
+}
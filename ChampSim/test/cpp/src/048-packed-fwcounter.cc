@@ -0,0 +1,74 @@
+#include <catch.hpp>
+#include <array>
+
+#include "msl/packed_fwcounter.h"
+
+TEMPLATE_TEST_CASE("A packed counter array matches an array of counters under saturating increment and decrement", "", champsim::msl::fwcounter<2>,
+                   champsim::msl::fwcounter<3>, champsim::msl::fwcounter<4>, champsim::msl::fwcounter<6>, champsim::msl::fwcounter<8>,
+                   champsim::msl::sfwcounter<2>, champsim::msl::sfwcounter<3>, champsim::msl::sfwcounter<4>, champsim::msl::sfwcounter<6>,
+                   champsim::msl::sfwcounter<8>)
+{
+  constexpr std::size_t size = 100;
+  champsim::msl::packed_fwcounter_array<TestType, size> uut;
+  std::array<TestType, size> reference{};
+
+  for (std::size_t step = 0; step < 1000; ++step) {
+    auto idx = (step * 37) % size;
+    if ((step / 7) % 3 == 0) {
+      --uut[idx];
+      reference[idx] -= 1;
+    } else {
+      ++uut[idx];
+      reference[idx] += 1;
+    }
+  }
+
+  for (std::size_t i = 0; i < size; ++i) {
+    REQUIRE(uut.at(i).value() == reference.at(i).value());
+  }
+}
+
+TEMPLATE_TEST_CASE("A packed counter array saturates without disturbing its neighbors", "", champsim::msl::fwcounter<2>, champsim::msl::fwcounter<3>,
+                   champsim::msl::fwcounter<6>, champsim::msl::sfwcounter<3>, champsim::msl::sfwcounter<8>)
+{
+  champsim::msl::packed_fwcounter_array<TestType, 64> uut;
+  for (int i = 0; i < 300; ++i) {
+    uut.increment(10);
+    uut.decrement(11);
+  }
+
+  REQUIRE(uut[10].is_max());
+  REQUIRE(uut[11].is_min());
+  REQUIRE(uut[9].value() == TestType{}.value());
+  REQUIRE(uut[12].value() == TestType{}.value());
+}
+
+TEMPLATE_TEST_CASE("A packed counter array reference supports counter arithmetic", "", champsim::msl::fwcounter<4>, champsim::msl::sfwcounter<4>)
+{
+  champsim::msl::packed_fwcounter_array<TestType, 8> uut;
+  uut[3] = 2;
+  uut[3] += 3;
+  REQUIRE(uut[3] == 5);
+  uut[3] -= 1;
+  REQUIRE(uut[3] == 4);
+  uut[3] += 100;
+  REQUIRE(uut[3].value() == TestType::maximum);
+  uut[3] -= 100;
+  REQUIRE(uut[3].value() == TestType::minimum);
+
+  TestType unpacked = uut[3];
+  REQUIRE(unpacked.value() == TestType::minimum);
+}
+
+TEST_CASE("A packed counter array uses no more storage than its lanes require")
+{
+  STATIC_REQUIRE(champsim::msl::packed_fwcounter_array<champsim::msl::fwcounter<2>, 16384>::storage_bytes() == 4096);
+  STATIC_REQUIRE(champsim::msl::packed_fwcounter_array<champsim::msl::fwcounter<3>, 21>::storage_bytes() == 8);
+  STATIC_REQUIRE(champsim::msl::packed_fwcounter_array<champsim::msl::sfwcounter<8>, 4096>::storage_bytes() == 4096);
+}
+
+TEST_CASE("A packed counter array bounds-checks at()")
+{
+  champsim::msl::packed_fwcounter_array<champsim::msl::fwcounter<2>, 10> uut;
+  REQUIRE_THROWS_AS(uut.at(10), std::out_of_range);
+}
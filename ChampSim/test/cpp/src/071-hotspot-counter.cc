@@ -0,0 +1,77 @@
+#include <catch.hpp>
+
+#include "hotspot_counter.h"
+
+TEST_CASE("A hotspot counter with no report size counts nothing")
+{
+  champsim::stats::hotspot_counter<int> uut{0};
+  uut.increment(2016);
+  REQUIRE_FALSE(uut.enabled());
+  REQUIRE(uut.empty());
+  REQUIRE(std::empty(uut.top()));
+}
+
+TEST_CASE("A hotspot counter is disabled by default")
+{
+  champsim::stats::hotspot_counter<int> uut{};
+  uut.increment(2016);
+  REQUIRE(uut.empty());
+}
+
+TEST_CASE("A hotspot counter counts exactly while its keys fit")
+{
+  champsim::stats::hotspot_counter<int> uut{2};
+  for (int i = 0; i < 3; ++i) {
+    uut.increment(10);
+  }
+  uut.increment(20);
+  for (int i = 0; i < 2; ++i) {
+    uut.increment(30);
+  }
+
+  auto top = uut.top();
+  REQUIRE(std::size(top) == 2);
+  CHECK(top.at(0).key == 10);
+  CHECK(top.at(0).count == 3);
+  CHECK(top.at(0).error == 0);
+  CHECK(top.at(1).key == 30);
+  CHECK(top.at(1).count == 2);
+  CHECK(top.at(1).error == 0);
+}
+
+TEST_CASE("A hotspot counter replaces its least frequent key and bounds the error")
+{
+  champsim::stats::hotspot_counter<int> uut{1};
+  constexpr auto monitored = decltype(uut)::monitored_per_reported;
+  for (int key = 0; key < static_cast<int>(monitored); ++key) {
+    uut.increment(key);
+    uut.increment(key);
+  }
+  uut.increment(100);
+
+  auto top = uut.top();
+  REQUIRE(std::size(top) == 1);
+  CHECK(top.at(0).key == 100);
+  CHECK(top.at(0).count == 3);
+  CHECK(top.at(0).error == 2);
+}
+
+TEST_CASE("A hotspot counter finds a heavy hitter among many rare keys")
+{
+  champsim::stats::hotspot_counter<int> uut{2};
+  long heavy_events = 0;
+  for (int i = 0; i < 10000; ++i) {
+    if (i % 4 == 0) {
+      uut.increment(-1);
+      ++heavy_events;
+    } else {
+      uut.increment(i);
+    }
+  }
+
+  auto top = uut.top();
+  REQUIRE_FALSE(std::empty(top));
+  CHECK(top.at(0).key == -1);
+  CHECK(top.at(0).count >= heavy_events);
+  CHECK(top.at(0).count - top.at(0).error <= heavy_events);
+}
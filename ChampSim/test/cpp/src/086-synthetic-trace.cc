@@ -0,0 +1,157 @@
+#include <catch.hpp>
+
+#include <sstream>
+
+#include "tracereader.h"
+
+namespace
+{
+std::vector<input_instr> generate(const champsim::synthetic_trace_parameters& params, std::size_t count)
+{
+  champsim::synthetic_trace_generator gen{params};
+  std::vector<input_instr> retval;
+  std::generate_n(std::back_inserter(retval), count, std::ref(gen));
+  return retval;
+}
+} // namespace
+
+TEST_CASE("Synthetic trace parameters are parsed from key-value pairs")
+{
+  auto uut = champsim::parse_synthetic_trace_parameters("seed=7, code_footprint=2M,branch_bias=0.95,strides=8:-64,geometric_block_size=true");
+  REQUIRE(uut.seed == 7);
+  REQUIRE(uut.code_footprint == 2 * 1024 * 1024);
+  REQUIRE(uut.branch_bias == Approx(0.95));
+  REQUIRE(uut.strides == std::vector<int64_t>{8, -64});
+  REQUIRE(uut.geometric_block_size);
+  REQUIRE(uut.data_footprint == champsim::synthetic_trace_parameters{}.data_footprint);
+}
+
+TEST_CASE("Invalid synthetic trace parameters are rejected")
+{
+  REQUIRE_THROWS_AS(champsim::parse_synthetic_trace_parameters("not_a_parameter=1"), std::invalid_argument);
+  REQUIRE_THROWS_AS(champsim::parse_synthetic_trace_parameters("length"), std::invalid_argument);
+  REQUIRE_THROWS_AS(champsim::parse_synthetic_trace_parameters("length=12Q"), std::invalid_argument);
+  REQUIRE_THROWS_AS(champsim::parse_synthetic_trace_parameters("branch_bias=1.5"), std::invalid_argument);
+  REQUIRE_THROWS_AS(champsim::parse_synthetic_trace_parameters("min_block_size=8,max_block_size=4"), std::invalid_argument);
+}
+
+TEST_CASE("Synthetic trace names are recognized")
+{
+  REQUIRE(champsim::is_synthetic_trace_name("synthetic"));
+  REQUIRE(champsim::is_synthetic_trace_name("synthetic:length=10"));
+  REQUIRE_FALSE(champsim::is_synthetic_trace_name("synthetic.champsimtrace.xz"));
+}
+
+TEST_CASE("A synthetic trace is reproducible from its seed")
+{
+  champsim::synthetic_trace_parameters params{};
+  auto first = generate(params, 10000);
+  auto second = generate(params, 10000);
+  REQUIRE(std::equal(std::begin(first), std::end(first), std::begin(second),
+                     [](const auto& lhs, const auto& rhs) { return std::memcmp(&lhs, &rhs, sizeof(input_instr)) == 0; }));
+
+  params.seed = 2;
+  auto other = generate(params, 10000);
+  REQUIRE_FALSE(std::equal(std::begin(first), std::end(first), std::begin(other),
+                           [](const auto& lhs, const auto& rhs) { return std::memcmp(&lhs, &rhs, sizeof(input_instr)) == 0; }));
+}
+
+TEST_CASE("A synthetic trace stays within its code and data footprints")
+{
+  champsim::synthetic_trace_parameters params{};
+  params.code_footprint = 16 * 1024;
+  params.data_footprint = 64 * 1024;
+  const auto code_limit = params.code_base + params.code_footprint + params.max_block_size * params.instruction_size;
+  const auto data_limit = params.data_base + params.data_footprint;
+
+  auto instrs = generate(params, 100000);
+  REQUIRE(std::all_of(std::begin(instrs), std::end(instrs), [&](const auto& x) { return x.ip >= params.code_base && x.ip < code_limit; }));
+
+  std::vector<unsigned long long> data_addresses;
+  for (const auto& instr : instrs) {
+    std::copy_if(std::begin(instr.source_memory), std::end(instr.source_memory), std::back_inserter(data_addresses), [](auto x) { return x != 0; });
+    std::copy_if(std::begin(instr.destination_memory), std::end(instr.destination_memory), std::back_inserter(data_addresses), [](auto x) { return x != 0; });
+  }
+  REQUIRE_FALSE(std::empty(data_addresses));
+  REQUIRE(std::all_of(std::begin(data_addresses), std::end(data_addresses), [&](auto x) { return x >= params.data_base && x < data_limit; }));
+}
+
+TEST_CASE("A synthetic trace has the requested branch mix")
+{
+  champsim::synthetic_trace_parameters params{};
+  params.jump_fraction = 0;
+  params.call_fraction = 0.2;
+  params.return_fraction = 0.2;
+  params.indirect_fraction = 0.1;
+  params.indirect_call_fraction = 0;
+
+  std::array<std::size_t, 8> counts{};
+  champsim::synthetic_tracereader uut{0, params};
+  for (int i = 0; i < 200000; ++i) {
+    counts.at(uut().branch)++;
+  }
+
+  REQUIRE(counts[BRANCH_DIRECT_CALL] > 0);
+  REQUIRE(counts[BRANCH_RETURN] > 0);
+  REQUIRE(counts[BRANCH_INDIRECT] > 0);
+  REQUIRE(counts[BRANCH_CONDITIONAL] > 0);
+  REQUIRE(counts[BRANCH_INDIRECT_CALL] == 0);
+  REQUIRE(counts[BRANCH_OTHER] == 0);
+}
+
+TEST_CASE("A synthetic tracereader sets the targets of taken branches")
+{
+  champsim::synthetic_tracereader uut{0, champsim::synthetic_trace_parameters{}};
+  const auto instruction_size = champsim::synthetic_trace_parameters{}.instruction_size;
+
+  auto prev = uut();
+  for (int i = 0; i < 100000; ++i) {
+    auto next = uut();
+    if (prev.is_branch && prev.branch_taken) {
+      REQUIRE(prev.branch_target == next.ip);
+    } else {
+      REQUIRE(next.ip == prev.ip + instruction_size);
+    }
+    prev = next;
+  }
+}
+
+TEST_CASE("A synthetic trace written to a stream reads back as the same trace")
+{
+  auto params = champsim::parse_synthetic_trace_parameters("length=5000,seed=3");
+  std::ostringstream out;
+  champsim::write_synthetic_trace(out, params);
+  REQUIRE(std::size(out.str()) == 5000 * sizeof(input_instr));
+
+  champsim::bulk_tracereader<input_instr, std::istringstream> from_file{0, std::istringstream{out.str()}};
+  champsim::synthetic_tracereader in_process{0, params};
+  for (int i = 0; i < 4999; ++i) {
+    auto expected = in_process();
+    auto actual = from_file();
+    REQUIRE(actual.ip == expected.ip);
+    REQUIRE(actual.branch == expected.branch);
+    REQUIRE(actual.branch_taken == expected.branch_taken);
+    REQUIRE(actual.branch_target == expected.branch_target);
+    REQUIRE(actual.source_memory == expected.source_memory);
+    REQUIRE(actual.destination_memory == expected.destination_memory);
+  }
+}
+
+TEST_CASE("A synthetic trace with a length ends")
+{
+  auto uut = get_tracereader("synthetic:length=100", 0, false, false);
+  for (int i = 0; i < 100; ++i) {
+    REQUIRE_FALSE(uut.eof());
+    (void)uut();
+  }
+  REQUIRE(uut.eof());
+}
+
+TEST_CASE("A repeating synthetic trace does not end")
+{
+  auto uut = get_tracereader("synthetic:length=100", 0, false, true);
+  for (int i = 0; i < 300; ++i) {
+    (void)uut();
+  }
+  REQUIRE_FALSE(uut.eof());
+}
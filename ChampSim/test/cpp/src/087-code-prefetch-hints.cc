@@ -0,0 +1,115 @@
+#include <catch.hpp>
+
+#include <sstream>
+
+#include "code_prefetch_hints.h"
+
+namespace
+{
+constexpr uint64_t loop_base = 0x400000;
+
+// A loop over more code blocks than the modeled L1I holds, so that every block misses on every iteration
+champsim::code_prefetch_analyzer analyze_thrashing_loop(champsim::code_prefetch_analysis_parameters params, int iterations)
+{
+  champsim::code_prefetch_analyzer uut{params};
+  for (int i = 0; i < iterations; ++i) {
+    for (uint64_t ip = loop_base; ip < loop_base + 4 * params.block_size; ip += 4) {
+      uut(ip);
+    }
+  }
+  return uut;
+}
+} // namespace
+
+TEST_CASE("Code prefetch analysis parameters are parsed from key-value pairs")
+{
+  auto uut = champsim::parse_code_prefetch_analysis_parameters("distance=32, min_accuracy=0.75,sets=16");
+  REQUIRE(uut.distance == 32);
+  REQUIRE(uut.min_accuracy == Approx(0.75));
+  REQUIRE(uut.sets == 16);
+  REQUIRE(uut.ways == champsim::code_prefetch_analysis_parameters{}.ways);
+
+  REQUIRE_THROWS_AS(champsim::parse_code_prefetch_analysis_parameters("not_a_parameter=1"), std::invalid_argument);
+  REQUIRE_THROWS_AS(champsim::parse_code_prefetch_analysis_parameters("block_size=48"), std::invalid_argument);
+  REQUIRE_THROWS_AS(champsim::parse_code_prefetch_analysis_parameters("min_accuracy=2"), std::invalid_argument);
+  REQUIRE_THROWS_AS(champsim::parse_code_prefetch_analysis_parameters("distance=-1"), std::invalid_argument);
+}
+
+TEST_CASE("The analyzer places a prefetch of each missing block the chosen distance ahead of it")
+{
+  champsim::code_prefetch_analysis_parameters params{};
+  params.sets = 1;
+  params.ways = 2;
+  params.distance = 8;
+
+  auto uut = ::analyze_thrashing_loop(params, 10);
+  auto hints = uut.hints();
+
+  // Each of the four blocks is prefetched by the instruction 8 instructions (32 bytes) before its first instruction, wrapping around the loop
+  for (uint64_t block = 0; block < 4; ++block) {
+    auto block_addr = loop_base + block * params.block_size;
+    auto trigger = block == 0 ? loop_base + 4 * params.block_size - 32 : block_addr - 32;
+    REQUIRE(hints.targets(trigger) == std::vector{block_addr});
+  }
+  REQUIRE(std::size(hints) == 4);
+
+  auto stats = uut.stats();
+  REQUIRE(stats.instructions == 10 * 4 * 16);
+  REQUIRE(stats.misses == 40);
+  REQUIRE(stats.covered_misses == 39); // the first miss has no instruction before it
+}
+
+TEST_CASE("The analyzer does not place prefetches for blocks that stay in the cache")
+{
+  champsim::code_prefetch_analysis_parameters params{};
+  params.distance = 8;
+
+  auto uut = ::analyze_thrashing_loop(params, 10);
+  REQUIRE(uut.stats().misses == 4);
+  REQUIRE(std::empty(uut.hints()));
+}
+
+TEST_CASE("The analyzer does not place prefetches on paths that rarely lead to the miss")
+{
+  champsim::code_prefetch_analysis_parameters params{};
+  params.sets = 1;
+  params.ways = 2;
+  params.distance = 8;
+  params.min_accuracy = 0.5;
+
+  auto uut = ::analyze_thrashing_loop(params, 10);
+
+  // The would-be trigger of the first block runs many more times without leading to a miss
+  for (int i = 0; i < 100; ++i) {
+    uut(loop_base + 4 * params.block_size - 32);
+  }
+  REQUIRE(std::size(uut.hints()) == 3);
+}
+
+TEST_CASE("Code prefetch hints survive a round trip through a hint file")
+{
+  champsim::code_prefetch_hints hints{};
+  hints.add(0x401000, 0x402000);
+  hints.add(0x401000, 0x403000);
+  hints.add(0x400100, 0x402040);
+
+  std::stringstream file;
+  champsim::write_code_prefetch_hints(file, hints);
+  auto uut = champsim::read_code_prefetch_hints(file);
+
+  REQUIRE(uut.hints() == hints.hints());
+  REQUIRE(uut.targets(0x401000) == std::vector<uint64_t>{0x402000, 0x403000});
+  REQUIRE(std::empty(uut.targets(0x402000)));
+}
+
+TEST_CASE("Malformed hint files are rejected")
+{
+  std::istringstream comments{"# a comment\n\n0x10 0x40 # trailing comment\n"};
+  REQUIRE(std::size(champsim::read_code_prefetch_hints(comments)) == 1);
+
+  std::istringstream one_field{"0x10\n"};
+  REQUIRE_THROWS_AS(champsim::read_code_prefetch_hints(one_field), std::invalid_argument);
+
+  std::istringstream not_hex{"0x10 0xzz\n"};
+  REQUIRE_THROWS_AS(champsim::read_code_prefetch_hints(not_hex), std::invalid_argument);
+}
@@ -0,0 +1,110 @@
+#include <catch.hpp>
+
+#include <sstream>
+
+#include "code_layout.h"
+#include "instr.h"
+#include "tracereader.h"
+
+TEST_CASE("A code layout moves the addresses in its ranges and keeps the others")
+{
+  champsim::code_layout uut{};
+  uut.add(0x1000, 0x1100, 0x8000);
+  uut.add(0x2000, 0x2040, 0x7000);
+
+  REQUIRE(uut.remap(0x1000) == 0x8000);
+  REQUIRE(uut.remap(0x10fc) == 0x80fc);
+  REQUIRE(uut.remap(0x2010) == 0x7010);
+  REQUIRE(uut.remap(0x1100) == 0x1100);
+  REQUIRE(uut.remap(0x0ffc) == 0x0ffc);
+}
+
+TEST_CASE("Overlapping code layout ranges are rejected")
+{
+  champsim::code_layout uut{};
+  uut.add(0x1000, 0x1100, 0x8000);
+
+  REQUIRE_THROWS_AS(uut.add(0x10f0, 0x1200, 0x9000), std::invalid_argument);
+  REQUIRE_THROWS_AS(uut.add(0x0f00, 0x1010, 0x9000), std::invalid_argument);
+  REQUIRE_THROWS_AS(uut.add(0x3000, 0x3100, 0x80f0), std::invalid_argument);
+  REQUIRE_THROWS_AS(uut.add(0x3000, 0x3000, 0x9000), std::invalid_argument);
+  REQUIRE_NOTHROW(uut.add(0x1100, 0x1200, 0x8100));
+}
+
+TEST_CASE("A code layout survives a round trip through a layout file")
+{
+  champsim::code_layout layout{};
+  layout.add(0x1000, 0x1100, 0x8000);
+  layout.add(0x2000, 0x2040, 0x7000);
+
+  std::stringstream file;
+  champsim::write_code_layout(file, layout);
+  auto uut = champsim::read_code_layout(file);
+
+  REQUIRE(std::size(uut) == 2);
+  REQUIRE(uut.remap(0x1004) == 0x8004);
+  REQUIRE(uut.remap(0x2004) == 0x7004);
+
+  std::istringstream two_fields{"0x1000 0x1100\n"};
+  REQUIRE_THROWS_AS(champsim::read_code_layout(two_fields), std::invalid_argument);
+}
+
+TEST_CASE("The profiler places hot code along its hottest jumps and moves cold code after it")
+{
+  champsim::code_layout_parameters params{};
+  params.cold_fraction = 0.01;
+  champsim::code_layout_profiler uut{params};
+
+  auto jump = [](uint64_t ip) {
+    auto instr = champsim::test::branch_instruction_with_ip(ip);
+    REQUIRE(instr.branch == BRANCH_DIRECT_JUMP);
+    return instr;
+  };
+
+  // Cold code runs once, then a loop jumps between two distant chunks
+  uut(champsim::test::instruction_with_ip(0x2000));
+  uut(jump(0x2004));
+  for (int i = 0; i < 100; ++i) {
+    uut(champsim::test::instruction_with_ip(0x1000));
+    uut(champsim::test::instruction_with_ip(0x1004));
+    uut(jump(0x1008));
+    uut(champsim::test::instruction_with_ip(0x3000));
+    uut(jump(0x3004));
+  }
+
+  auto layout = uut.layout();
+  REQUIRE(std::size(layout) == 3);
+
+  // The hottest chunk joins its most frequent predecessor, whose cluster is denser
+  REQUIRE(layout.remap(0x3000) == 0x1000);
+  REQUIRE(layout.remap(0x3004) == 0x1004);
+  REQUIRE(layout.remap(0x1000) == 0x1020);
+  REQUIRE(layout.remap(0x1008) == 0x1028);
+  REQUIRE(layout.remap(0x2004) == 0x1044);
+}
+
+TEST_CASE("A code layout reader remaps instruction pointers and branch targets")
+{
+  champsim::code_layout layout{};
+  layout.add(0x1000, 0x1100, 0x8000);
+
+  auto reader = [ip = uint64_t{0x1000}]() mutable {
+    auto instr = champsim::test::branch_instruction_with_ip(ip);
+    instr.branch_target = champsim::address{ip + 0x10};
+    ip += 0x10;
+    return instr;
+  };
+  champsim::code_layout_tracereader uut{champsim::tracereader{std::move(reader)}, layout};
+
+  auto first = uut();
+  REQUIRE(first.ip == champsim::address{0x8000});
+  REQUIRE(first.branch_target == champsim::address{0x8010});
+  REQUIRE(first.is_branch);
+
+  for (int i = 0; i < 14; ++i) {
+    uut();
+  }
+  auto last_moved = uut();
+  REQUIRE(last_moved.ip == champsim::address{0x80f0});
+  REQUIRE(last_moved.branch_target == champsim::address{0x1100});
+}
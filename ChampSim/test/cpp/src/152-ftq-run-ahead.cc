@@ -0,0 +1,165 @@
+#include <catch.hpp>
+#include <map>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "instr.h"
+#include "ooo_cpu.h"
+#include "util/bits.h"
+
+namespace
+{
+std::map<CACHE*, std::vector<champsim::address>> ftq_enqueue_collector;
+
+struct ftq_collector : champsim::modules::prefetcher {
+  using prefetcher::prefetcher;
+
+  void prefetcher_ftq_enqueue(champsim::address fetch_addr) { ::ftq_enqueue_collector[intern_].push_back(fetch_addr); }
+};
+} // namespace
+
+SCENARIO("The branch prediction unit runs ahead of fetch until the FTQ is full")
+{
+  auto ftq_size = GENERATE(as<std::size_t>{}, 1, 2, 8);
+  GIVEN("A core whose instruction fetches are never accepted")
+  {
+    constexpr long fetch_width = 4;
+    // Nothing drains these queues
+    champsim::channel fetch_queues{32, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel data_queues{32, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel lower_queues{};
+    CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("152-l1i").lower_level(&lower_queues).prefetcher<::ftq_collector>()};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&fetch_queues)
+                   .data_queues(&data_queues)
+                   .l1i(&l1i)
+                   .ifetch_buffer_size(fetch_width)
+                   .fetch_width(champsim::bandwidth::maximum_type{fetch_width})
+                   .ftq_size(ftq_size)};
+    ::ftq_enqueue_collector[&l1i].clear();
+
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    std::vector<champsim::address> ips;
+    for (uint64_t i = 0; i < 100; ++i) {
+      ips.push_back(champsim::address{0x10000 + i * BLOCK_SIZE});
+      uut.input_queue.push_back(champsim::test::instruction_with_ip(ips.back()));
+      uut.input_queue.back().instr_id = i;
+    }
+
+    WHEN("The core operates for many cycles")
+    {
+      for (int i = 0; i < 100; ++i) {
+        uut._operate();
+      }
+
+      THEN("The fetch buffer is full")
+      {
+        REQUIRE(std::size(uut.IFETCH_BUFFER) == fetch_width);
+      }
+
+      THEN("The FTQ holds one block per instruction beyond the fetch buffer")
+      {
+        REQUIRE(std::size(uut.FTQ) == ftq_size);
+        REQUIRE(uut.FTQ.front().fetch_addr == ips.at(fetch_width));
+        REQUIRE(uut.FTQ.back().fetch_addr == ips.at(fetch_width + ftq_size - 1));
+      }
+
+      THEN("Each enqueued block is given to the L1I prefetcher")
+      {
+        std::vector<champsim::address> expected(std::begin(ips), std::next(std::begin(ips), static_cast<long>(fetch_width + ftq_size)));
+        REQUIRE(::ftq_enqueue_collector.at(&l1i) == expected);
+      }
+    }
+  }
+}
+
+SCENARIO("The branch prediction unit groups instructions into fetch blocks")
+{
+  GIVEN("A core with a deep FTQ and a stream that crosses a cache block and takes a branch")
+  {
+    // Nothing drains these queues
+    champsim::channel fetch_queues{32, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel data_queues{32, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel lower_queues{};
+    CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("152-l1i").lower_level(&lower_queues).prefetcher<::ftq_collector>()};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&fetch_queues)
+                   .data_queues(&data_queues)
+                   .l1i(&l1i)
+                   .ifetch_buffer_size(1)
+                   .fetch_width(champsim::bandwidth::maximum_type{8})
+                   .ftq_size(8)};
+    ::ftq_enqueue_collector[&l1i].clear();
+
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    // Two instructions in one block, then a taken branch in the next block, then its target in the same block
+    std::array<ooo_model_instr, 4> instrs{
+        {champsim::test::instruction_with_ip(0x10038), champsim::test::instruction_with_ip(0x1003c), champsim::test::branch_instruction_with_ip(0x10040),
+         champsim::test::instruction_with_ip(0x10044)}};
+    for (auto& instr : instrs) {
+      uut.input_queue.push_back(instr);
+    }
+
+    WHEN("The core operates for a few cycles")
+    {
+      for (int i = 0; i < 3; ++i) {
+        uut._operate();
+      }
+
+      THEN("A block ends at a cache block boundary or a taken branch")
+      {
+        std::vector<champsim::address> expected{champsim::address{0x10038}, champsim::address{0x10040}, champsim::address{0x10044}};
+        REQUIRE(::ftq_enqueue_collector.at(&l1i) == expected);
+        REQUIRE(std::empty(uut.input_queue));
+      }
+    }
+  }
+}
+
+SCENARIO("The branch prediction unit stops at a misprediction")
+{
+  GIVEN("A core with a deep FTQ and a mispredicted branch")
+  {
+    // Nothing drains these queues
+    champsim::channel fetch_queues{32, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel data_queues{32, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel lower_queues{};
+    CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("152-l1i").lower_level(&lower_queues).prefetcher<::ftq_collector>()};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&fetch_queues)
+                   .data_queues(&data_queues)
+                   .l1i(&l1i)
+                   .ifetch_buffer_size(1)
+                   .fetch_width(champsim::bandwidth::maximum_type{8})
+                   .ftq_size(8)};
+    ::ftq_enqueue_collector[&l1i].clear();
+
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    // The core has no BTB, so the branch target cannot be predicted
+    uut.input_queue.push_back(champsim::test::branch_instruction_with_ip(0x10000));
+    uut.input_queue.back().branch_target = champsim::address{0x20000};
+    uut.input_queue.push_back(champsim::test::instruction_with_ip(0x20000));
+
+    WHEN("The core operates for a few cycles")
+    {
+      for (int i = 0; i < 10; ++i) {
+        uut._operate();
+      }
+
+      THEN("The instructions after the branch are not predicted")
+      {
+        REQUIRE(std::size(uut.input_queue) == 1);
+        REQUIRE(::ftq_enqueue_collector.at(&l1i) == std::vector<champsim::address>{champsim::address{0x10000}});
+      }
+    }
+  }
+}
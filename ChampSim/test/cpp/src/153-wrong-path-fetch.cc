@@ -0,0 +1,256 @@
+#include <catch.hpp>
+#include <map>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "instr.h"
+#include "ooo_cpu.h"
+#include "static_code_map.h"
+#include "util/bits.h"
+
+namespace
+{
+std::vector<champsim::address> wrong_path_reads(const champsim::channel& queues)
+{
+  std::vector<champsim::address> retval;
+  for (const auto& pkt : queues.RQ) {
+    if (pkt.wrong_path) {
+      retval.push_back(pkt.v_address);
+    }
+  }
+  return retval;
+}
+} // namespace
+
+TEST_CASE("The static code map finds the known branches in a range")
+{
+  champsim::static_code_map uut;
+  uut.record(champsim::address{0x1008}, BRANCH_CONDITIONAL, champsim::address{0x2000}, true);
+  uut.record(champsim::address{0x1010}, BRANCH_DIRECT_JUMP, champsim::address{0x3000}, true);
+  uut.record(champsim::address{0x1008}, BRANCH_CONDITIONAL, champsim::address{}, false);
+
+  REQUIRE(uut.size() == 2);
+
+  auto first = uut.next_branch(champsim::address{0x1000}, champsim::address{0x1040});
+  REQUIRE(first.has_value());
+  CHECK(first->first == champsim::address{0x1008});
+  CHECK(first->second.target == champsim::address{0x2000}); // a not-taken execution does not forget the target
+  CHECK_FALSE(first->second.taken);
+
+  auto second = uut.next_branch(champsim::address{0x1009}, champsim::address{0x1040});
+  REQUIRE(second.has_value());
+  CHECK(second->first == champsim::address{0x1010});
+
+  CHECK_FALSE(uut.next_branch(champsim::address{0x1011}, champsim::address{0x1040}).has_value());
+  CHECK(std::size(uut.branches_in(champsim::address{0x1000}, champsim::address{0x1040})) == 2);
+  CHECK(std::empty(uut.branches_in(champsim::address{0x1040}, champsim::address{0x1000})));
+}
+
+SCENARIO("A core with wrong-path fetch continues down the predicted path after a misprediction")
+{
+  auto wrong_path_fetch = GENERATE(true, false);
+  GIVEN("A core with a mispredicted branch")
+  {
+    // Nothing drains these queues
+    champsim::channel fetch_queues{32, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel data_queues{32, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel lower_queues{};
+    CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("153-l1i").lower_level(&lower_queues)};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&fetch_queues)
+                   .data_queues(&data_queues)
+                   .l1i(&l1i)
+                   .ifetch_buffer_size(8)
+                   .fetch_width(champsim::bandwidth::maximum_type{8})
+                   .ftq_size(4)
+                   .wrong_path_fetch(wrong_path_fetch)};
+
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    // The core has no BTB, so the taken branch is predicted not taken
+    uut.input_queue.push_back(champsim::test::branch_instruction_with_ip(0x10000));
+    uut.input_queue.back().branch_target = champsim::address{0x20000};
+    uut.input_queue.push_back(champsim::test::instruction_with_ip(0x20000));
+
+    WHEN("The core operates for a few cycles")
+    {
+      for (int i = 0; i < 10; ++i) {
+        uut._operate();
+      }
+
+      THEN("The correct path is fetched without the wrong-path tag")
+      {
+        REQUIRE_FALSE(std::empty(fetch_queues.RQ));
+        CHECK(fetch_queues.RQ.front().v_address == champsim::address{0x10000});
+        CHECK_FALSE(fetch_queues.RQ.front().wrong_path);
+      }
+
+      THEN("Every fetch is an instruction fetch")
+      {
+        CHECK(std::all_of(std::begin(fetch_queues.RQ), std::end(fetch_queues.RQ),
+                          [](const auto& pkt) { return pkt.type == access_type::IFETCH && pkt.is_instruction; }));
+      }
+
+      if (wrong_path_fetch) {
+        THEN("The blocks after the branch are fetched as wrong-path")
+        {
+          auto reads = wrong_path_reads(fetch_queues);
+          REQUIRE(std::size(reads) >= 3);
+          CHECK(reads.at(0) == champsim::address{0x10040});
+          CHECK(reads.at(1) == champsim::address{0x10080});
+          CHECK(reads.at(2) == champsim::address{0x100c0});
+          CHECK(std::all_of(std::begin(fetch_queues.RQ), std::end(fetch_queues.RQ), [](const auto& pkt) { return !pkt.wrong_path || !pkt.response_requested; }));
+        }
+      } else {
+        THEN("Nothing is fetched past the branch")
+        {
+          CHECK(std::empty(wrong_path_reads(fetch_queues)));
+        }
+      }
+
+      AND_WHEN("The branch resolves")
+      {
+        auto reads_before = std::size(wrong_path_reads(fetch_queues));
+        uut.fetch_resume_time = uut.current_time;
+        for (int i = 0; i < 10; ++i) {
+          uut._operate();
+        }
+
+        THEN("The wrong path is squashed")
+        {
+          CHECK(std::none_of(std::begin(uut.FTQ), std::end(uut.FTQ), [](const auto& entry) { return entry.wrong_path; }));
+          CHECK(std::size(wrong_path_reads(fetch_queues)) == reads_before);
+          CHECK(std::empty(uut.input_queue));
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("A wrong path that ends on a branch the BTB cannot predict is squashed when the misprediction resolves")
+{
+  GIVEN("A core whose wrong path meets a known taken branch")
+  {
+    // Nothing drains these queues, and the read queue is full after the correct-path fetch, so the wrong path waits in the FTQ
+    champsim::channel fetch_queues{1, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel data_queues{32, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel lower_queues{};
+    CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("153-l1i").lower_level(&lower_queues)};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&fetch_queues)
+                   .data_queues(&data_queues)
+                   .l1i(&l1i)
+                   .ifetch_buffer_size(8)
+                   .fetch_width(champsim::bandwidth::maximum_type{8})
+                   .ftq_size(4)
+                   .wrong_path_fetch(true)};
+
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    // The core has no BTB, so it has no target for the branch in the second wrong-path block
+    uut.code_map.record(champsim::address{0x10084}, BRANCH_DIRECT_JUMP, champsim::address{0x30000}, true);
+    uut.input_queue.push_back(champsim::test::branch_instruction_with_ip(0x10000));
+    uut.input_queue.back().branch_target = champsim::address{0x20000};
+    uut.input_queue.push_back(champsim::test::instruction_with_ip(0x20000));
+
+    WHEN("The core operates for a few cycles")
+    {
+      for (int i = 0; i < 10; ++i) {
+        uut._operate();
+      }
+
+      THEN("The wrong path ends at the branch, but its blocks wait in the FTQ")
+      {
+        CHECK_FALSE(uut.wrong_path_addr.has_value());
+        CHECK(std::count_if(std::begin(uut.FTQ), std::end(uut.FTQ), [](const auto& entry) { return entry.wrong_path; }) == 2);
+      }
+
+      AND_WHEN("The branch resolves")
+      {
+        uut.fetch_resume_time = uut.current_time;
+        for (int i = 0; i < 10; ++i) {
+          uut._operate();
+        }
+
+        THEN("The wrong path is squashed")
+        {
+          CHECK(std::none_of(std::begin(uut.FTQ), std::end(uut.FTQ), [](const auto& entry) { return entry.wrong_path; }));
+          CHECK(std::empty(wrong_path_reads(fetch_queues)));
+        }
+      }
+    }
+  }
+}
+
+namespace
+{
+std::map<O3_CPU*, long> btb_predictions;
+
+// A BTB that predicts every branch taken to the same target, and counts the predictions that may change its state
+struct counting_btb : champsim::modules::btb {
+  using btb::btb;
+
+  std::pair<champsim::address, bool> btb_prediction(champsim::address)
+  {
+    ++::btb_predictions[intern_];
+    return btb_peek(champsim::address{});
+  }
+
+  [[nodiscard]] std::pair<champsim::address, bool> btb_peek(champsim::address) const { return {champsim::address{0x20000}, true}; }
+};
+} // namespace
+
+SCENARIO("The wrong path is followed without changing the state of the BTB")
+{
+  GIVEN("A core whose wrong path meets a known taken branch")
+  {
+    champsim::channel fetch_queues{32, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel data_queues{32, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel lower_queues{};
+    CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("153-l1i").lower_level(&lower_queues)};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&fetch_queues)
+                   .data_queues(&data_queues)
+                   .l1i(&l1i)
+                   .ifetch_buffer_size(8)
+                   .fetch_width(champsim::bandwidth::maximum_type{8})
+                   .ftq_size(4)
+                   .btb<::counting_btb>()
+                   .wrong_path_fetch(true)};
+    ::btb_predictions[&uut] = 0;
+
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    // The branch is predicted taken to the wrong target, so the wrong path begins there and meets the known branch
+    uut.code_map.record(champsim::address{0x20004}, BRANCH_DIRECT_JUMP, champsim::address{0x30000}, true);
+    uut.input_queue.push_back(champsim::test::branch_instruction_with_ip(0x10000));
+    uut.input_queue.back().branch = BRANCH_DIRECT_JUMP;
+    uut.input_queue.back().branch_target = champsim::address{0x40000};
+
+    WHEN("The core follows the wrong path")
+    {
+      for (int i = 0; i < 10; ++i) {
+        uut._operate();
+      }
+
+      THEN("The wrong path follows the predicted target of the known branch")
+      {
+        auto reads = wrong_path_reads(fetch_queues);
+        REQUIRE(std::size(reads) >= 2);
+        CHECK(reads.at(0) == champsim::address{0x20000});
+        CHECK(reads.at(1) == champsim::address{0x20000});
+      }
+
+      THEN("Only the mispredicted branch made a prediction")
+      {
+        CHECK(::btb_predictions[&uut] == 1);
+      }
+    }
+  }
+}
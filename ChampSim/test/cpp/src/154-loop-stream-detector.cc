@@ -0,0 +1,113 @@
+#include <catch.hpp>
+#include <numeric>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "instr.h"
+#include "ooo_cpu.h"
+#include "util/bits.h"
+
+namespace
+{
+constexpr uint64_t loop_head = 0x1000;
+constexpr uint64_t loop_branch = 0x100c;
+
+// Predicts the loop branch as always taken, back to the head of the loop
+struct loop_btb : champsim::modules::btb {
+  using btb::btb;
+
+  std::pair<champsim::address, bool> btb_prediction(champsim::address ip)
+  {
+    if (ip == champsim::address{loop_branch}) {
+      return {champsim::address{loop_head}, true};
+    }
+    return {champsim::address{}, false};
+  }
+};
+
+void push_loop(O3_CPU& uut, int iterations)
+{
+  for (int i = 0; i < iterations; ++i) {
+    for (uint64_t ip = loop_head; ip < loop_branch; ip += 4) {
+      uut.input_queue.push_back(champsim::test::instruction_with_ip(ip));
+    }
+    uut.input_queue.push_back(champsim::test::branch_instruction_with_ip(loop_branch));
+    uut.input_queue.back().branch = BRANCH_CONDITIONAL;
+    uut.input_queue.back().branch_target = champsim::address{loop_head};
+    uut.input_queue.back().branch_taken = (i + 1 < iterations);
+  }
+  uut.input_queue.push_back(champsim::test::instruction_with_ip(loop_branch + 4));
+}
+
+std::size_t replayed(const O3_CPU& uut)
+{
+  return static_cast<std::size_t>(std::count_if(std::begin(uut.IFETCH_BUFFER), std::end(uut.IFETCH_BUFFER), [](const auto& x) { return x.decoded; }));
+}
+} // namespace
+
+SCENARIO("The loop stream detector replays a small loop without fetching it")
+{
+  auto lsd_size = GENERATE(as<std::size_t>{}, 0, 2, 4, 16);
+  GIVEN("A core with a loop stream detector and a loop of four instructions")
+  {
+    // Nothing drains these queues
+    champsim::channel fetch_queues{32, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel data_queues{32, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel lower_queues{};
+    CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("154-l1i").lower_level(&lower_queues)};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&fetch_queues)
+                   .data_queues(&data_queues)
+                   .l1i(&l1i)
+                   .ifetch_buffer_size(64)
+                   .fetch_width(champsim::bandwidth::maximum_type{4})
+                   .ftq_size(64)
+                   .lsd_size(lsd_size)
+                   .btb<::loop_btb>()};
+
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    constexpr int iterations = 10;
+    push_loop(uut, iterations);
+
+    WHEN("The core predicts the whole loop")
+    {
+      for (int i = 0; i < 30; ++i) {
+        uut._operate();
+      }
+
+      THEN("The loop exit mispredicts")
+      {
+        REQUIRE(std::size(uut.input_queue) == 1);
+      }
+
+      if (lsd_size >= 4) {
+        THEN("The loop is locked after it fits for two iterations, and replayed until it exits")
+        {
+          constexpr auto replayed_iterations = iterations - 1 - O3_CPU::LSD_LOCK_ITERATIONS;
+          REQUIRE(uut.sim_stats.lsd_locks == 1);
+          REQUIRE(uut.sim_stats.lsd_hits == 4 * replayed_iterations);
+          REQUIRE(uut.sim_stats.lsd_l1i_accesses_avoided == replayed_iterations);
+          REQUIRE(replayed(uut) == 4 * replayed_iterations);
+          REQUIRE_FALSE(uut.lsd.locked);
+        }
+
+        THEN("Only the iterations before the lock are fetched from the L1I")
+        {
+          auto fetched = std::accumulate(std::begin(fetch_queues.RQ), std::end(fetch_queues.RQ), std::size_t{0},
+                                         [](auto acc, const auto& pkt) { return acc + std::size(pkt.instr_depend_on_me); });
+          REQUIRE(fetched == 4 * (O3_CPU::LSD_LOCK_ITERATIONS + 1));
+        }
+      } else {
+        THEN("The loop is not replayed")
+        {
+          REQUIRE(uut.sim_stats.lsd_locks == 0);
+          REQUIRE(uut.sim_stats.lsd_hits == 0);
+          REQUIRE(replayed(uut) == 0);
+        }
+      }
+    }
+  }
+}
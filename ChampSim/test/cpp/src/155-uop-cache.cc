@@ -0,0 +1,131 @@
+#include <catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include "instr.h"
+#include "ooo_cpu.h"
+#include "uop_cache.h"
+
+SCENARIO("A micro-op cache holds a limited number of micro-ops for each window")
+{
+  auto partial = GENERATE(false, true);
+  GIVEN("A micro-op cache with two micro-ops per line and three lines per window")
+  {
+    champsim::uop_cache uut{4, 8, 32, 2, 3, partial};
+
+    WHEN("A window of six instructions is decoded")
+    {
+      for (uint64_t ip = 0x1000; ip < 0x1018; ip += 4) {
+        uut.fill(champsim::address{ip});
+      }
+
+      THEN("All of its micro-ops hit")
+      {
+        REQUIRE(uut.occupancy(champsim::address{0x1000}) == 6);
+        for (uint64_t ip = 0x1000; ip < 0x1018; ip += 4) {
+          REQUIRE(uut.check_hit(champsim::address{ip}));
+        }
+      }
+
+      AND_WHEN("A seventh instruction of the same window is decoded")
+      {
+        uut.fill(champsim::address{0x1018});
+
+        THEN("It does not fit")
+        {
+          REQUIRE_FALSE(uut.check_hit(champsim::address{0x1018}));
+          if (partial) {
+            REQUIRE(uut.occupancy(champsim::address{0x1000}) == 6);
+          } else {
+            REQUIRE(uut.occupancy(champsim::address{0x1000}) == 0);
+          }
+        }
+
+        AND_WHEN("The window is decoded again")
+        {
+          std::vector<bool> hit_after_fill{};
+          for (uint64_t ip = 0x1000; ip < 0x101c; ip += 4) {
+            uut.fill(champsim::address{ip});
+            hit_after_fill.push_back(uut.check_hit(champsim::address{ip}));
+          }
+
+          THEN("It is never cached again unless partial windows are kept")
+          {
+            if (partial) {
+              REQUIRE(uut.occupancy(champsim::address{0x1000}) == 6);
+            } else {
+              REQUIRE(std::none_of(std::begin(hit_after_fill), std::end(hit_after_fill), [](bool hit) { return hit; }));
+              REQUIRE(uut.occupancy(champsim::address{0x1000}) == 0);
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("A micro-op cache replaces its least recently used line")
+{
+  champsim::uop_cache uut{1, 2, 32, 4, 3, false};
+  uut.fill(champsim::address{0x1000});
+  uut.fill(champsim::address{0x2000});
+  REQUIRE(uut.check_hit(champsim::address{0x1000}));
+
+  uut.fill(champsim::address{0x3000});
+  CHECK(uut.check_hit(champsim::address{0x1000}));
+  CHECK_FALSE(uut.check_hit(champsim::address{0x2000}));
+  CHECK(uut.check_hit(champsim::address{0x3000}));
+}
+
+TEST_CASE("A micro-op cache must have some capacity")
+{
+  CHECK_THROWS_AS((champsim::uop_cache{0, 8, 32, 6, 3, false}), std::invalid_argument);
+  CHECK_THROWS_AS((champsim::uop_cache{64, 8, 32, 0, 3, false}), std::invalid_argument);
+}
+
+SCENARIO("A core with a micro-op cache stalls when fetch switches between it and the decoders")
+{
+  GIVEN("A core whose micro-op cache holds one of two windows")
+  {
+    constexpr unsigned penalty = 2;
+    O3_CPU uut{champsim::core_builder{}
+                   .ifetch_buffer_size(8)
+                   .fetch_width(champsim::bandwidth::maximum_type{4})
+                   .uop_cache_set(8)
+                   .uop_cache_way(8)
+                   .uop_cache_switch_penalty(penalty)};
+    uut.begin_phase();
+
+    uut.UOP_CACHE->fill(champsim::address{0x1000});
+    uut.UOP_CACHE->fill(champsim::address{0x1004});
+
+    for (auto ip : {0x1000, 0x2000, 0x1004}) {
+      uut.IFETCH_BUFFER.push_back(champsim::test::instruction_with_ip(ip));
+    }
+
+    WHEN("The instructions are checked")
+    {
+      std::vector<long> checked{};
+      for (unsigned i = 0; i <= penalty; ++i) {
+        checked.push_back(uut.check_dib());
+        uut.current_time += uut.clock_period;
+      }
+
+      THEN("Each switch stalls the lookups that follow it")
+      {
+        REQUIRE(checked == std::vector<long>{2, 0, 1});
+        REQUIRE(uut.sim_stats.uop_cache_hits == 2);
+        REQUIRE(uut.sim_stats.uop_cache_misses == 1);
+        REQUIRE(uut.sim_stats.uop_cache_switches == 2);
+      }
+
+      THEN("Only the micro-op cache hits bypass the decoders")
+      {
+        REQUIRE(uut.IFETCH_BUFFER.at(0).decoded);
+        REQUIRE_FALSE(uut.IFETCH_BUFFER.at(1).decoded);
+        REQUIRE(uut.IFETCH_BUFFER.at(2).decoded);
+      }
+    }
+  }
+}
@@ -0,0 +1,108 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "instr.h"
+#include "ooo_cpu.h"
+#include "util/bits.h"
+
+namespace
+{
+constexpr uint64_t block_stride = 0x100;
+
+// Predicts the jump at the end of each block, to the next block
+struct chain_btb : champsim::modules::btb {
+  using btb::btb;
+
+  std::pair<champsim::address, bool> btb_prediction(champsim::address ip)
+  {
+    if (ip.to<uint64_t>() % block_stride == 4) {
+      return {ip + (block_stride - 4), true};
+    }
+    return {champsim::address{}, false};
+  }
+};
+} // namespace
+
+SCENARIO("The front end follows several taken branches in a cycle")
+{
+  auto taken_per_cycle = GENERATE(as<long>{}, 1, 2, 3);
+  GIVEN("A core with a stream of short blocks that each end in a taken jump")
+  {
+    // Nothing drains these queues
+    champsim::channel fetch_queues{32, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel data_queues{32, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel lower_queues{};
+    CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("156-l1i").lower_level(&lower_queues)};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&fetch_queues)
+                   .data_queues(&data_queues)
+                   .l1i(&l1i)
+                   .ifetch_buffer_size(32)
+                   .fetch_width(champsim::bandwidth::maximum_type{8})
+                   .ftq_size(8)
+                   .taken_branches_per_cycle(champsim::bandwidth::maximum_type{taken_per_cycle})
+                   .btb<::chain_btb>()};
+
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    for (uint64_t base = 0x10000; base < 0x10000 + 8 * block_stride; base += block_stride) {
+      uut.input_queue.push_back(champsim::test::instruction_with_ip(base));
+      uut.input_queue.push_back(champsim::test::branch_instruction_with_ip(base + 4));
+      uut.input_queue.back().branch = BRANCH_DIRECT_JUMP;
+      uut.input_queue.back().branch_target = champsim::address{base + block_stride};
+    }
+
+    WHEN("The core operates for one cycle")
+    {
+      uut._operate();
+
+      THEN("One block is predicted and fetched for each taken branch the front end may follow")
+      {
+        REQUIRE(std::size(uut.input_queue) == static_cast<std::size_t>(16 - 2 * taken_per_cycle));
+        REQUIRE(std::size(uut.IFETCH_BUFFER) == static_cast<std::size_t>(2 * taken_per_cycle));
+      }
+    }
+  }
+}
+
+SCENARIO("The front end reads a limited number of fetch blocks in a cycle")
+{
+  auto blocks_per_cycle = GENERATE(as<long>{}, 1, 2, 4);
+  GIVEN("A core with a stream of instructions in consecutive cache blocks")
+  {
+    // Nothing drains these queues
+    champsim::channel fetch_queues{32, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel data_queues{32, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel lower_queues{};
+    CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("156-l1i").lower_level(&lower_queues)};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&fetch_queues)
+                   .data_queues(&data_queues)
+                   .l1i(&l1i)
+                   .ifetch_buffer_size(32)
+                   .fetch_width(champsim::bandwidth::maximum_type{8})
+                   .ftq_size(8)
+                   .fetch_blocks_per_cycle(champsim::bandwidth::maximum_type{blocks_per_cycle})};
+
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    for (uint64_t i = 0; i < 16; ++i) {
+      uut.input_queue.push_back(champsim::test::instruction_with_ip(0x10000 + i * BLOCK_SIZE));
+    }
+
+    WHEN("The core operates for one cycle")
+    {
+      uut._operate();
+
+      THEN("Only the permitted number of blocks enter the fetch buffer")
+      {
+        REQUIRE(std::size(uut.IFETCH_BUFFER) == static_cast<std::size_t>(blocks_per_cycle));
+      }
+    }
+  }
+}
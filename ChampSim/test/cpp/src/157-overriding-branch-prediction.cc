@@ -0,0 +1,122 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "instr.h"
+#include "instruction.h"
+#include "ooo_cpu.h"
+
+namespace
+{
+// A BTB that knows the target of every branch, which jumps to itself
+struct self_btb : champsim::modules::btb {
+  using btb::btb;
+
+  std::pair<champsim::address, bool> btb_prediction(champsim::address ip) { return {ip, false}; }
+};
+
+template <bool Direction>
+struct constant_predictor : champsim::modules::branch_predictor {
+  using branch_predictor::branch_predictor;
+
+  bool predict_branch(champsim::address) { return Direction; }
+};
+
+using never_taken = constant_predictor<false>;
+using always_taken = constant_predictor<true>;
+} // namespace
+
+SCENARIO("A slow branch predictor that overrides a fast one stalls branch prediction")
+{
+  GIVEN("A core whose fast predictor disagrees with its slow predictor on a loop of one taken branch")
+  {
+    champsim::channel fetch_queues{};
+    champsim::channel data_queues{};
+    champsim::channel lower_queues{};
+    CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("157-l1i").lower_level(&lower_queues)};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&fetch_queues)
+                   .data_queues(&data_queues)
+                   .l1i(&l1i)
+                   .ifetch_buffer_size(64)
+                   .fetch_width(champsim::bandwidth::maximum_type{4})
+                   .ftq_size(64)
+                   .slow_predictor_latency(3)
+                   .branch_predictor<::never_taken, ::always_taken>()
+                   .btb<::self_btb>()};
+
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    for (int i = 0; i < 10; ++i) {
+      uut.input_queue.push_back(champsim::test::branch_instruction_with_ip(0x10000));
+      uut.input_queue.back().branch = BRANCH_CONDITIONAL;
+      uut.input_queue.back().branch_target = champsim::address{0x10000};
+    }
+
+    WHEN("The core operates for 8 cycles")
+    {
+      for (int i = 0; i < 8; ++i) {
+        uut._operate();
+      }
+
+      THEN("One branch is predicted every four cycles")
+      {
+        REQUIRE(std::size(uut.input_queue) == 8);
+        REQUIRE(uut.sim_stats.predictor_overrides == 2);
+        REQUIRE(uut.sim_stats.predictor_override_bubbles == 6);
+      }
+
+      THEN("The slow predictor gives the final prediction")
+      {
+        REQUIRE(uut.sim_stats.branch_type_misses.value_or(BRANCH_CONDITIONAL, 0) == 0);
+      }
+    }
+  }
+}
+
+SCENARIO("A slow branch predictor that agrees with the fast one does not stall branch prediction")
+{
+  GIVEN("A core whose fast and slow predictors agree on a loop of one taken branch")
+  {
+    champsim::channel fetch_queues{};
+    champsim::channel data_queues{};
+    champsim::channel lower_queues{};
+    CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("157-l1i").lower_level(&lower_queues)};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&fetch_queues)
+                   .data_queues(&data_queues)
+                   .l1i(&l1i)
+                   .ifetch_buffer_size(64)
+                   .fetch_width(champsim::bandwidth::maximum_type{4})
+                   .ftq_size(64)
+                   .slow_predictor_latency(3)
+                   .branch_predictor<::always_taken, ::always_taken>()
+                   .btb<::self_btb>()};
+
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    for (int i = 0; i < 10; ++i) {
+      uut.input_queue.push_back(champsim::test::branch_instruction_with_ip(0x10000));
+      uut.input_queue.back().branch = BRANCH_CONDITIONAL;
+      uut.input_queue.back().branch_target = champsim::address{0x10000};
+    }
+
+    WHEN("The core operates for 8 cycles")
+    {
+      for (int i = 0; i < 8; ++i) {
+        uut._operate();
+      }
+
+      THEN("One branch is predicted every cycle")
+      {
+        REQUIRE(std::size(uut.input_queue) == 2);
+        REQUIRE(uut.sim_stats.predictor_overrides == 0);
+        REQUIRE(uut.sim_stats.predictor_override_bubbles == 0);
+      }
+    }
+  }
+}
@@ -0,0 +1,79 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "instr.h"
+#include "instruction.h"
+#include "ooo_cpu.h"
+
+namespace
+{
+// A BTB that knows the target of every branch, which jumps to itself
+struct self_btb : champsim::modules::btb {
+  using btb::btb;
+
+  std::pair<champsim::address, bool> btb_prediction(champsim::address ip) { return {ip, false}; }
+};
+
+struct unsure_predictor : champsim::modules::branch_predictor {
+  using branch_predictor::branch_predictor;
+
+  bool predict_branch(champsim::address) { return true; }
+  champsim::branch_confidence prediction_confidence(champsim::address) { return champsim::branch_confidence::low; }
+};
+
+struct silent_predictor : champsim::modules::branch_predictor {
+  using branch_predictor::branch_predictor;
+
+  bool predict_branch(champsim::address) { return true; }
+};
+
+// Records the confidence of each branch it is told of
+struct confidence_recorder : champsim::modules::prefetcher {
+  using prefetcher::prefetcher;
+
+  static inline std::vector<champsim::branch_confidence> seen{};
+
+  uint32_t prefetcher_cache_operate(champsim::address, champsim::address, uint8_t, bool, access_type, uint32_t metadata_in) { return metadata_in; }
+  uint32_t prefetcher_cache_fill(champsim::address, long, long, uint8_t, champsim::address, uint32_t metadata_in) { return metadata_in; }
+  void prefetcher_branch_operate(champsim::address, uint8_t, champsim::address, champsim::branch_confidence confidence) { seen.push_back(confidence); }
+};
+
+template <typename Predictor>
+std::vector<champsim::branch_confidence> confidences_seen()
+{
+  ::confidence_recorder::seen.clear();
+
+  champsim::channel fetch_queues{};
+  champsim::channel data_queues{};
+  champsim::channel lower_queues{};
+  CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("158-l1i").lower_level(&lower_queues).prefetcher<::confidence_recorder>()};
+  O3_CPU uut{champsim::core_builder{}
+                 .fetch_queues(&fetch_queues)
+                 .data_queues(&data_queues)
+                 .l1i(&l1i)
+                 .template branch_predictor<Predictor>()
+                 .template btb<::self_btb>()};
+
+  uut.initialize();
+  uut.warmup = false;
+  uut.begin_phase();
+
+  uut.input_queue.push_back(champsim::test::branch_instruction_with_ip(0x10000));
+  uut.input_queue.back().branch = BRANCH_CONDITIONAL;
+  uut.input_queue.back().branch_target = champsim::address{0x10000};
+  uut._operate();
+
+  return ::confidence_recorder::seen;
+}
+} // namespace
+
+TEST_CASE("The L1I prefetcher is told the confidence of each branch prediction")
+{
+  REQUIRE(::confidences_seen<::unsure_predictor>() == std::vector{champsim::branch_confidence::low});
+}
+
+TEST_CASE("A branch predictor that does not estimate its confidence is taken to be confident")
+{
+  REQUIRE(::confidences_seen<::silent_predictor>() == std::vector{champsim::branch_confidence::high});
+}
@@ -0,0 +1,54 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "defaults.hpp"
+#include "instr.h"
+#include "ooo_cpu.h"
+#include "util/bits.h"
+
+SCENARIO("The core issues the code prefetches hinted at the instructions it fetches")
+{
+  auto take_fetch_slots = GENERATE(false, true);
+  GIVEN("A core with a hint at the first of a block of instructions")
+  {
+    // Nothing drains these queues
+    champsim::channel fetch_queues{32, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel data_queues{32, 32, 32, champsim::data::bits{champsim::lg2(BLOCK_SIZE)}, false};
+    champsim::channel lower_queues{};
+    CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("159-l1i").lower_level(&lower_queues)};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&fetch_queues)
+                   .data_queues(&data_queues)
+                   .l1i(&l1i)
+                   .ifetch_buffer_size(32)
+                   .fetch_width(champsim::bandwidth::maximum_type{8})};
+
+    uut.prefetch_hints.add(0x10000, 0xdead0000);
+    uut.prefetch_hints.add(0x10000, 0xbeef0000);
+    uut.prefetch_hints_take_fetch_slots = take_fetch_slots;
+
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    for (uint64_t ip = 0x10000; ip < 0x10000 + 8 * 4; ip += 4) {
+      uut.input_queue.push_back(champsim::test::instruction_with_ip(ip));
+    }
+
+    WHEN("The core operates for one cycle")
+    {
+      uut._operate();
+
+      THEN("The L1I is asked to prefetch each target of the hint")
+      {
+        REQUIRE(uut.sim_stats.prefetch_hints_issued == 2);
+        REQUIRE(l1i.sim_stats.pf_issued == 2);
+      }
+
+      THEN("The prefetches take fetch slots only if they are charged")
+      {
+        REQUIRE(std::size(uut.IFETCH_BUFFER) == (take_fetch_slots ? 6 : 8));
+      }
+    }
+  }
+}
@@ -0,0 +1,111 @@
+#include <catch.hpp>
+
+#include "../../../btb/basic_btb/basic_btb.h"
+#include "../../../btb/basic_btb/predecoder.h"
+#include "cache.h"
+#include "defaults.hpp"
+#include "instruction.h"
+#include "ooo_cpu.h"
+
+SCENARIO("The predecoder fills its buffer from the branches of blocks that the L1I fills")
+{
+  GIVEN("A predecoder attached to a core with a branch that it has seen before")
+  {
+    champsim::channel fetch_queues{};
+    champsim::channel data_queues{};
+    champsim::channel lower_queues{};
+    CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("167-l1i").lower_level(&lower_queues)};
+    O3_CPU cpu{champsim::core_builder{}.fetch_queues(&fetch_queues).data_queues(&data_queues).l1i(&l1i)};
+    cpu.initialize();
+
+    predecoder uut{1, 32};
+    uut.attach(&cpu);
+
+    const champsim::address branch_ip{0x10010};
+    const champsim::address branch_target{0x20000};
+    const champsim::address not_taken_ip{0x10020};
+    cpu.code_map.record(branch_ip, BRANCH_DIRECT_JUMP, branch_target, true);
+    cpu.code_map.record(not_taken_ip, BRANCH_CONDITIONAL, champsim::address{}, false);
+
+    THEN("The core keeps its code map for the predecoder")
+    {
+      REQUIRE(cpu.record_code_map);
+      REQUIRE(std::size(l1i.fill_observers) == 1);
+    }
+
+    WHEN("The BTB misses on the branch")
+    {
+      uut.miss(branch_ip);
+
+      THEN("The block is prefetched into the L1I")
+      {
+        REQUIRE(l1i.sim_stats.pf_issued == 1);
+      }
+    }
+
+    WHEN("The BTB misses on a branch that has never been taken")
+    {
+      uut.miss(not_taken_ip);
+
+      THEN("Nothing is prefetched")
+      {
+        REQUIRE(l1i.sim_stats.pf_issued == 0);
+      }
+    }
+
+    WHEN("The L1I fills the block that holds the branch")
+    {
+      for (const auto& observer : l1i.fill_observers) {
+        observer(champsim::address{0x10000});
+      }
+
+      THEN("The branch is taken from the buffer with its predecoded target")
+      {
+        REQUIRE(uut.peek(branch_ip).has_value());
+        auto entry = uut.take(branch_ip);
+        REQUIRE(entry.has_value());
+        REQUIRE(entry->target == branch_target);
+        REQUIRE(entry->type == direct_predictor::branch_info::ALWAYS_TAKEN);
+        REQUIRE_FALSE(uut.take(branch_ip).has_value());
+      }
+
+      THEN("The branch that has never been taken is not in the buffer")
+      {
+        REQUIRE_FALSE(uut.take(not_taken_ip).has_value());
+      }
+    }
+  }
+}
+
+SCENARIO("The basic_btb does not prefill by default")
+{
+  GIVEN("A core with a basic_btb and a branch that it has seen before")
+  {
+    champsim::channel fetch_queues{};
+    champsim::channel data_queues{};
+    champsim::channel lower_queues{};
+    CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("167-l1i").lower_level(&lower_queues)};
+    O3_CPU uut{champsim::core_builder{}.fetch_queues(&fetch_queues).data_queues(&data_queues).l1i(&l1i).btb<basic_btb>()};
+    uut.initialize();
+
+    const champsim::address branch_ip{0x10010};
+    uut.code_map.record(branch_ip, BRANCH_DIRECT_JUMP, champsim::address{0x20000}, true);
+
+    THEN("The core does not keep its code map for the BTB")
+    {
+      REQUIRE_FALSE(uut.record_code_map);
+      REQUIRE(std::empty(l1i.fill_observers));
+    }
+
+    WHEN("The BTB misses on the branch")
+    {
+      auto [predicted_target, always_taken] = uut.impl_btb_prediction(branch_ip, BRANCH_DIRECT_JUMP);
+
+      THEN("There is no prediction, and nothing is prefetched")
+      {
+        REQUIRE(predicted_target == champsim::address{});
+        REQUIRE(l1i.sim_stats.pf_issued == 0);
+      }
+    }
+  }
+}
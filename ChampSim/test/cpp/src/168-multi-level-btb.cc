@@ -0,0 +1,141 @@
+#include <catch.hpp>
+
+#include <algorithm>
+
+#include "../../../btb/basic_btb/direct_predictor.h"
+#include "cache.h"
+#include "defaults.hpp"
+#include "instr.h"
+#include "instruction.h"
+#include "ooo_cpu.h"
+#include "stats_printer.h"
+
+TEST_CASE("A multi-level BTB finds evicted entries in its lower level")
+{
+  // One fully-associative entry backed by a larger level
+  direct_predictor uut{{{1, 1, 0}, {4, 4, 2}}};
+  REQUIRE(uut.num_levels() == 2);
+
+  const champsim::address first_ip{0x1000};
+  const champsim::address second_ip{0x2000};
+  uut.update(first_ip, champsim::address{0x1100}, BRANCH_DIRECT_JUMP);
+  uut.update(second_ip, champsim::address{0x2100}, BRANCH_DIRECT_JUMP);
+
+  auto second = uut.lookup(second_ip);
+  CHECK(second.entry.has_value());
+  CHECK(second.level == 0);
+  CHECK(second.latency == 0);
+
+  auto first = uut.lookup(first_ip);
+  REQUIRE(first.entry.has_value());
+  CHECK(first.entry->target == champsim::address{0x1100});
+  CHECK(first.level == 1);
+  CHECK(first.latency == 2);
+
+  // The hit was copied up
+  CHECK(uut.lookup(first_ip).level == 0);
+
+  auto miss = uut.lookup(champsim::address{0x3000});
+  CHECK_FALSE(miss.entry.has_value());
+  CHECK(miss.level == 2);
+}
+
+TEST_CASE("A multi-level BTB without levels is rejected")
+{
+  REQUIRE_THROWS_AS(direct_predictor{std::vector<direct_predictor::level_type>{}}, std::invalid_argument);
+}
+
+TEST_CASE("A multi-level BTB with bulk transfer brings up the region of a miss")
+{
+  direct_predictor uut{{{1, 2, 0}, {4, 4, 2}}, 64};
+
+  uut.update(champsim::address{0x1000}, champsim::address{0x1100}, BRANCH_DIRECT_JUMP);
+  uut.update(champsim::address{0x1010}, champsim::address{0x1200}, BRANCH_DIRECT_JUMP);
+  uut.update(champsim::address{0x2000}, champsim::address{0x2100}, BRANCH_DIRECT_JUMP);
+  uut.update(champsim::address{0x2010}, champsim::address{0x2200}, BRANCH_DIRECT_JUMP);
+
+  // Both of the first region's branches have been evicted from the first level
+  CHECK(uut.lookup(champsim::address{0x1000}).level == 1);
+  CHECK(uut.lookup(champsim::address{0x1010}).level == 0);
+}
+
+namespace
+{
+// A BTB whose every prediction comes from a slow second level
+struct slow_btb : champsim::modules::btb {
+  using btb::btb;
+
+  std::pair<champsim::address, bool> btb_prediction(champsim::address ip)
+  {
+    intern_->last_btb_lookup = {2, 1, 3};
+    return {ip, true};
+  }
+};
+} // namespace
+
+SCENARIO("Taken branches predicted by a slow BTB level stall branch prediction")
+{
+  GIVEN("A core with a slow BTB and a loop of one taken branch")
+  {
+    champsim::channel fetch_queues{};
+    champsim::channel data_queues{};
+    champsim::channel lower_queues{};
+    CACHE l1i{champsim::cache_builder{champsim::defaults::default_l1i}.name("168-l1i").lower_level(&lower_queues)};
+    O3_CPU uut{champsim::core_builder{}
+                   .fetch_queues(&fetch_queues)
+                   .data_queues(&data_queues)
+                   .l1i(&l1i)
+                   .ifetch_buffer_size(64)
+                   .fetch_width(champsim::bandwidth::maximum_type{4})
+                   .ftq_size(64)
+                   .btb<::slow_btb>()};
+
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    for (int i = 0; i < 10; ++i) {
+      uut.input_queue.push_back(champsim::test::branch_instruction_with_ip(0x10000));
+      uut.input_queue.back().branch = BRANCH_DIRECT_JUMP;
+      uut.input_queue.back().branch_target = champsim::address{0x10000};
+    }
+
+    WHEN("The core operates for 8 cycles")
+    {
+      for (int i = 0; i < 8; ++i) {
+        uut._operate();
+      }
+
+      THEN("One branch is predicted every four cycles")
+      {
+        REQUIRE(std::size(uut.input_queue) == 8);
+        REQUIRE(uut.sim_stats.btb_redirect_bubbles == 6);
+      }
+
+      THEN("The hits and misses are recorded for each level")
+      {
+        REQUIRE(uut.sim_stats.btb_level_misses.value_or(0, 0) == 2);
+        REQUIRE(uut.sim_stats.btb_level_hits.value_or(0, 0) == 0);
+        REQUIRE(uut.sim_stats.btb_level_hits.value_or(1, 0) == 2);
+        REQUIRE(uut.sim_stats.btb_levels == 2);
+      }
+    }
+  }
+}
+
+TEST_CASE("The BTB levels are printed only for a BTB of several levels")
+{
+  auto levels = GENERATE(as<std::size_t>{}, 0, 1, 2);
+  cpu_stats given{};
+  given.name = "test_cpu";
+  given.btb_levels = levels;
+  for (std::size_t level = 0; level < levels; ++level) {
+    given.btb_level_misses.increment(level);
+  }
+
+  auto lines = champsim::plain_printer::format(given);
+  auto printed_levels = std::count_if(std::begin(lines), std::end(lines), [](const auto& line) { return line.find("BTB level") != std::string::npos; });
+  auto printed_bubbles = std::count_if(std::begin(lines), std::end(lines), [](const auto& line) { return line.find("BTB redirect") != std::string::npos; });
+  REQUIRE(printed_levels == (levels > 1 ? static_cast<long>(levels) : 0));
+  REQUIRE(printed_bubbles == (levels > 1 ? 1 : 0));
+}
@@ -0,0 +1,112 @@
+#include <catch.hpp>
+
+#include "../../../btb/basic_btb/basic_btb.h"
+#include "../../../btb/ittage/ittage.h"
+#include "instruction.h"
+#include "ooo_cpu.h"
+
+namespace
+{
+// Four targets of one indirect branch, visited in turn, as in a dispatch loop
+constexpr std::array<uint64_t, 4> cyclic_targets{0x3000, 0x3004, 0x3008, 0x300c};
+} // namespace
+
+TEST_CASE("ITTAGE does not predict branches that are not indirect")
+{
+  ittage uut{};
+  uut.initialize_btb();
+
+  champsim::address ip{0x2000};
+  for (int i = 0; i < 10; ++i) {
+    uut.update_btb(ip, champsim::address{0x3000}, true, BRANCH_DIRECT_JUMP);
+  }
+
+  REQUIRE(uut.btb_prediction(ip, BRANCH_DIRECT_JUMP).first == champsim::address{});
+}
+
+TEST_CASE("ITTAGE learns an indirect target that depends on the direction of an earlier branch")
+{
+  ittage uut{};
+  uut.initialize_btb();
+
+  champsim::address conditional_ip{0x1000};
+  champsim::address indirect_ip{0x2000};
+  uint64_t lcg = 1;
+  auto run = [&](std::size_t count) {
+    std::size_t mispredictions = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      lcg = lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+      bool direction = ((lcg >> 33) & 1) != 0;
+      champsim::address target{direction ? uint64_t{0x3000} : uint64_t{0x4000}};
+
+      uut.update_btb(conditional_ip, champsim::address{0x1100}, direction, BRANCH_CONDITIONAL);
+      mispredictions += (uut.btb_prediction(indirect_ip, BRANCH_INDIRECT).first != target) ? 1 : 0;
+      uut.update_btb(indirect_ip, target, true, BRANCH_INDIRECT);
+    }
+    return mispredictions;
+  };
+
+  run(2000);
+  REQUIRE(run(200) == 0);
+  CHECK(uut.stats.provider_predictions > 0);
+}
+
+TEST_CASE("ITTAGE learns a sequence of targets from the path history")
+{
+  ittage uut{};
+  uut.initialize_btb();
+
+  champsim::address indirect_ip{0x2000};
+  auto run = [&](std::size_t count) {
+    std::size_t mispredictions = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      champsim::address target{cyclic_targets.at(i % std::size(cyclic_targets))};
+      mispredictions += (uut.btb_prediction(indirect_ip, BRANCH_INDIRECT_CALL).first != target) ? 1 : 0;
+      uut.update_btb(indirect_ip, target, true, BRANCH_INDIRECT_CALL);
+    }
+    return mispredictions;
+  };
+
+  run(400);
+  REQUIRE(run(100) == 0);
+}
+
+SCENARIO("ITTAGE overrides another BTB for indirect branches")
+{
+  GIVEN("A core with a basic_btb followed by ITTAGE")
+  {
+    champsim::channel fetch_queues{};
+    champsim::channel data_queues{};
+    O3_CPU uut{champsim::core_builder{}.fetch_queues(&fetch_queues).data_queues(&data_queues).btb<basic_btb, ittage>()};
+    uut.initialize();
+
+    const champsim::address jump_ip{0x1000};
+    const champsim::address jump_target{0x2000};
+    const champsim::address indirect_ip{0x2000};
+
+    WHEN("The core resolves a direct jump and a sequence of indirect targets")
+    {
+      std::size_t mispredictions = 0;
+      for (std::size_t i = 0; i < 500; ++i) {
+        champsim::address target{cyclic_targets.at(i % std::size(cyclic_targets))};
+        if (i >= 400 && uut.impl_btb_prediction(indirect_ip, BRANCH_INDIRECT).first != target) {
+          ++mispredictions;
+        }
+        uut.impl_update_btb(indirect_ip, target, true, BRANCH_INDIRECT);
+        uut.impl_update_btb(jump_ip, jump_target, true, BRANCH_DIRECT_JUMP);
+      }
+
+      THEN("The indirect targets are predicted by ITTAGE")
+      {
+        REQUIRE(mispredictions == 0);
+      }
+
+      THEN("The direct jump is predicted by the basic_btb")
+      {
+        auto [target, always_taken] = uut.impl_btb_prediction(jump_ip, BRANCH_DIRECT_JUMP);
+        REQUIRE(target == jump_target);
+        REQUIRE(always_taken);
+      }
+    }
+  }
+}
@@ -0,0 +1,137 @@
+#include <catch.hpp>
+
+#include "../../../branch/tage_sc_l/tage_sc_l.h"
+#include "instruction.h"
+#include "msl/tage_hashing.h"
+#include "ooo_cpu.h"
+
+namespace
+{
+// Predict and resolve one conditional branch, returning whether it was mispredicted
+bool resolve(tage_sc_l& uut, champsim::address ip, bool taken)
+{
+  auto prediction = uut.predict_branch(ip);
+  uut.last_branch_result(ip, champsim::address{}, taken, BRANCH_CONDITIONAL);
+  return prediction != taken;
+}
+} // namespace
+
+TEST_CASE("A TAGE folded history is the XOR of the chunks of its history")
+{
+  auto [length, width] = GENERATE(table<unsigned, unsigned>({{4, 10}, {10, 10}, {27, 10}, {640, 13}, {640, 12}}));
+  champsim::msl::tage::folded_history uut{length, width};
+  std::vector<bool> history{}; // newest first
+
+  uint64_t lfsr = 0xace1;
+  for (int i = 0; i < 2000; ++i) {
+    lfsr = (lfsr >> 1) ^ (-(lfsr & 1) & 0xb400);
+    bool bit = (lfsr & 1) != 0;
+    uut.push_back(bit);
+    history.insert(std::begin(history), bit);
+    if (std::size(history) > length) {
+      history.pop_back();
+    }
+  }
+
+  uint64_t expected = 0;
+  for (std::size_t i = 0; i < std::size(history); ++i) {
+    expected ^= uint64_t{history.at(i) ? 1u : 0u} << (i % width);
+  }
+  REQUIRE(uut.value() == expected);
+}
+
+TEST_CASE("TAGE-SC-L fits in the storage budget of the core")
+{
+  auto budget = GENERATE(as<std::size_t>{}, 8 * 1024, 32 * 1024, 64 * 1024, 256 * 1024);
+  O3_CPU cpu{champsim::core_builder{}.branch_predictor_budget(budget)};
+  tage_sc_l uut{&cpu};
+  uut.initialize_branch_predictor();
+
+  CHECK(tage_sc_l::storage_bits(uut.geometry) <= 8 * budget);
+  CHECK(std::size(uut.bimodal) == (std::size_t{1} << uut.geometry.bimodal_log_entries));
+  for (const auto& table : uut.tagged) {
+    CHECK(std::size(table) == (std::size_t{1} << uut.geometry.tagged_log_entries));
+  }
+}
+
+TEST_CASE("TAGE-SC-L grows with the storage budget")
+{
+  auto small = tage_sc_l::geometry_for(16 * 1024);
+  auto large = tage_sc_l::geometry_for(64 * 1024);
+
+  REQUIRE(large.tagged_log_entries > small.tagged_log_entries);
+  REQUIRE(large.bimodal_log_entries > small.bimodal_log_entries);
+}
+
+TEST_CASE("TAGE-SC-L rejects a storage budget that cannot hold its fixed structures")
+{
+  REQUIRE_THROWS_AS(tage_sc_l::geometry_for(64), std::invalid_argument);
+}
+
+TEST_CASE("TAGE-SC-L uses the default budget when the core does not give one")
+{
+  O3_CPU cpu{champsim::core_builder{}};
+  tage_sc_l uut{&cpu};
+  uut.initialize_branch_predictor();
+
+  REQUIRE(uut.geometry.tagged_log_entries == tage_sc_l::geometry_for(tage_sc_l::DEFAULT_BUDGET).tagged_log_entries);
+}
+
+TEST_CASE("The history lengths of TAGE-SC-L grow geometrically")
+{
+  auto lengths = tage_sc_l::history_lengths();
+
+  CHECK(lengths.front() == tage_sc_l::MIN_HISTORY);
+  CHECK(lengths.back() == tage_sc_l::MAX_HISTORY);
+  CHECK(std::is_sorted(std::begin(lengths), std::end(lengths)));
+}
+
+TEST_CASE("TAGE-SC-L learns a pattern that depends on global history")
+{
+  O3_CPU cpu{champsim::core_builder{}};
+  tage_sc_l uut{&cpu};
+  uut.initialize_branch_predictor();
+
+  // One branch alternates, and the other repeats the direction of the first
+  champsim::address first{0x401000};
+  champsim::address second{0x401040};
+  auto train = [&](std::size_t count) {
+    std::size_t mispredictions = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+      bool direction = (i % 2) == 0;
+      mispredictions += resolve(uut, first, direction) ? 1 : 0;
+      mispredictions += resolve(uut, second, direction) ? 1 : 0;
+    }
+    return mispredictions;
+  };
+
+  train(1000);
+  REQUIRE(train(100) == 0);
+  CHECK(uut.stats.provider_predictions > 0);
+}
+
+TEST_CASE("TAGE-SC-L predicts the exit of a loop with a constant trip count")
+{
+  O3_CPU cpu{champsim::core_builder{}};
+  tage_sc_l uut{&cpu};
+  uut.initialize_branch_predictor();
+
+  // The trip count is longer than the history of the tagged tables, so only the loop predictor can foresee the exit
+  constexpr std::size_t trip_count = 700;
+  champsim::address loop_branch{0x402000};
+  auto run_loop = [&]() {
+    std::size_t mispredictions = 0;
+    for (std::size_t i = 0; i < trip_count; ++i) {
+      mispredictions += resolve(uut, loop_branch, i + 1 < trip_count) ? 1 : 0;
+    }
+    return mispredictions;
+  };
+
+  for (int i = 0; i < 10; ++i) {
+    run_loop();
+  }
+
+  auto loop_predictions_before = uut.stats.loop_predictions;
+  REQUIRE(run_loop() == 0);
+  CHECK(uut.stats.loop_predictions > loop_predictions_before);
+}
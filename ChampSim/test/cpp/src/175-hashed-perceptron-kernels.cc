@@ -0,0 +1,89 @@
+#include <catch.hpp>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "../../../branch/hashed_perceptron/hashed_perceptron.h"
+#include "instruction.h"
+
+namespace
+{
+// Drive a predictor with a branch stream that mixes biased, patterned, and random branches
+template <typename F>
+void run_branch_stream(std::size_t length, F&& func)
+{
+  std::mt19937_64 rng{0x5eed};
+  std::bernoulli_distribution coin{0.5};
+  std::uniform_int_distribution<uint64_t> ip_dist{0, 63};
+  for (std::size_t i = 0; i < length; ++i) {
+    auto ip_index = ip_dist(rng);
+    champsim::address ip{0x400000 + 0x40 * ip_index};
+    bool taken = (ip_index % 4 == 0) ? coin(rng) : (ip_index % 4 == 1) ? (i % 3 != 0) : (ip_index % 2 == 0);
+    func(ip, taken);
+  }
+}
+
+// The kernels that this build of the predictor contains
+#ifdef HASHED_PERCEPTRON_AVX2_KERNEL
+const std::vector<hashed_perceptron::kernel> built_kernels{hashed_perceptron::kernel::scalar, hashed_perceptron::kernel::avx2};
+#else
+const std::vector<hashed_perceptron::kernel> built_kernels{hashed_perceptron::kernel::scalar};
+#endif
+} // namespace
+
+TEST_CASE("The scalar hashed perceptron kernel is always supported")
+{
+  REQUIRE(hashed_perceptron::kernel_supported(hashed_perceptron::kernel::scalar));
+  REQUIRE(hashed_perceptron::kernel_supported(hashed_perceptron::default_kernel()));
+}
+
+#ifdef HASHED_PERCEPTRON_AVX2_KERNEL
+TEST_CASE("The hashed perceptron kernels make bit-identical predictions")
+{
+  // The kernel is built for every x86 host, but only some of them can run it
+  if (!hashed_perceptron::kernel_supported(hashed_perceptron::kernel::avx2)) {
+    WARN("This host does not support AVX2, so the AVX2 kernel is not compared");
+    return;
+  }
+
+  hashed_perceptron scalar_uut{nullptr};
+  hashed_perceptron avx2_uut{nullptr};
+  scalar_uut.select_kernel(hashed_perceptron::kernel::scalar);
+  avx2_uut.select_kernel(hashed_perceptron::kernel::avx2);
+
+  std::size_t mismatches = 0;
+  run_branch_stream(200000, [&](champsim::address ip, bool taken) {
+    if (scalar_uut.predict_branch(ip) != avx2_uut.predict_branch(ip)) {
+      ++mismatches;
+    }
+    scalar_uut.last_branch_result(ip, champsim::address{}, taken, BRANCH_CONDITIONAL);
+    avx2_uut.last_branch_result(ip, champsim::address{}, taken, BRANCH_CONDITIONAL);
+  });
+
+  REQUIRE(mismatches == 0);
+}
+#endif
+
+TEST_CASE("The hashed perceptron kernels saturate their weights")
+{
+  auto K = GENERATE(from_range(built_kernels));
+  if (!hashed_perceptron::kernel_supported(K)) {
+    WARN("This host does not support the kernel, so it is not tested");
+    return;
+  }
+
+  auto weights = std::make_unique<hashed_perceptron::weight_array_type>();
+  hashed_perceptron::index_array_type folded{};
+  hashed_perceptron::index_array_type indices{};
+
+  for (int i = 0; i < 300; ++i) {
+    hashed_perceptron::predict_kernel(K, *weights, folded, 0x5, indices);
+    hashed_perceptron::train_kernel(K, *weights, indices, true);
+  }
+  REQUIRE(hashed_perceptron::predict_kernel(K, *weights, folded, 0x5, indices) == 16 * 127);
+
+  for (int i = 0; i < 300; ++i) {
+    hashed_perceptron::train_kernel(K, *weights, indices, false);
+  }
+  REQUIRE(hashed_perceptron::predict_kernel(K, *weights, folded, 0x5, indices) == 16 * -128);
+}
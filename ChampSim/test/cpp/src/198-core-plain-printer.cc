@@ -101,3 +101,50 @@ TEST_CASE("The ROB occupancy modifies the flush penalty")
 
   REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
 }
+
+TEST_CASE("A BTB that reports its levels prints hits and misses for each level")
+{
+  cpu_stats given{};
+  given.name = "test_cpu";
+  given.btb_level_hits.set(0, 90);
+  given.btb_level_misses.set(0, 10);
+  given.btb_level_hits.set(1, 6);
+  given.btb_level_misses.set(1, 4);
+  given.btb_redirect_bubbles = 12;
+
+  std::vector<std::string> expected{"test_cpu cumulative IPC: - instructions: 0 cycles: 0",
+                                    "test_cpu Branch Prediction Accuracy: -% MPKI: - Average ROB Occupancy at Mispredict: -",
+                                    "test_cpu BTB level 1 HIT:         90 MISS:         10",
+                                    "test_cpu BTB level 2 HIT:          6 MISS:          4",
+                                    "test_cpu BTB redirect bubbles: 12 cycles",
+                                    "Branch type MPKI",
+                                    "BRANCH_DIRECT_JUMP: -",
+                                    "BRANCH_INDIRECT: -",
+                                    "BRANCH_CONDITIONAL: -",
+                                    "BRANCH_DIRECT_CALL: -",
+                                    "BRANCH_INDIRECT_CALL: -",
+                                    "BRANCH_RETURN: -"};
+
+  REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
+}
+
+TEST_CASE("A core with an overriding branch predictor prints its overrides and bubbles")
+{
+  cpu_stats given{};
+  given.name = "test_cpu";
+  given.predictor_overrides = 4;
+  given.predictor_override_bubbles = 12;
+
+  std::vector<std::string> expected{"test_cpu cumulative IPC: - instructions: 0 cycles: 0",
+                                    "test_cpu Branch Prediction Accuracy: -% MPKI: - Average ROB Occupancy at Mispredict: -",
+                                    "test_cpu Branch predictor overrides: 4 bubbles: 12 cycles",
+                                    "Branch type MPKI",
+                                    "BRANCH_DIRECT_JUMP: -",
+                                    "BRANCH_INDIRECT: -",
+                                    "BRANCH_CONDITIONAL: -",
+                                    "BRANCH_DIRECT_CALL: -",
+                                    "BRANCH_INDIRECT_CALL: -",
+                                    "BRANCH_RETURN: -"};
+
+  REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
+}
@@ -0,0 +1,32 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "channel.h"
+#include "defaults.hpp"
+
+SCENARIO("A cache copies its statistics into the region of interest at the end of a phase")
+{
+  GIVEN("A cache that has counted wrong-path fills")
+  {
+    champsim::channel upper_queues{};
+    champsim::channel lower_queues{};
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1i}.name("409-uut").upper_levels({&upper_queues}).lower_level(&lower_queues)};
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    uut.sim_stats.wrong_path_fill = 5;
+    uut.sim_stats.wrong_path_useful = 3;
+
+    WHEN("The phase ends")
+    {
+      uut.end_phase(0);
+
+      THEN("The region of interest holds the wrong-path counts")
+      {
+        REQUIRE(uut.roi_stats.wrong_path_fill == 5);
+        REQUIRE(uut.roi_stats.wrong_path_useful == 3);
+      }
+    }
+  }
+}
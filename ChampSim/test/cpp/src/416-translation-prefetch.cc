@@ -0,0 +1,117 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "channel.h"
+#include "defaults.hpp"
+
+namespace
+{
+constexpr uint64_t prefetch_page_addr = 0xdead'b000;
+
+auto count_requests_for_page(const champsim::channel& queues, champsim::address addr)
+{
+  return std::count_if(std::begin(queues.RQ), std::end(queues.RQ),
+                       [page = champsim::page_number{addr}](const auto& pkt) { return champsim::page_number{pkt.v_address} == page; });
+}
+} // namespace
+
+SCENARIO("A cache with translation prefetching translates the page of a prefetch as soon as it is issued")
+{
+  GIVEN("An instruction cache that prefetches translations")
+  {
+    champsim::channel upper_queues{};
+    champsim::channel lower_queues{};
+    champsim::channel translate_queues{};
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1i}
+                  .name("416-uut")
+                  .upper_levels({&upper_queues})
+                  .lower_level(&lower_queues)
+                  .lower_translate(&translate_queues)
+                  .set_translation_prefetch()};
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    WHEN("Two prefetches into a new page are issued")
+    {
+      uut.prefetch_line(champsim::address{prefetch_page_addr + 0x40}, true, 0);
+      uut.prefetch_line(champsim::address{prefetch_page_addr + 0x80}, true, 0);
+
+      THEN("One translation is requested before the prefetches reach the tag check")
+      {
+        REQUIRE(count_requests_for_page(translate_queues, champsim::address{prefetch_page_addr}) == 1);
+        REQUIRE(uut.sim_stats.translation_pf_issued == 1);
+      }
+
+      for (int i = 0; i < 20; ++i) {
+        uut._operate();
+      }
+
+      THEN("The prefetches wait for that translation rather than requesting their own")
+      {
+        REQUIRE(count_requests_for_page(translate_queues, champsim::address{prefetch_page_addr}) == 1);
+      }
+
+      AND_WHEN("The translation returns and a demand access touches the page")
+      {
+        translate_queues.RQ.clear();
+        translate_queues.returned.emplace_back(champsim::address{prefetch_page_addr}, champsim::address{prefetch_page_addr},
+                                               champsim::address{0x1111'1000}, 0, std::vector<uint64_t>{});
+
+        champsim::channel::request_type demand;
+        demand.address = champsim::address{prefetch_page_addr + 0xc0};
+        demand.v_address = champsim::address{prefetch_page_addr + 0xc0};
+        demand.is_translated = false;
+        demand.cpu = 0;
+        upper_queues.add_rq(demand);
+
+        for (int i = 0; i < 20; ++i) {
+          uut._operate();
+        }
+
+        THEN("The prefetches are translated")
+        {
+          auto is_translated = [page = champsim::page_number{champsim::address{0x1111'1000}}](const auto& pkt) {
+            return champsim::page_number{pkt.address} == page;
+          };
+          REQUIRE(std::count_if(std::begin(lower_queues.PQ), std::end(lower_queues.PQ), is_translated) == 2);
+        }
+
+        THEN("The translation prefetch is counted as useful")
+        {
+          REQUIRE(uut.sim_stats.translation_pf_useful == 1);
+        }
+      }
+    }
+  }
+}
+
+SCENARIO("A cache without translation prefetching translates a prefetch at its tag check")
+{
+  GIVEN("An instruction cache that does not prefetch translations")
+  {
+    champsim::channel upper_queues{};
+    champsim::channel lower_queues{};
+    champsim::channel translate_queues{};
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1i}
+                  .name("416-uut")
+                  .upper_levels({&upper_queues})
+                  .lower_level(&lower_queues)
+                  .lower_translate(&translate_queues)
+                  .reset_translation_prefetch()};
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    WHEN("A prefetch into a new page is issued")
+    {
+      uut.prefetch_line(champsim::address{prefetch_page_addr + 0x40}, true, 0);
+
+      THEN("No translation is requested before the prefetch reaches the tag check")
+      {
+        REQUIRE(std::empty(translate_queues.RQ));
+        REQUIRE(uut.sim_stats.translation_pf_issued == 0);
+      }
+    }
+  }
+}
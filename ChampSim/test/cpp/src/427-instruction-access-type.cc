@@ -0,0 +1,84 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "channel.h"
+#include "defaults.hpp"
+
+SCENARIO("An instruction fetch miss is forwarded as an instruction fetch")
+{
+  GIVEN("A second-level cache")
+  {
+    champsim::channel upper_queues{};
+    champsim::channel lower_queues{};
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}.name("427-uut").upper_levels({&upper_queues}).lower_level(&lower_queues)};
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    WHEN("An instruction fetch misses")
+    {
+      champsim::channel::request_type fetch;
+      fetch.address = champsim::address{0xdeadbe40};
+      fetch.v_address = champsim::address{0xdeadbe40};
+      fetch.type = access_type::IFETCH;
+      fetch.is_instruction = true;
+      fetch.cpu = 0;
+      upper_queues.add_rq(fetch);
+
+      for (int i = 0; i < 20; ++i) {
+        uut._operate();
+      }
+
+      THEN("The miss is counted as an instruction fetch")
+      {
+        REQUIRE(uut.sim_stats.misses.value_or(std::pair{access_type::IFETCH, 0u}, 0) == 1);
+        REQUIRE(uut.sim_stats.misses.value_or(std::pair{access_type::LOAD, 0u}, 0) == 0);
+      }
+
+      THEN("The lower level sees an instruction fetch")
+      {
+        REQUIRE(std::size(lower_queues.RQ) == 1);
+        REQUIRE(lower_queues.RQ.front().type == access_type::IFETCH);
+      }
+    }
+  }
+}
+
+SCENARIO("Prefetches from an instruction cache are marked as instruction prefetches")
+{
+  auto instruction_prefetch = GENERATE(true, false);
+  GIVEN("A first-level cache whose prefetches " + std::string{instruction_prefetch ? "fetch instructions" : "fetch data"})
+  {
+    champsim::channel upper_queues{};
+    champsim::channel lower_queues{};
+    auto builder = champsim::cache_builder{champsim::defaults::default_l1i}
+                       .name("427-uut")
+                       .upper_levels({&upper_queues})
+                       .lower_level(&lower_queues)
+                       .reset_virtual_prefetch();
+    if (instruction_prefetch) {
+      builder.set_instruction_prefetch();
+    } else {
+      builder.reset_instruction_prefetch();
+    }
+    CACHE uut{builder};
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    WHEN("A prefetch misses")
+    {
+      uut.prefetch_line(champsim::address{0xdeadbe40}, true, 0);
+      for (int i = 0; i < 20; ++i) {
+        uut._operate();
+      }
+
+      THEN("The prefetch is forwarded with its origin")
+      {
+        REQUIRE(std::size(lower_queues.PQ) == 1);
+        REQUIRE(lower_queues.PQ.front().type == access_type::PREFETCH);
+        REQUIRE(lower_queues.PQ.front().is_instruction == instruction_prefetch);
+      }
+    }
+  }
+}
@@ -0,0 +1,95 @@
+#include <catch.hpp>
+
+#include "cache.h"
+#include "channel.h"
+#include "defaults.hpp"
+#include "hotspot_counter.h"
+
+SCENARIO("A cache reports the instructions and blocks with the most demand misses")
+{
+  GIVEN("A cache that reports hotspots")
+  {
+    champsim::hotspot_report_size = 4;
+    champsim::channel upper_queues{};
+    champsim::channel lower_queues{};
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l1d}
+                  .name("428-uut")
+                  .upper_levels({&upper_queues})
+                  .lower_level(&lower_queues)
+                  .reset_virtual_prefetch()};
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+    champsim::hotspot_report_size = 0;
+
+    WHEN("Loads from one instruction miss, and a wrong-path load misses")
+    {
+      for (uint64_t block : {0xdeadbe40, 0xdeadbe80}) {
+        champsim::channel::request_type load;
+        load.address = champsim::address{block + 8};
+        load.v_address = champsim::address{block + 8};
+        load.ip = champsim::address{0x401000};
+        load.type = access_type::LOAD;
+        load.cpu = 0;
+        upper_queues.add_rq(load);
+      }
+
+      champsim::channel::request_type wrong_path_load;
+      wrong_path_load.address = champsim::address{0xcafe0000};
+      wrong_path_load.v_address = champsim::address{0xcafe0000};
+      wrong_path_load.ip = champsim::address{0x402000};
+      wrong_path_load.type = access_type::LOAD;
+      wrong_path_load.wrong_path = true;
+      wrong_path_load.cpu = 0;
+      upper_queues.add_rq(wrong_path_load);
+
+      for (int i = 0; i < 20; ++i) {
+        uut._operate();
+      }
+
+      THEN("The instruction is the only miss hotspot")
+      {
+        auto top = uut.sim_stats.miss_ip_hotspots.top();
+        REQUIRE(std::size(top) == 1);
+        CHECK(top.at(0).key == std::pair{uint32_t{0}, uint64_t{0x401000}});
+        CHECK(top.at(0).count == 2);
+      }
+
+      THEN("Each block is a miss hotspot")
+      {
+        auto top = uut.sim_stats.miss_block_hotspots.top();
+        REQUIRE(std::size(top) == 2);
+        CHECK(top.at(0).count == 1);
+        CHECK(top.at(1).count == 1);
+      }
+    }
+
+    WHEN("A load misses on a block that is being prefetched")
+    {
+      uut.prefetch_line(champsim::address{0xdeadbe40}, true, 0);
+      for (int i = 0; i < 5; ++i) {
+        uut._operate();
+      }
+
+      champsim::channel::request_type load;
+      load.address = champsim::address{0xdeadbe48};
+      load.v_address = champsim::address{0xdeadbe48};
+      load.ip = champsim::address{0x401000};
+      load.type = access_type::LOAD;
+      load.cpu = 0;
+      upper_queues.add_rq(load);
+
+      for (int i = 0; i < 10; ++i) {
+        uut._operate();
+      }
+
+      THEN("The block is a late prefetch hotspot")
+      {
+        auto top = uut.sim_stats.late_prefetch_hotspots.top();
+        REQUIRE(std::size(top) == 1);
+        CHECK(top.at(0).key == std::pair{uint32_t{0}, uint64_t{0xdeadbe40}});
+        CHECK(top.at(0).count == 1);
+      }
+    }
+  }
+}
@@ -0,0 +1,108 @@
+#include <catch.hpp>
+
+#include "../../../replacement/clip/clip.h"
+#include "cache.h"
+#include "channel.h"
+#include "defaults.hpp"
+
+namespace
+{
+void fill(clip& uut, std::vector<champsim::cache_block>& set, long way, bool is_instruction)
+{
+  set.at(static_cast<std::size_t>(way)).is_instruction = is_instruction;
+  uut.replacement_cache_fill(0, 0, way, champsim::address{}, champsim::address{}, champsim::address{}, access_type::LOAD, is_instruction);
+}
+
+long victim(clip& uut, const std::vector<champsim::cache_block>& set)
+{
+  return uut.find_victim(0, 0, 0, std::data(set), champsim::address{}, champsim::address{}, access_type::LOAD);
+}
+} // namespace
+
+TEST_CASE("CLIP evicts data lines before instruction lines")
+{
+  clip uut{nullptr, 1, 4};
+  std::vector<champsim::cache_block> set(4);
+
+  fill(uut, set, 0, true);
+  fill(uut, set, 1, true);
+  fill(uut, set, 2, false);
+  fill(uut, set, 3, false);
+
+  // A stream of data lines cycles through the data ways only
+  for (int i = 0; i < 8; ++i) {
+    auto way = victim(uut, set);
+    REQUIRE((way == 2 || way == 3));
+    fill(uut, set, way, false);
+  }
+
+  REQUIRE(uut.stats.code_evictions == 0);
+  REQUIRE(uut.stats.data_evictions == 8);
+}
+
+TEST_CASE("CLIP evicts instruction lines when a set holds only instructions")
+{
+  clip uut{nullptr, 1, 4};
+  std::vector<champsim::cache_block> set(4);
+
+  for (long way = 0; way < 4; ++way) {
+    fill(uut, set, way, true);
+  }
+  uut.update_replacement_state(0, 0, 1, champsim::address{}, champsim::address{}, champsim::address{}, access_type::LOAD, true, true);
+
+  auto way = victim(uut, set);
+  REQUIRE(way == 0);
+  REQUIRE(uut.stats.code_evictions == 1);
+}
+
+SCENARIO("A cache knows which of its accesses fetch instructions")
+{
+  GIVEN("A second-level cache with an instruction access in flight")
+  {
+    champsim::channel upper_queues{};
+    champsim::channel lower_queues{};
+    CACHE uut{champsim::cache_builder{champsim::defaults::default_l2c}.name("445-uut").upper_levels({&upper_queues}).lower_level(&lower_queues)};
+    uut.initialize();
+    uut.warmup = false;
+    uut.begin_phase();
+
+    champsim::channel::request_type fetch;
+    fetch.address = champsim::address{0xdeadbe40};
+    fetch.v_address = champsim::address{0xdeadbe40};
+    fetch.cpu = 0;
+    fetch.type = access_type::IFETCH;
+    fetch.is_instruction = true;
+    upper_queues.add_rq(fetch);
+
+    for (int i = 0; i < 20; ++i) {
+      uut._operate();
+    }
+
+    THEN("The miss is forwarded as an instruction access")
+    {
+      REQUIRE(std::size(lower_queues.RQ) == 1);
+      REQUIRE(lower_queues.RQ.front().is_instruction);
+      REQUIRE(uut.sim_stats.misses.value_or(std::pair{access_type::IFETCH, 0u}, 0) == 1);
+    }
+
+    WHEN("The miss returns and the line is fetched again")
+    {
+      lower_queues.returned.emplace_back(lower_queues.RQ.front());
+      lower_queues.RQ.clear();
+      for (int i = 0; i < 20; ++i) {
+        uut._operate();
+      }
+
+      upper_queues.add_rq(fetch);
+      for (int i = 0; i < 20; ++i) {
+        uut._operate();
+      }
+
+      THEN("The second fetch is an instruction hit")
+      {
+        REQUIRE(uut.sim_stats.hits.value_or(std::pair{access_type::IFETCH, 0u}, 0) == 1);
+        REQUIRE(std::any_of(std::begin(uut.block), std::end(uut.block), [](const auto& blk) { return blk.valid && blk.is_instruction; }));
+      }
+    }
+  }
+}
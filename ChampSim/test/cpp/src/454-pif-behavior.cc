@@ -0,0 +1,158 @@
+#include <catch.hpp>
+
+#include "../../../prefetcher/pif/pif.h"
+#include "cache.h"
+#include "defaults.hpp"
+
+namespace
+{
+std::vector<champsim::block_number> queued_prefetches(const pif& uut)
+{
+  std::vector<champsim::block_number> retval;
+  for (const auto& pf : uut.prefetch_queue) {
+    retval.emplace_back(pf.addr);
+  }
+  return retval;
+}
+
+void retire_block(pif& uut, champsim::block_number block)
+{
+  // Several instructions in each block
+  for (champsim::address::difference_type offset : {0, 4, 8}) {
+    uut.prefetcher_retire(champsim::address{block} + offset);
+  }
+}
+} // namespace
+
+TEST_CASE("A PIF spatial region record covers the blocks around its trigger")
+{
+  const champsim::block_number trigger{0x400};
+  pif::region_record uut{trigger, {}};
+
+  CHECK(uut.set(trigger - 2));
+  CHECK(uut.set(trigger + 5));
+  CHECK_FALSE(uut.set(trigger - 3));
+  CHECK_FALSE(uut.set(trigger + 6));
+
+  CHECK(uut.contains(trigger));
+  CHECK(uut.contains(trigger - 2));
+  CHECK_FALSE(uut.contains(trigger + 1));
+  CHECK(uut.blocks() == std::vector<champsim::block_number>{trigger, trigger - 2, trigger + 5});
+}
+
+SCENARIO("The PIF prefetcher replays the retired instruction stream after a miss")
+{
+  GIVEN("A PIF prefetcher that has seen a sequence of regions retire")
+  {
+    champsim::channel lower_queues{};
+    CACHE cache{champsim::cache_builder{champsim::defaults::default_l1i}.name("454-l1i").lower_level(&lower_queues)};
+    pif uut{&cache};
+
+    const champsim::block_number a{0x400};
+    const champsim::block_number b{0x2000};
+    const champsim::block_number c{0x8000};
+    for (auto block : {a, a + 1, b, b + 1, c, champsim::block_number{0x10000}}) {
+      retire_block(uut, block);
+    }
+
+    THEN("One record is written for each region that was left")
+    {
+      REQUIRE(uut.stats.records_written == 3);
+    }
+
+    WHEN("The first region misses in the cache")
+    {
+      std::ignore = uut.prefetcher_cache_operate(champsim::address{a}, champsim::address{a}, false, false, access_type::LOAD, 0);
+
+      THEN("The blocks of the recorded stream are queued in order")
+      {
+        REQUIRE(uut.stats.streams_started == 1);
+        REQUIRE(queued_prefetches(uut) == std::vector<champsim::block_number>{a, a + 1, b, b + 1, c});
+      }
+
+      AND_WHEN("The prefetcher operates for a few cycles")
+      {
+        for (int i = 0; i < 4; ++i) {
+          uut.prefetcher_cycle_operate();
+        }
+
+        THEN("The queued prefetches are issued to the cache")
+        {
+          REQUIRE(std::empty(uut.prefetch_queue));
+          REQUIRE(uut.stats.prefetches_issued == 5);
+          REQUIRE(cache.sim_stats.pf_requested == 5);
+        }
+      }
+    }
+
+    WHEN("The first region hits in the cache")
+    {
+      std::ignore = uut.prefetcher_cache_operate(champsim::address{a}, champsim::address{a}, true, false, access_type::LOAD, 0);
+
+      THEN("No stream is started")
+      {
+        REQUIRE(uut.stats.streams_started == 0);
+        REQUIRE(std::empty(uut.prefetch_queue));
+      }
+    }
+
+    WHEN("A block that was never retired misses in the cache")
+    {
+      std::ignore = uut.prefetcher_cache_operate(champsim::address{0xdead000}, champsim::address{0xdead000}, false, false, access_type::LOAD, 0);
+
+      THEN("No stream is started")
+      {
+        REQUIRE(uut.stats.streams_started == 0);
+      }
+    }
+  }
+}
+
+SCENARIO("A PIF stream stays a fixed number of records ahead of fetch")
+{
+  GIVEN("A PIF prefetcher that has seen a long sequence of regions retire")
+  {
+    champsim::channel lower_queues{};
+    CACHE cache{champsim::cache_builder{champsim::defaults::default_l1i}.name("454-l1i").lower_level(&lower_queues)};
+    pif uut{&cache};
+
+    std::vector<champsim::block_number> regions;
+    for (uint64_t i = 0; i < 2 * pif::LOOKAHEAD + 2; ++i) {
+      regions.emplace_back(0x1000 + 0x100 * i);
+      retire_block(uut, regions.back());
+    }
+
+    WHEN("The first region misses and fetch then reaches the second")
+    {
+      std::ignore = uut.prefetcher_cache_operate(champsim::address{regions.at(0)}, champsim::address{}, false, false, access_type::LOAD, 0);
+      REQUIRE(std::size(uut.prefetch_queue) == pif::LOOKAHEAD + 1);
+
+      std::ignore = uut.prefetcher_cache_operate(champsim::address{regions.at(1)}, champsim::address{}, true, true, access_type::LOAD, 0);
+
+      THEN("One more record is prefetched")
+      {
+        REQUIRE(uut.stats.stream_advances == 1);
+        REQUIRE(std::size(uut.prefetch_queue) == pif::LOOKAHEAD + 2);
+        REQUIRE(champsim::block_number{uut.prefetch_queue.back().addr} == regions.at(pif::LOOKAHEAD + 1));
+      }
+    }
+  }
+}
+
+TEST_CASE("The PIF temporal compactor drops records that repeat a recent one")
+{
+  champsim::channel lower_queues{};
+  CACHE cache{champsim::cache_builder{champsim::defaults::default_l1i}.name("454-l1i").lower_level(&lower_queues)};
+  pif uut{&cache};
+
+  // A loop over two regions
+  const champsim::block_number a{0x400};
+  const champsim::block_number b{0x2000};
+  for (int i = 0; i < 10; ++i) {
+    retire_block(uut, a);
+    retire_block(uut, b);
+  }
+
+  REQUIRE(uut.stats.records_written == 2);
+  REQUIRE(uut.stats.records_compacted == 17);
+}
@@ -0,0 +1,130 @@
+#include <catch.hpp>
+
+#include "../../../prefetcher/entangling/entangling.h"
+#include "cache.h"
+#include "defaults.hpp"
+
+namespace
+{
+void access(entangling& uut, champsim::block_number block, bool hit)
+{
+  std::ignore = uut.prefetcher_cache_operate(champsim::address{block}, champsim::address{block}, hit, false, access_type::LOAD, 0);
+}
+
+void wait(entangling& uut, int cycles)
+{
+  for (int i = 0; i < cycles; ++i) {
+    uut.prefetcher_cycle_operate();
+  }
+}
+} // namespace
+
+TEST_CASE("The entangling prefetcher fits more destinations in an entry when they are close to the source")
+{
+  CHECK(entangling::delta_bits(0) == 1);
+  CHECK(entangling::delta_bits(1) == 2);
+  CHECK(entangling::delta_bits(-1) == 2);
+  CHECK(entangling::delta_bits(7) == 4);
+  CHECK(entangling::delta_bits(-8) == 5);
+
+  CHECK(entangling::capacity(4) == entangling::MAX_DESTINATIONS);
+  CHECK(entangling::capacity(16) == 3);
+  CHECK(entangling::capacity(40) == 1);
+}
+
+SCENARIO("The entangling prefetcher pairs a miss with the block accessed one miss latency before it")
+{
+  GIVEN("An entangling prefetcher that has timed a miss")
+  {
+    champsim::channel lower_queues{};
+    CACHE cache{champsim::cache_builder{champsim::defaults::default_l1i}.name("455-l1i").lower_level(&lower_queues)};
+    entangling uut{&cache};
+
+    const champsim::block_number source{0x400};
+    const champsim::block_number between{0x800};
+    const champsim::block_number destination{0x1000};
+
+    access(uut, source, true);
+    wait(uut, 10);
+    access(uut, between, true);
+    wait(uut, 10);
+    access(uut, destination, false);
+    wait(uut, 15);
+    std::ignore = uut.prefetcher_cache_fill(champsim::address{destination}, 0, 0, false, champsim::address{}, 0);
+
+    THEN("The miss is entangled with the access that preceded it by its latency")
+    {
+      REQUIRE(uut.stats.entangled == 1);
+      auto entry = uut.table.check_hit({source, {}});
+      REQUIRE(entry.has_value());
+      REQUIRE(std::size(entry->destinations) == 1);
+      REQUIRE(entry->destinations.front().delta == champsim::offset(source, destination));
+      REQUIRE_FALSE(uut.table.check_hit({between, {}}).has_value());
+    }
+
+    WHEN("The source is accessed again")
+    {
+      access(uut, source, true);
+
+      THEN("The destination is prefetched")
+      {
+        REQUIRE(uut.stats.prefetches_issued == 1);
+        REQUIRE(cache.sim_stats.pf_requested == 1);
+      }
+
+      AND_WHEN("The prefetched destination is used")
+      {
+        std::ignore = uut.prefetcher_cache_operate(champsim::address{destination}, champsim::address{destination}, true, true, access_type::LOAD, 0);
+
+        THEN("The prefetch is counted as useful")
+        {
+          REQUIRE(uut.stats.useful == 1);
+        }
+      }
+    }
+
+    WHEN("The destination is repeatedly evicted before it is used")
+    {
+      for (unsigned i = 0; i < entangling::MAX_CONFIDENCE; ++i) {
+        access(uut, source, true);
+        std::ignore = uut.prefetcher_cache_fill(champsim::address{0x2000'0000}, 0, 0, true, champsim::address{destination}, 0);
+      }
+      auto issued = uut.stats.prefetches_issued;
+      access(uut, source, true);
+
+      THEN("The source no longer prefetches it")
+      {
+        REQUIRE(uut.stats.useless == entangling::MAX_CONFIDENCE);
+        REQUIRE(uut.stats.prefetches_issued == issued);
+      }
+    }
+  }
+}
+
+TEST_CASE("The entangling prefetcher drops the least confident destinations when a wide delta no longer fits")
+{
+  champsim::channel lower_queues{};
+  CACHE cache{champsim::cache_builder{champsim::defaults::default_l1i}.name("455-l1i").lower_level(&lower_queues)};
+  entangling uut{&cache};
+
+  const champsim::block_number source{0x400};
+  for (uint64_t i = 1; i <= 4; ++i) {
+    access(uut, source, true);
+    wait(uut, 10);
+    access(uut, source + static_cast<long>(i), false);
+    wait(uut, 10);
+    std::ignore = uut.prefetcher_cache_fill(champsim::address{source + static_cast<long>(i)}, 0, 0, false, champsim::address{}, 0);
+  }
+  REQUIRE(std::size(uut.table.check_hit({source, {}})->destinations) == 4);
+
+  // A far destination needs enough bits that only one fits
+  const champsim::block_number far{source + (1L << 40)};
+  access(uut, source, true);
+  wait(uut, 10);
+  access(uut, far, false);
+  wait(uut, 10);
+  std::ignore = uut.prefetcher_cache_fill(champsim::address{far}, 0, 0, false, champsim::address{}, 0);
+
+  REQUIRE(std::size(uut.table.check_hit({source, {}})->destinations) == 1);
+  REQUIRE(uut.stats.destinations_dropped == 4);
+}
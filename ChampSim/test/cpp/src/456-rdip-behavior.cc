@@ -0,0 +1,179 @@
+#include <catch.hpp>
+
+#include "../../../prefetcher/rdip/rdip.h"
+#include "cache.h"
+#include "defaults.hpp"
+#include "instruction.h"
+
+namespace
+{
+void predict(rdip& uut, champsim::block_number block) { uut.prefetcher_ftq_enqueue(champsim::address{block}, false); }
+
+void fetch(rdip& uut, champsim::block_number block, bool hit)
+{
+  std::ignore = uut.prefetcher_cache_operate(champsim::address{block}, champsim::address{block}, hit, false, access_type::IFETCH, 0);
+}
+
+// A block that is predicted and then fetched at once
+void miss(rdip& uut, champsim::block_number block)
+{
+  predict(uut, block);
+  fetch(uut, block, false);
+}
+void hit(rdip& uut, champsim::block_number block)
+{
+  predict(uut, block);
+  fetch(uut, block, true);
+}
+
+void call(rdip& uut, uint64_t ip, uint64_t target) { uut.prefetcher_branch_operate(champsim::address{ip}, BRANCH_DIRECT_CALL, champsim::address{target}); }
+void call(rdip& uut, uint64_t ip) { call(uut, ip, ip + 0x1000); }
+void ret(rdip& uut, uint64_t ip) { uut.prefetcher_branch_operate(champsim::address{ip}, BRANCH_RETURN, champsim::address{}); }
+} // namespace
+
+TEST_CASE("RDIP signatures follow the call stack")
+{
+  champsim::channel lower_queues{};
+  CACHE cache{champsim::cache_builder{champsim::defaults::default_l1i}.name("456-l1i").lower_level(&lower_queues)};
+  rdip uut{&cache};
+
+  auto empty_stack = uut.current_signature(false);
+  call(uut, 0x4000);
+  auto in_first_call = uut.signature;
+  CHECK(in_first_call != empty_stack);
+
+  call(uut, 0x5000);
+  CHECK(uut.signature != in_first_call);
+
+  ret(uut, 0x6000);
+  CHECK(uut.signature == uut.current_signature(true));
+  CHECK(uut.signature != in_first_call); // returning into a context is distinct from calling into it
+
+  // Other branches do not change the context
+  auto before = uut.signature;
+  uut.prefetcher_branch_operate(champsim::address{0x6004}, BRANCH_CONDITIONAL, champsim::address{0x7000});
+  CHECK(uut.signature == before);
+  CHECK(uut.stats.context_switches == 3);
+}
+
+SCENARIO("RDIP prefetches the misses of a context when the program enters it again")
+{
+  GIVEN("An RDIP prefetcher that has seen misses after a call")
+  {
+    champsim::channel lower_queues{};
+    CACHE cache{champsim::cache_builder{champsim::defaults::default_l1i}.name("456-l1i").lower_level(&lower_queues)};
+    rdip uut{&cache};
+
+    const champsim::block_number callee{0x800};
+    const champsim::block_number far{0x4000};
+    call(uut, 0x4000);
+    miss(uut, callee);
+    miss(uut, callee + 2);
+    miss(uut, far);
+    ret(uut, 0x20000);
+    hit(uut, champsim::block_number{0x20});
+
+    THEN("The misses are compressed into records under the signature of the call")
+    {
+      call(uut, 0x4000);
+      REQUIRE(uut.stats.signature_hits == 1);
+      REQUIRE(uut.stats.prefetches_issued == 3);
+      REQUIRE(cache.sim_stats.pf_requested == 3);
+    }
+
+    WHEN("A different function is called from the same place")
+    {
+      call(uut, 0x4000, 0x9000);
+
+      THEN("The misses of the call site are prefetched, since the signature hashes only the return addresses")
+      {
+        REQUIRE(uut.stats.signature_hits == 1);
+        REQUIRE(uut.stats.prefetches_issued == 3);
+      }
+    }
+
+    WHEN("The same function is called from a different place")
+    {
+      call(uut, 0x9000, 0x5000);
+
+      THEN("Nothing is prefetched")
+      {
+        REQUIRE(uut.stats.signature_hits == 0);
+        REQUIRE(uut.stats.prefetches_issued == 0);
+      }
+    }
+
+    WHEN("The same context misses on other blocks later")
+    {
+      call(uut, 0x4000);
+      miss(uut, champsim::block_number{0x10000});
+      ret(uut, 0x20000);
+      hit(uut, champsim::block_number{0x20});
+      call(uut, 0x4000);
+
+      THEN("The earlier misses are kept")
+      {
+        auto entry = uut.table.check_hit({uut.signature, {}});
+        REQUIRE(entry.has_value());
+        REQUIRE(std::size(entry->records) == 3);
+        REQUIRE(entry->records.front().blocks() == std::vector<champsim::block_number>{callee, callee + 2});
+      }
+    }
+  }
+}
+
+SCENARIO("RDIP attributes a miss to the context its block was predicted in")
+{
+  GIVEN("An RDIP prefetcher whose branch prediction has run ahead of fetch, through a call and its return")
+  {
+    champsim::channel lower_queues{};
+    CACHE cache{champsim::cache_builder{champsim::defaults::default_l1i}.name("456-l1i").lower_level(&lower_queues)};
+    rdip uut{&cache};
+
+    const champsim::block_number callee{0x800};
+    const champsim::block_number after_return{0x20};
+    call(uut, 0x4000);
+    auto in_call = uut.signature;
+    predict(uut, callee);
+    ret(uut, 0x20000);
+    auto after_call = uut.signature;
+    predict(uut, after_return);
+
+    WHEN("Fetch misses on the block in the callee, and then reaches the block after the return")
+    {
+      fetch(uut, callee, false);
+      fetch(uut, after_return, true);
+
+      THEN("The miss is recorded under the signature of the call")
+      {
+        auto entry = uut.table.check_hit({in_call, {}});
+        REQUIRE(entry.has_value());
+        REQUIRE(entry->records.front().trigger == callee);
+        REQUIRE_FALSE(uut.table.check_hit({after_call, {}}).has_value());
+        REQUIRE(uut.fetched.signature == after_call);
+      }
+    }
+  }
+}
+
+TEST_CASE("RDIP records the misses of a context when fetch enters the same signature again")
+{
+  champsim::channel lower_queues{};
+  CACHE cache{champsim::cache_builder{champsim::defaults::default_l1i}.name("456-l1i").lower_level(&lower_queues)};
+  rdip uut{&cache};
+
+  const champsim::block_number after_return{0x20};
+  call(uut, 0x4000);
+  ret(uut, 0x20000);
+  auto returned = uut.signature;
+  miss(uut, champsim::block_number{0x800});
+
+  call(uut, 0x4000);
+  ret(uut, 0x20000);
+  REQUIRE(uut.signature == returned);
+  hit(uut, after_return);
+
+  auto entry = uut.table.check_hit({returned, {}});
+  REQUIRE(entry.has_value());
+  REQUIRE(entry->records.front().trigger == champsim::block_number{0x800});
+}
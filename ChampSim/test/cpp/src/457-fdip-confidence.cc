@@ -0,0 +1,74 @@
+#include <catch.hpp>
+
+#include "../../../prefetcher/fdip/fdip.h"
+#include "cache.h"
+#include "defaults.hpp"
+#include "instruction.h"
+
+namespace
+{
+constexpr uint64_t first_block = 0x10000;
+constexpr std::size_t num_blocks = 12;
+
+champsim::address block_addr(std::size_t i) { return champsim::address{first_block + i * BLOCK_SIZE}; }
+
+std::size_t count_enqueued(const fdip& uut)
+{
+  return static_cast<std::size_t>(std::count_if(std::begin(uut.ftq), std::end(uut.ftq), [](const auto& entry) { return entry.enqueued; }));
+}
+} // namespace
+
+SCENARIO("FDIP stops looking ahead past low-confidence branches")
+{
+  GIVEN("An FDIP prefetcher with a full FTQ")
+  {
+    champsim::channel lower_queues{};
+    CACHE cache{champsim::cache_builder{champsim::defaults::default_l1i}.name("457-l1i").lower_level(&lower_queues)};
+    fdip uut{&cache};
+    uut.prefetcher_initialize();
+
+    for (std::size_t i = 0; i < num_blocks; ++i) {
+      uut.prefetcher_ftq_enqueue(block_addr(i), false);
+    }
+
+    WHEN("Every branch is predicted with high confidence")
+    {
+      for (std::size_t i = 0; i < num_blocks; ++i) {
+        uut.prefetcher_branch_operate(block_addr(i) + 4, BRANCH_CONDITIONAL, block_addr(i + 1), champsim::branch_confidence::high);
+      }
+      uut.prefetcher_cycle_operate();
+
+      THEN("The whole static lookahead window is prefetched")
+      {
+        REQUIRE(count_enqueued(uut) == fdip::FTQ_LOOKAHEAD_END - fdip::FTQ_LOOKAHEAD_START);
+        REQUIRE(uut.lookahead_caps == 0);
+      }
+    }
+
+    WHEN("Two branches early in the FTQ are predicted with low confidence")
+    {
+      uut.prefetcher_branch_operate(block_addr(3) + 4, BRANCH_CONDITIONAL, block_addr(4), champsim::branch_confidence::low);
+      uut.prefetcher_branch_operate(block_addr(5) + 4, BRANCH_CONDITIONAL, block_addr(6), champsim::branch_confidence::low);
+      uut.prefetcher_cycle_operate();
+
+      THEN("The lookahead ends at the block of the second")
+      {
+        REQUIRE(count_enqueued(uut) == 4);
+        REQUIRE_FALSE(uut.ftq.at(6).enqueued);
+        REQUIRE(uut.lookahead_caps == 1);
+      }
+    }
+
+    WHEN("One branch is predicted with low confidence and one with medium confidence")
+    {
+      uut.prefetcher_branch_operate(block_addr(3) + 4, BRANCH_CONDITIONAL, block_addr(4), champsim::branch_confidence::low);
+      uut.prefetcher_branch_operate(block_addr(5) + 4, BRANCH_CONDITIONAL, block_addr(6), champsim::branch_confidence::medium);
+      uut.prefetcher_cycle_operate();
+
+      THEN("The lookahead is not shortened")
+      {
+        REQUIRE(count_enqueued(uut) == fdip::FTQ_LOOKAHEAD_END - fdip::FTQ_LOOKAHEAD_START);
+      }
+    }
+  }
+}
@@ -0,0 +1,63 @@
+#include <catch.hpp>
+
+#include "channel.h"
+#include "dram_controller.h"
+
+SCENARIO("The memory controller counts its reads by access type")
+{
+  GIVEN("A memory controller with one upper level")
+  {
+    const auto clock_period = champsim::chrono::picoseconds{3200};
+    champsim::channel upper_queues{};
+    MEMORY_CONTROLLER uut{clock_period,
+                          clock_period * 2,
+                          2,
+                          2,
+                          38,
+                          4,
+                          champsim::chrono::microseconds{64000},
+                          {&upper_queues},
+                          64,
+                          64,
+                          1,
+                          champsim::data::bytes{8},
+                          65536,
+                          128,
+                          8,
+                          2,
+                          8,
+                          8192};
+    uut.warmup = false;
+    uut.channels[0].warmup = false;
+    uut.begin_phase();
+
+    WHEN("An instruction fetch and a load are read")
+    {
+      champsim::channel::request_type fetch;
+      fetch.address = champsim::address{0xdeadbe40};
+      fetch.v_address = fetch.address;
+      fetch.type = access_type::IFETCH;
+      fetch.is_instruction = true;
+      upper_queues.add_rq(fetch);
+
+      champsim::channel::request_type load;
+      load.address = champsim::address{0xbeef0000};
+      load.v_address = load.address;
+      load.type = access_type::LOAD;
+      upper_queues.add_rq(load);
+
+      for (int i = 0; i < 500 && std::size(upper_queues.returned) < 2; ++i) {
+        uut._operate();
+      }
+
+      THEN("Each read is counted under its own type")
+      {
+        REQUIRE(std::size(upper_queues.returned) == 2);
+        const auto& stats = uut.channels[0].sim_stats;
+        REQUIRE(stats.RQ_ROW_BUFFER_HIT_BY_TYPE.value_or(access_type::IFETCH, 0) + stats.RQ_ROW_BUFFER_MISS_BY_TYPE.value_or(access_type::IFETCH, 0) == 1);
+        REQUIRE(stats.RQ_ROW_BUFFER_HIT_BY_TYPE.value_or(access_type::LOAD, 0) + stats.RQ_ROW_BUFFER_MISS_BY_TYPE.value_or(access_type::LOAD, 0) == 1);
+        REQUIRE(stats.RQ_ROW_BUFFER_HIT_BY_TYPE.total() + stats.RQ_ROW_BUFFER_MISS_BY_TYPE.total() == stats.RQ_ROW_BUFFER_HIT + stats.RQ_ROW_BUFFER_MISS);
+      }
+    }
+  }
+}
@@ -53,6 +53,28 @@ TEST_CASE("The DRAM RQ row buffer miss counter increments the printed stats")
   REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
 }
 
+TEST_CASE("The DRAM RQ row buffer counters by type print for the types that were read")
+{
+  dram_stats given{};
+  given.name = "test_channel";
+  given.RQ_ROW_BUFFER_HIT = 255;
+  given.RQ_ROW_BUFFER_MISS = 255;
+  given.RQ_ROW_BUFFER_HIT_BY_TYPE.set(access_type::IFETCH, 255);
+  given.RQ_ROW_BUFFER_MISS_BY_TYPE.set(access_type::LOAD, 255);
+
+  std::vector<std::string> expected{"test_channel RQ ROW_BUFFER_HIT:        255",
+                                    "  ROW_BUFFER_MISS:        255",
+                                    "  LOAD         ROW_BUFFER_HIT:          0 ROW_BUFFER_MISS:        255",
+                                    "  IFETCH       ROW_BUFFER_HIT:        255 ROW_BUFFER_MISS:          0",
+                                    "  AVG DBUS CONGESTED CYCLE: -",
+                                    "test_channel WQ ROW_BUFFER_HIT:          0",
+                                    "  ROW_BUFFER_MISS:          0",
+                                    "  FULL:          0",
+                                    "test_channel REFRESHES ISSUED: -"};
+
+  REQUIRE_THAT(champsim::plain_printer::format(given), Catch::Matchers::RangeEquals(expected));
+}
+
 TEST_CASE("The DRAM WQ row buffer hit counter increments the printed stats")
 {
   dram_stats given{};
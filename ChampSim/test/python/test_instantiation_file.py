@@ -29,6 +29,16 @@ class CpuBuilderTest(unittest.TestCase):
     def test_ifetch_buffer_size(self):
         self.get_element_diff(['.ifetch_buffer_size(1)'], ifetch_buffer_size=1)
 
+    def test_ftq_size(self):
+        self.get_element_diff(['.ftq_size(1)'], ftq_size=1)
+
+    def test_wrong_path_fetch(self):
+        self.get_element_diff(['.wrong_path_fetch(1)'], wrong_path_fetch=True)
+        self.get_element_diff(['.wrong_path_fetch(0)'], wrong_path_fetch=False)
+
+    def test_lsd_size(self):
+        self.get_element_diff(['.lsd_size(1)'], lsd_size=1)
+
     def test_decode_buffer_size(self):
         self.get_element_diff(['.decode_buffer_size(1)'], decode_buffer_size=1)
 
@@ -50,6 +60,12 @@ class CpuBuilderTest(unittest.TestCase):
     def test_fetch_width(self):
         self.get_element_diff(['.fetch_width(champsim::bandwidth::maximum_type{1})'], fetch_width=1)
 
+    def test_taken_branches_per_cycle(self):
+        self.get_element_diff(['.taken_branches_per_cycle(champsim::bandwidth::maximum_type{2})'], taken_branches_per_cycle=2)
+
+    def test_fetch_blocks_per_cycle(self):
+        self.get_element_diff(['.fetch_blocks_per_cycle(champsim::bandwidth::maximum_type{2})'], fetch_blocks_per_cycle=2)
+
     def test_decode_width(self):
         self.get_element_diff(['.decode_width(champsim::bandwidth::maximum_type{1})'], decode_width=1)
 
@@ -74,6 +90,12 @@ class CpuBuilderTest(unittest.TestCase):
     def test_mispredict_penalty(self):
         self.get_element_diff(['.mispredict_penalty(1)'], mispredict_penalty=1)
 
+    def test_branch_predictor_budget(self):
+        self.get_element_diff(['.branch_predictor_budget(1024)'], branch_predictor_budget=1024)
+
+    def test_slow_predictor_latency(self):
+        self.get_element_diff(['.slow_predictor_latency(3)'], slow_predictor_latency=3)
+
     def test_decode_latency(self):
         self.get_element_diff(['.decode_latency(1)'], decode_latency=1)
 
@@ -104,6 +126,15 @@ class CpuBuilderTest(unittest.TestCase):
     def test_dib_window_dict(self):
         self.get_element_diff(['.dib_window(1)'], DIB={ 'window_size': 1 })
 
+    def test_uop_cache_dict(self):
+        self.get_element_diff(['.uop_cache_set(1)'], uop_cache={ 'sets': 1 })
+        self.get_element_diff(['.uop_cache_way(1)'], uop_cache={ 'ways': 1 })
+        self.get_element_diff(['.uop_cache_window(1)'], uop_cache={ 'window_size': 1 })
+        self.get_element_diff(['.uop_cache_uops_per_line(1)'], uop_cache={ 'uops_per_line': 1 })
+        self.get_element_diff(['.uop_cache_lines_per_window(1)'], uop_cache={ 'lines_per_window': 1 })
+        self.get_element_diff(['.uop_cache_partial_windows(1)'], uop_cache={ 'partial_windows': True })
+        self.get_element_diff(['.uop_cache_switch_penalty(1)'], uop_cache={ 'switch_penalty': 1 })
+
     def test_branch_predictor(self):
         self.get_element_diff(['.branch_predictor<class a_class>()'], _branch_predictor_data=[{ 'name': 'a', 'class': 'a_class' }])
         self.get_element_diff(['.branch_predictor<class a_class, class b_class>()'], _branch_predictor_data=[{ 'name': 'a', 'class': 'a_class' }, { 'name': 'b', 'class': 'b_class' }])
@@ -172,6 +203,14 @@ class CacheBuilderTests(unittest.TestCase):
         self.get_element_diff(['.set_virtual_prefetch()'], virtual_prefetch=True)
         self.get_element_diff(['.reset_virtual_prefetch()'], virtual_prefetch=False)
 
+    def test_translation_prefetch(self):
+        self.get_element_diff(['.set_translation_prefetch()'], translation_prefetch=True)
+        self.get_element_diff(['.reset_translation_prefetch()'], translation_prefetch=False)
+
+    def test_instruction_prefetch(self):
+        self.get_element_diff(['.set_instruction_prefetch()'], instruction_prefetch=True)
+        self.get_element_diff(['.reset_instruction_prefetch()'], instruction_prefetch=False)
+
     def test_prefetch_activate(self):
         self.get_element_diff(['.prefetch_activate(access_type::LOAD)'], prefetch_activate=['LOAD'])
         self.get_element_diff(['.prefetch_activate(access_type::LOAD, access_type::WRITE)'], prefetch_activate=['LOAD', 'WRITE'])
@@ -198,6 +198,12 @@ class ParseNormalizedTests(unittest.TestCase):
 
                 self.assertIn(cache_name, [c['name'] for c in caches])
 
+    def test_branch_predictor_budget_accepts_prefixed_sizes(self):
+        test_config = config.parse.NormalizedConfiguration({ 'ooo_cpu': [{ 'name': 'test_cpu', 'branch_predictor_budget': '64kB' }] })
+
+        result = test_config.apply_defaults_in(PassthroughContext(), PassthroughContext(), PassthroughContext(), PassthroughContext())
+        self.assertEqual(result[0]['cores'][0]['branch_predictor_budget'], 64*1024)
+
     def test_generates_default_ptws(self):
         test_config = config.parse.NormalizedConfiguration({ 'ooo_cpu': [{ 'name': 'test_cpu' }] })
 
@@ -417,7 +423,7 @@ class NormalizeConfigTest(unittest.TestCase):
         self.assertEqual(result.vmem.get('__test__'), True)
 
     def test_core_params_are_moved_to_core_array(self):
-        core_keys_to_copy = ('frequency', 'ifetch_buffer_size', 'decode_buffer_size', 'dispatch_buffer_size', 'register_file_size', 'rob_size', 'lq_size', 'sq_size', 'fetch_width', 'decode_width', 'dispatch_width', 'execute_width', 'lq_width', 'sq_width', 'retire_width', 'mispredict_penalty', 'scheduler_size', 'decode_latency', 'dispatch_latency', 'schedule_latency', 'execute_latency', 'branch_predictor', 'btb', 'DIB')
+        core_keys_to_copy = ('frequency', 'ifetch_buffer_size', 'ftq_size', 'wrong_path_fetch', 'lsd_size', 'decode_buffer_size', 'dispatch_buffer_size', 'register_file_size', 'rob_size', 'lq_size', 'sq_size', 'fetch_width', 'taken_branches_per_cycle', 'fetch_blocks_per_cycle', 'decode_width', 'dispatch_width', 'execute_width', 'lq_width', 'sq_width', 'retire_width', 'mispredict_penalty', 'branch_predictor_budget', 'slow_predictor_latency', 'scheduler_size', 'decode_latency', 'dispatch_latency', 'schedule_latency', 'execute_latency', 'branch_predictor', 'btb', 'DIB', 'uop_cache')
         for k in core_keys_to_copy:
             with self.subTest(key=k):
                 result = config.parse.NormalizedConfiguration({ k: '__test__' })
@@ -666,9 +672,10 @@ class CoreDefaultNamesTests(unittest.TestCase):
         self.assertIn('PTW', result)
         self.assertIn('frequency', result)
         self.assertIn('DIB', result)
+        self.assertIn('uop_cache', result)
 
     def test_given_names_are_not_overwritten(self):
-        for name in ('L1I', 'L1D', 'ITLB', 'DTLB', 'PTW', 'branch_predictor', 'btb', 'frequency', 'DIB'):
+        for name in ('L1I', 'L1D', 'ITLB', 'DTLB', 'PTW', 'branch_predictor', 'btb', 'frequency', 'DIB', 'uop_cache'):
             with self.subTest(name=name):
                 testval = {'name': 'testcpu', name: 'testname'}
                 result = config.parse.core_default_names(testval)
@@ -0,0 +1,67 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include "../../inc/code_layout.h"
+
+namespace
+{
+void profile(std::istream& in, champsim::code_layout_profiler& profiler)
+{
+  input_instr instr;
+  while (in.read(reinterpret_cast<char*>(&instr), sizeof(instr))) { // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    profiler(ooo_model_instr{0, instr});
+  }
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+  if (argc < 2 || argc > 3 || std::strcmp(argv[1], "-h") == 0 || std::strcmp(argv[1], "--help") == 0) {
+    std::cerr << "Usage: " << argv[0] << " <parameters> [trace file]\n"
+              << "  The parameters are comma-separated key=value pairs, and may be empty.\n"
+              << "  The uncompressed trace is read from standard input if no file is given, and the layout is written to standard output.\n"
+              << "  Example: xz -dc trace.champsimtrace.xz | " << argv[0] << " max_cluster_size=4096 > trace.layout\n";
+    return 1;
+  }
+
+  try {
+    champsim::code_layout_profiler profiler{champsim::parse_code_layout_parameters(argv[1])};
+    if (argc == 3) {
+      std::ifstream trace{argv[2], std::ios::binary};
+      if (!trace) {
+        std::cerr << "Could not open " << argv[2] << '\n';
+        return 1;
+      }
+      profile(trace, profiler);
+    } else {
+      profile(std::cin, profiler);
+    }
+
+    auto layout = profiler.layout();
+    champsim::write_code_layout(std::cout, layout);
+    std::cerr << "Moved " << std::size(layout) << " chunks of code\n";
+  } catch (const std::invalid_argument& err) {
+    std::cerr << err.what() << '\n';
+    return 1;
+  }
+
+  return 0;
+}
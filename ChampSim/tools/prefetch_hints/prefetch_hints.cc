@@ -0,0 +1,70 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include "../../inc/code_prefetch_hints.h"
+
+namespace
+{
+void analyze(std::istream& in, champsim::code_prefetch_analyzer& analyzer)
+{
+  input_instr instr;
+  while (in.read(reinterpret_cast<char*>(&instr), sizeof(instr))) { // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    analyzer(instr);
+  }
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+  if (argc < 2 || argc > 3 || std::strcmp(argv[1], "-h") == 0 || std::strcmp(argv[1], "--help") == 0) {
+    std::cerr << "Usage: " << argv[0] << " <parameters> [trace file]\n"
+              << "  The parameters are comma-separated key=value pairs, and may be empty.\n"
+              << "  The uncompressed trace is read from standard input if no file is given, and the hints are written to standard output.\n"
+              << "  Example: xz -dc trace.champsimtrace.xz | " << argv[0] << " distance=64,min_accuracy=0.6 > trace.hints\n";
+    return 1;
+  }
+
+  try {
+    champsim::code_prefetch_analyzer analyzer{champsim::parse_code_prefetch_analysis_parameters(argv[1])};
+    if (argc == 3) {
+      std::ifstream trace{argv[2], std::ios::binary};
+      if (!trace) {
+        std::cerr << "Could not open " << argv[2] << '\n';
+        return 1;
+      }
+      analyze(trace, analyzer);
+    } else {
+      analyze(std::cin, analyzer);
+    }
+
+    auto hints = analyzer.hints();
+    champsim::write_code_prefetch_hints(std::cout, hints);
+
+    auto stats = analyzer.stats();
+    std::cerr << "Instructions: " << stats.instructions << " L1I misses: " << stats.misses << " covered by " << std::size(hints)
+              << " hints: " << stats.covered_misses << '\n';
+  } catch (const std::invalid_argument& err) {
+    std::cerr << err.what() << '\n';
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,48 @@
+/*
+ *    Copyright 2023 The ChampSim Contributors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+#include "../../inc/synthetic_trace.h"
+
+int main(int argc, char** argv)
+{
+  if (argc < 2 || argc > 3 || std::strcmp(argv[1], "-h") == 0 || std::strcmp(argv[1], "--help") == 0) {
+    std::cerr << "Usage: " << argv[0] << " <parameters> [output file]\n"
+              << "  The parameters are comma-separated key=value pairs, and must include a length.\n"
+              << "  The trace is written to standard output if no file is given.\n"
+              << "  Example: " << argv[0] << " length=10M,code_footprint=2M,branch_bias=0.95 | xz > synthetic.champsimtrace.xz\n";
+    return 1;
+  }
+
+  try {
+    auto params = champsim::parse_synthetic_trace_parameters(argv[1]);
+    if (argc == 3) {
+      std::ofstream out{argv[2], std::ios::binary};
+      champsim::write_synthetic_trace(out, params);
+    } else {
+      champsim::write_synthetic_trace(std::cout, params);
+    }
+  } catch (const std::invalid_argument& err) {
+    std::cerr << err.what() << '\n';
+    return 1;
+  }
+
+  return 0;
+}